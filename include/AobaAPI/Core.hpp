@@ -3,5 +3,6 @@
 
 #include "Core/EulerOps.hpp"
 #include "Core/Mesh.hpp"
+#include "Core/Parallel.hpp"
 
 #endif 
\ No newline at end of file
@@ -113,7 +113,8 @@ void KillEdge(Edge* e);
 void KillFace(Face* f);
 
 /// <summary>
-/// Deletes all elements present in its mesh, returning it to an empty state.
+/// Deletes all elements present in its mesh, and then the mesh itself.
+/// Elements are released in linear time without unlinking them, see <see cref="Mesh::Clear"/>.
 /// This is NOT equivalent to calling ~Mesh()!
 /// </summary>
 /// <param name="m">Mesh to be killed</param>
@@ -202,6 +203,7 @@ void ManifoldMakeEdge(Vert* v1, Vert* v2, Face* f, Edge* newe, Face* newf);
 
 /// <summary>
 /// Joins the mesh m2 into the mesh m1, deleting the mesh m2. Referecens to all elements of mesh 2 remain valid. 
+/// Handles of elements of mesh 2 resolve inside mesh 1 afterwards.
 /// </summary>
 /// <param name="m1">The surviving mesh</param>
 /// <param name="m2">The other mesh</param>
@@ -1,10 +1,15 @@
 #ifndef AOBA_CORE_MESH_HPP
 #define AOBA_CORE_MESH_HPP
 
+#include "Mesh/Changes.hpp"
+#include "Mesh/CompactMesh.hpp"
 #include "Mesh/Edge.hpp"
 #include "Mesh/Face.hpp"
+#include "Mesh/Journal.hpp"
 #include "Mesh/Loop.hpp"
 #include "Mesh/Mesh.hpp"
+#include "Mesh/MeshArrays.hpp"
 #include "Mesh/Vert.hpp"
+#include "Mesh/Visit.hpp"
 
 #endif
\ No newline at end of file
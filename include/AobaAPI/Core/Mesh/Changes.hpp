@@ -0,0 +1,95 @@
+#ifndef AOBA_CORE_MESH_CHANGES_HPP
+#define AOBA_CORE_MESH_CHANGES_HPP
+
+#include "Edge.hpp"
+#include "Face.hpp"
+#include "Vert.hpp"
+
+#include <cstddef>
+#include <unordered_set>
+
+namespace Aoba {
+namespace Core {
+
+class Mesh;
+
+/// <summary>
+/// Elements created, killed and modified since change tracking was last reset, see
+/// <see cref="Mesh::EnableChangeTracking"/>. Consumers which mirror the mesh, like GPU buffers or normals, only need
+/// to drop the killed elements, add the created ones and update the modified ones.
+/// The sets of each element type are disjoint. Elements created and killed between two resets are not reported, an
+/// element which is killed and created again at the same address is reported as modified.
+/// Modified elements are a superset of the changed elements, they may include neighbours whose list links were
+/// updated by an EulerOp.
+/// </summary>
+class MeshChanges {
+    friend class Mesh;
+    friend void JoinMesh(Mesh*, Mesh*);
+
+  public:
+    std::unordered_set<Vert*> createdVerts;      // verts created since the last reset
+    std::unordered_set<Vert*> modifiedVerts;     // verts which existed at the last reset and were changed
+    std::unordered_set<const Vert*> killedVerts; // verts which existed at the last reset, must not be dereferenced
+    std::unordered_set<Edge*> createdEdges;      // edges created since the last reset
+    std::unordered_set<Edge*> modifiedEdges;     // edges which existed at the last reset and were changed
+    std::unordered_set<const Edge*> killedEdges; // edges which existed at the last reset, must not be dereferenced
+    std::unordered_set<Face*> createdFaces;      // faces created since the last reset
+    std::unordered_set<Face*> modifiedFaces;     // faces which existed at the last reset and were changed
+    std::unordered_set<const Face*> killedFaces; // faces which existed at the last reset, must not be dereferenced
+
+    // wether all elements were replaced by Clear, Compact or Reorder. Consumers must rebuild their copies from the
+    // mesh, the sets stay empty until the next reset
+    bool rebuilt;
+
+    MeshChanges();
+
+    /// <summary>
+    /// Checks wether nothing changed since the last reset.
+    /// </summary>
+    /// <returns>True if no element was created, killed or modified and the mesh was not rebuilt, otherwise False.
+    /// </returns>
+    bool IsEmpty() const;
+
+    /// <summary>
+    /// Remove all elements from the sets and reset the rebuilt flag.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Estimated number of bytes used by the sets.
+    /// </summary>
+    /// <returns>Number of bytes</returns>
+    std::size_t MemoryUsage() const;
+
+  private:
+    /// <summary>
+    /// Report an element which was added to the mesh.
+    /// </summary>
+    void Created(Vert* v);
+    void Created(Edge* e);
+    void Created(Face* f);
+
+    /// <summary>
+    /// Report an element which is about to be removed from the mesh.
+    /// </summary>
+    void Killed(Vert* v);
+    void Killed(Edge* e);
+    void Killed(Face* f);
+
+    /// <summary>
+    /// Report an element of the mesh which is about to be changed.
+    /// </summary>
+    void Modified(Vert* v);
+    void Modified(Edge* e);
+    void Modified(Face* f);
+
+    /// <summary>
+    /// Discard all sets and report that every element was replaced.
+    /// </summary>
+    void Rebuilt();
+};
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
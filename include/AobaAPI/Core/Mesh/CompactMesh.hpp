@@ -0,0 +1,353 @@
+#ifndef AOBA_CORE_MESH_COMPACTMESH_HPP
+#define AOBA_CORE_MESH_COMPACTMESH_HPP
+
+#include "../../Math/Vector/Vector3.hpp"
+#include "Mesh.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Aoba {
+namespace Core {
+
+class CompactMesh;
+class CompactEdge;
+class CompactFace;
+
+/// <summary>
+/// Vert of a CompactMesh. Lightweight reference, which mirrors the query functions of Vert.
+/// </summary>
+class CompactVert {
+  private:
+    const CompactMesh* cm; // mesh the vert belongs to
+    std::size_t idx;       // index of the vert
+
+  public:
+    CompactVert(const CompactMesh* cm, std::size_t idx);
+
+    /// <summary>
+    /// Index of the vert, equal to Vert::index of the original vert after the snapshot was taken.
+    /// </summary>
+    /// <returns>Index of the vert</returns>
+    std::size_t Index() const;
+
+    /// <summary>
+    /// X,Y,Z vertex coordinates.
+    /// </summary>
+    /// <returns>Coordinates of the vert</returns>
+    const Math::Vec3& Co() const;
+
+    /// <summary>
+    /// X,Y,Z vertex normal.
+    /// </summary>
+    /// <returns>Normal of the vert</returns>
+    const Math::Vec3& No() const;
+
+    /// <summary>
+    /// Number of edges using this vert. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of edges</returns>
+    std::size_t EdgeCount() const;
+
+    /// <summary>
+    /// Edge using this vert, in the order of the edges around the original vert.
+    /// </summary>
+    /// <param name="i">Position of the edge, less than EdgeCount()</param>
+    /// <returns>The edge</returns>
+    CompactEdge Edge(std::size_t i) const;
+
+    /// <summary>
+    /// Number of distinct faces using this vert. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of faces</returns>
+    std::size_t FaceCount() const;
+
+    /// <summary>
+    /// Face using this vert.
+    /// </summary>
+    /// <param name="i">Position of the face, less than FaceCount()</param>
+    /// <returns>The face</returns>
+    CompactFace Face(std::size_t i) const;
+
+    /// <summary>
+    /// Check wether the vert is boundary, see <see cref="Vert::IsBoundary"/>.
+    /// </summary>
+    /// <returns>True if boundary vert, otherwise false.</returns>
+    bool IsBoundary() const;
+
+    /// <summary>
+    /// Check wether the vert is manifold, see <see cref="Vert::IsManifold"/>.
+    /// </summary>
+    /// <returns>True if vert is manifold, otherwise false.</returns>
+    bool IsManifold() const;
+
+    /// <summary>
+    /// Check wether the vert is wire, see <see cref="Vert::IsWire"/>.
+    /// </summary>
+    /// <returns>True if vert is wire, otherwise false.</returns>
+    bool IsWire() const;
+
+    bool operator==(const CompactVert& other) const;
+    bool operator!=(const CompactVert& other) const;
+};
+
+/// <summary>
+/// Edge of a CompactMesh. Lightweight reference, which mirrors the query functions of Edge.
+/// </summary>
+class CompactEdge {
+  private:
+    const CompactMesh* cm; // mesh the edge belongs to
+    std::size_t idx;       // index of the edge
+
+  public:
+    CompactEdge(const CompactMesh* cm, std::size_t idx);
+
+    /// <summary>
+    /// Index of the edge, equal to Edge::index of the original edge after the snapshot was taken.
+    /// </summary>
+    /// <returns>Index of the edge</returns>
+    std::size_t Index() const;
+
+    /// <summary>
+    /// First vert of the edge.
+    /// </summary>
+    /// <returns>First vert</returns>
+    CompactVert V1() const;
+
+    /// <summary>
+    /// Second vert of the edge.
+    /// </summary>
+    /// <returns>Second vert</returns>
+    CompactVert V2() const;
+
+    /// <summary>
+    /// Vert on the other side of the edge. Throws std::invalid_argument if v is not used by the edge.
+    /// </summary>
+    /// <param name="v">Vert used by the edge</param>
+    /// <returns>The other vert</returns>
+    CompactVert Other(const CompactVert& v) const;
+
+    /// <summary>
+    /// Number of loops using this edge. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of loops</returns>
+    std::size_t LoopCount() const;
+
+    /// <summary>
+    /// Face of a loop using this edge, in radial order. A face is reported once for every loop using the edge.
+    /// </summary>
+    /// <param name="i">Position of the loop, less than LoopCount()</param>
+    /// <returns>The face</returns>
+    CompactFace Face(std::size_t i) const;
+
+    /// <summary>
+    /// Calculate the length of the edge.
+    /// </summary>
+    /// <returns>Length of the edge</returns>
+    float CalcLength() const;
+
+    /// <summary>
+    /// Check wether the edge is boundary, see <see cref="Edge::IsBoundary"/>.
+    /// </summary>
+    /// <returns>True if edge is boundary, otherwise false.</returns>
+    bool IsBoundary() const;
+
+    /// <summary>
+    /// Check wether the edge is contigous, see <see cref="Edge::IsContigous"/>.
+    /// </summary>
+    /// <returns>True if edge is contigous, otherwise false.</returns>
+    bool IsContigous() const;
+
+    /// <summary>
+    /// Check wether the edge is manifold, see <see cref="Edge::IsManifold"/>.
+    /// </summary>
+    /// <returns>True if edge is manifold, otherwise false.</returns>
+    bool IsManifold() const;
+
+    /// <summary>
+    /// Check wether the edge is a wire edge, see <see cref="Edge::IsWire"/>.
+    /// </summary>
+    /// <returns>True if edge is wire, otherwise false.</returns>
+    bool IsWire() const;
+
+    bool operator==(const CompactEdge& other) const;
+    bool operator!=(const CompactEdge& other) const;
+};
+
+/// <summary>
+/// Face of a CompactMesh. Lightweight reference, which mirrors the query functions of Face.
+/// </summary>
+class CompactFace {
+  private:
+    const CompactMesh* cm; // mesh the face belongs to
+    std::size_t idx;       // index of the face
+
+  public:
+    CompactFace(const CompactMesh* cm, std::size_t idx);
+
+    /// <summary>
+    /// Index of the face, equal to Face::index of the original face after the snapshot was taken.
+    /// </summary>
+    /// <returns>Index of the face</returns>
+    std::size_t Index() const;
+
+    /// <summary>
+    /// Face normal, as stored in the original face.
+    /// </summary>
+    /// <returns>Normal of the face</returns>
+    const Math::Vec3& No() const;
+
+    /// <summary>
+    /// Number of loops of the face, which equals the number of its verts and edges. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of loops</returns>
+    std::size_t LoopCount() const;
+
+    /// <summary>
+    /// Vert of a loop of the face, in loop order.
+    /// </summary>
+    /// <param name="i">Position of the loop, less than LoopCount()</param>
+    /// <returns>The vert</returns>
+    CompactVert Vert(std::size_t i) const;
+
+    /// <summary>
+    /// Edge of a loop of the face, in loop order.
+    /// </summary>
+    /// <param name="i">Position of the loop, less than LoopCount()</param>
+    /// <returns>The edge</returns>
+    CompactEdge Edge(std::size_t i) const;
+
+    /// <summary>
+    /// Calculate the center of the face as an average value of it's verts.
+    /// </summary>
+    /// <returns>Center of face.</returns>
+    Math::Vec3 CalcCenterAverage() const;
+
+    bool operator==(const CompactFace& other) const;
+    bool operator!=(const CompactFace& other) const;
+};
+
+/// <summary>
+/// Read only snapshot of a mesh, for stages which only query topology. Adjacency is stored in compressed sparse row
+/// arrays and positions and normals are stored densely, so queries do not chase pointers and degrees are known in
+/// constant time. Loops of a face are stored next to each other.
+/// The snapshot does not change along with the mesh. All functions are const and can be called from multiple threads.
+/// </summary>
+class CompactMesh {
+    friend class CompactVert;
+    friend class CompactEdge;
+    friend class CompactFace;
+
+  private:
+    std::vector<Math::Vec3> vertCo;          // coordinates of every vert
+    std::vector<Math::Vec3> vertNo;          // normals of every vert
+    std::vector<uint32_t> vertEdgeOffsets;   // first entry of every vert in vertEdges, followed by the total count
+    std::vector<uint32_t> vertEdges;         // edges around every vert, in disk order
+    std::vector<uint32_t> vertFaceOffsets;   // first entry of every vert in vertFaces, followed by the total count
+    std::vector<uint32_t> vertFaces;         // distinct faces around every vert
+    std::vector<uint32_t> edgeVerts;         // v1, v2 of every edge
+    std::vector<uint32_t> edgeLoopOffsets;   // first entry of every edge in edgeLoops, followed by the total count
+    std::vector<uint32_t> edgeLoops;         // loops using every edge, in radial order
+    std::vector<Math::Vec3> faceNo;          // normals of every face
+    std::vector<uint32_t> faceLoopOffsets;   // first loop of every face, followed by the total number of loops
+    std::vector<uint32_t> loopVert;          // vert every loop starts in
+    std::vector<uint32_t> loopEdge;          // edge of every loop
+    std::vector<uint32_t> loopFace;          // face of every loop
+    std::vector<uint32_t> loopRadialNext;    // next loop around the edge of every loop
+
+    /// <summary>
+    /// Next loop of the face of a loop.
+    /// </summary>
+    uint32_t LoopNext(uint32_t loop) const;
+
+    /// <summary>
+    /// Previous loop of the face of a loop.
+    /// </summary>
+    uint32_t LoopPrev(uint32_t loop) const;
+
+  public:
+    /// <summary>
+    /// Create an empty snapshot.
+    /// </summary>
+    CompactMesh();
+
+    /// <summary>
+    /// Create a snapshot of the mesh, see <see cref="FromMesh"/>.
+    /// </summary>
+    /// <param name="m">Mesh to take the snapshot of</param>
+    explicit CompactMesh(const Mesh* m);
+
+    /// <summary>
+    /// Replace the contents with a snapshot of the mesh, in linear time. Elements are numbered in the order of the
+    /// vert, edge and face lists, and the index of every vert, edge, face and loop of the mesh is overwritten with its
+    /// number in the snapshot.
+    /// </summary>
+    /// <param name="m">Mesh to take the snapshot of</param>
+    /// <exception cref="std::invalid_argument">
+    /// Thrown if the mesh has too many elements to be numbered using 32 bits, the snapshot is left empty in that case.
+    /// </exception>
+    void FromMesh(const Mesh* m);
+
+    /// <summary>
+    /// Number of verts in the snapshot.
+    /// </summary>
+    /// <returns>Number of verts.</returns>
+    std::size_t VertCount() const;
+
+    /// <summary>
+    /// Number of edges in the snapshot.
+    /// </summary>
+    /// <returns>Number of edges.</returns>
+    std::size_t EdgeCount() const;
+
+    /// <summary>
+    /// Number of faces in the snapshot.
+    /// </summary>
+    /// <returns>Number of faces.</returns>
+    std::size_t FaceCount() const;
+
+    /// <summary>
+    /// Number of loops in the snapshot.
+    /// </summary>
+    /// <returns>Number of loops.</returns>
+    std::size_t LoopCount() const;
+
+    /// <summary>
+    /// Vert with the given index.
+    /// </summary>
+    /// <param name="idx">Index of the vert, less than VertCount()</param>
+    /// <returns>The vert</returns>
+    CompactVert Vert(std::size_t idx) const;
+
+    /// <summary>
+    /// Edge with the given index.
+    /// </summary>
+    /// <param name="idx">Index of the edge, less than EdgeCount()</param>
+    /// <returns>The edge</returns>
+    CompactEdge Edge(std::size_t idx) const;
+
+    /// <summary>
+    /// Face with the given index.
+    /// </summary>
+    /// <param name="idx">Index of the face, less than FaceCount()</param>
+    /// <returns>The face</returns>
+    CompactFace Face(std::size_t idx) const;
+
+    /// <summary>
+    /// Coordinates of all verts, indexed by vert index.
+    /// </summary>
+    /// <returns>Dense array of coordinates</returns>
+    const std::vector<Math::Vec3>& Coords() const;
+
+    /// <summary>
+    /// Normals of all verts, indexed by vert index.
+    /// </summary>
+    /// <returns>Dense array of normals</returns>
+    const std::vector<Math::Vec3>& Normals() const;
+};
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
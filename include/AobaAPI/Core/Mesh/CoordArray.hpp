@@ -0,0 +1,135 @@
+#ifndef AOBA_CORE_MESH_COORDARRAY_HPP
+#define AOBA_CORE_MESH_COORDARRAY_HPP
+
+#include "../../Math/Vector/Vector3.hpp"
+#include "../EulerOps.hpp"
+#include "Link.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Aoba {
+namespace Core {
+
+class Mesh;
+class Vert;
+
+/// <summary>
+/// Contiguous storage for vert coordinates and normals of a mesh, see <see cref="Mesh::EnableCoordArrays"/>.
+/// Every storage block of the verts of the mesh gets one chunk, holding the coordinates and normals of all slots of
+/// the block in two parallel arrays. Chunks are never moved, so a vert keeps the address of its coordinates for as
+/// long as its slot is in use. Passes over all coordinates should loop over the chunks, slots which are not in use
+/// hold unspecified values.
+/// </summary>
+class CoordArray {
+    friend class Mesh;
+    friend void JoinMesh(Mesh*, Mesh*);
+
+  public:
+    typedef SlotDirectory<Vert> Directory;
+
+    static Math::Vec3* coChunks[Directory::ID_COUNT]; // coordinates of every vert block, nullptr if kept in the verts
+    static Math::Vec3* noChunks[Directory::ID_COUNT]; // normals of every vert block, nullptr if kept in the verts
+
+  private:
+    std::vector<uint32_t> ids;          // ids of the vert blocks which have a chunk, in chunk order
+    std::vector<std::size_t> starts;    // first slot of every chunk
+    std::vector<std::size_t> byAddress; // indices of chunks, sorted by the address of their coordinates
+    std::size_t size;                   // number of slots in all chunks
+
+    CoordArray();
+    ~CoordArray();
+
+    CoordArray(const CoordArray&) = delete;
+    CoordArray& operator=(const CoordArray&) = delete;
+
+    /// <summary>
+    /// Renumber the slots of all chunks after the list of chunks changed.
+    /// </summary>
+    void Renumber();
+
+    /// <summary>
+    /// Add a chunk for a vert block, unless the block has one already. The slots of the chunk start out zeroed.
+    /// </summary>
+    /// <param name="id">Id of the vert block, which must belong to the mesh of this array</param>
+    void Attach(uint32_t id);
+
+    /// <summary>
+    /// Take over all chunks of the other array, along with the vert blocks they belong to. The chunks stay where
+    /// they are, so the coordinates of the other array keep their addresses. The other array is left empty.
+    /// </summary>
+    /// <param name="other">Array to merge into this array</param>
+    void Merge(CoordArray& other);
+
+    /// <summary>
+    /// Release all chunks, verts of the released chunks store their coordinates inside themselves again.
+    /// Must be called before the vert blocks of the chunks are released.
+    /// </summary>
+    void Release();
+
+    /// <summary>
+    /// Exchange all chunks with the other array.
+    /// </summary>
+    /// <param name="other">Array to swap with</param>
+    void Swap(CoordArray& other);
+
+  public:
+    /// <summary>
+    /// Number of slots in all chunks, including slots which are not used by a vert.
+    /// </summary>
+    /// <returns>Number of slots</returns>
+    std::size_t Size() const;
+
+    /// <summary>
+    /// Number of chunks.
+    /// </summary>
+    /// <returns>Number of chunks</returns>
+    std::size_t ChunkCount() const;
+
+    /// <summary>
+    /// Number of slots inside a chunk.
+    /// </summary>
+    /// <param name="chunk">Index of the chunk</param>
+    /// <returns>Number of slots</returns>
+    std::size_t ChunkSize(std::size_t chunk) const;
+
+    /// <summary>
+    /// Coordinates of the chunk, holding the slots ChunkStart(chunk) up to ChunkStart(chunk) + ChunkSize(chunk).
+    /// </summary>
+    /// <param name="chunk">Index of the chunk</param>
+    /// <returns>Pointer to the first coordinate of the chunk</returns>
+    Math::Vec3* CoChunk(std::size_t chunk) const;
+
+    /// <summary>
+    /// Normals of the chunk, see <see cref="CoChunk"/>.
+    /// </summary>
+    /// <param name="chunk">Index of the chunk</param>
+    /// <returns>Pointer to the first normal of the chunk</returns>
+    Math::Vec3* NoChunk(std::size_t chunk) const;
+
+    /// <summary>
+    /// First slot of a chunk, slots are numbered consecutively over all chunks in chunk order.
+    /// </summary>
+    /// <param name="chunk">Index of the chunk</param>
+    /// <returns>The slot</returns>
+    std::size_t ChunkStart(std::size_t chunk) const;
+
+    /// <summary>
+    /// Number of bytes used by the chunks and their bookkeeping.
+    /// </summary>
+    /// <returns>Number of bytes</returns>
+    std::size_t MemoryUsage() const;
+
+    /// <summary>
+    /// Find the slot of a coordinate stored inside this array. Runs in logarithmic time in the number of chunks.
+    /// </summary>
+    /// <param name="co">Address of the coordinate, obtained using Vert::Co</param>
+    /// <returns>The slot</returns>
+    std::size_t SlotOf(const Math::Vec3* co) const;
+};
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
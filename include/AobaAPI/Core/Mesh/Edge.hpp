@@ -2,11 +2,12 @@
 #define AOBA_CORE_MESH_EDGE_HPP
 
 #include "../EulerOps.hpp"
+#include "Link.hpp"
+#include "Range.hpp"
 #include "../../Math/Vector/Vector3.hpp"
 
 #include <cstdint>
 #include <vector>
-#include <functional>
 
 namespace Aoba {
 namespace Core {
@@ -19,7 +20,17 @@ class Face;
 class Edge {
     friend class Vert;
     friend class Mesh;
+    template<typename T>
+    friend class MeshIterator;
+    template<typename T>
+    friend class Link;
+    template<typename T>
+    friend class ElementPool;
+    template<typename T>
+    friend class JournalRecord;
     friend class Face;
+    friend class VertEdgeIterator;
+    friend class VertLoopIterator;
 
     friend void EdgeSplit(Edge*, Vert*, Edge*, Vert*);
     friend void KillEdge(Edge*);
@@ -35,20 +46,40 @@ class Edge {
     friend void JoinMesh(Mesh*, Mesh*);
 
   public:
-    std::size_t index;   // index of this vert, not updated automatically, used for tools
+    uint32_t index;      // index of this vert, not updated automatically, used for tools
     int32_t flags;       // flags available for use in other tools
     int32_t flagsIntern; // flags for use in internal tools and operators
+    uint32_t visited;    // generation in which the element was last marked, see Mesh::NewGeneration
   private:
-    Vert* v1;     // Unordered verts of this edge.
-    Vert* v2;     // Unordered verts of this edge.
-    Loop* l;      // List of loops using this edge. Use l->eNext/ePrev for traversal.
-    Edge* v1Next; // List of edges around v1
-    Edge* v1Prev; // List of edges around v1
-    Edge* v2Next; // List of edges around v2
-    Edge* v2Prev; // List of edges around v2
-    Mesh* m;      // Pointer to parent mesh. Could potentialy be ommited but might pose a safety issue.
-    Edge* mNext;  // list of all edges in the mesh
-    Edge* mPrev;  // List of all edges in the mesh
+    Link<Vert> v1;     // Unordered verts of this edge.
+    Link<Vert> v2;     // Unordered verts of this edge.
+    Link<Loop> l;      // List of loops using this edge. Use l->eNext/ePrev for traversal.
+    Link<Edge> v1Next; // List of edges around v1
+    Link<Edge> v1Prev; // List of edges around v1
+    Link<Edge> v2Next; // List of edges around v2
+    Link<Edge> v2Prev; // List of edges around v2
+    Link<Edge> mNext;  // list of all edges in the mesh
+    Link<Edge> mPrev;  // List of all edges in the mesh
+    uint32_t slot;     // slot number of this edge, see SlotDirectory
+
+    uint8_t classBits; // cached topology classification, zero while not classified, see Mesh::ClassifyAll
+
+    static const uint8_t CLASS_VALID = 1 << 0;     // classBits hold a valid classification
+    static const uint8_t CLASS_CONTIGOUS = 1 << 1; // cached result of IsContigous
+    static const uint8_t CLASS_MANIFOLD = 1 << 2;  // cached result of IsManifold
+
+    /// <summary>
+    /// Mesh which owns the storage of this edge.
+    /// </summary>
+    /// <returns>The parent mesh</returns>
+    Mesh* ParentMesh() const {
+        return SlotDirectory<Edge>::owners[slot >> SlotDirectory<Edge>::BITS];
+    }
+
+    /// <summary>
+    /// Constructor, leaves the edge without a slot. Edges are created by their ElementPool, see Mesh::NewEdge.
+    /// </summary>
+    Edge();
 
     /// <summary>
     /// Get the next edge in the list of edges around vert v
@@ -74,8 +105,6 @@ class Edge {
     Math::Vec3 CalcLocalNormal(Loop* loop) const;
 
   public:
-    Edge();
-
     /// <summary>
     /// Calculate angle between two faces.
     /// </summary>
@@ -114,13 +143,14 @@ class Edge {
     /// <summary>
     /// Check wether the edge is contigous. Edge is not contigous if it has two faces pointing in separate directions.
     /// Wire edges and boundary edges are always contigous. Edges used three or more times are never contigous.
+    /// Answered from the classification cache if the edge is classified, see <see cref="Mesh::ClassifyAll"/>.
     /// </summary>
     /// <returns>True if edge is contigous, otherwise false.</returns>
     bool IsContigous() const;
 
     /// <summary>
     /// Check wether the edge is manifold. Edge is not manifold if it has three or more adjecent loops, or is a wire
-    /// edge, or has adjecent faces pointing in separate directions.
+    /// edge, or has adjecent faces pointing in separate directions. Cached like <see cref="IsContigous"/>.
     /// </summary>
     /// <returns>True if edge is manifold, otherwise false.</returns>
     bool IsManifold() const;
@@ -142,7 +172,8 @@ class Edge {
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered adjacent faces</returns>
-    const std::vector<Face*> Faces(std::function<bool(const Face* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Face*> Faces(Predicate func) const;
 
     /// <summary>
     /// List of all Loops that use this edge. Do not use this list to add new Loops, use EulerOps instead.
@@ -155,7 +186,8 @@ class Edge {
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered adjacent loops</returns>
-    const std::vector<Loop*> Loops(std::function<bool(const Loop* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Loop*> Loops(Predicate func) const;
 
     /// <summary>
     /// List of all Verts of the edge. Do not use this list to change verts, use EulerOps instead.
@@ -168,7 +200,21 @@ class Edge {
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered verts</returns>
-    const std::vector<Vert*> Verts(std::function<bool(const Vert* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Vert*> Verts(Predicate func) const;
+
+    /// <summary>
+    /// Range of all faces that use this edge, traversed without allocating memory.
+    /// Unlike Faces(), a face is visited once for every loop of the face which uses this edge.
+    /// </summary>
+    /// <returns>Range of faces using this edge.</returns>
+    EdgeFaceRange FaceRange() const;
+
+    /// <summary>
+    /// Range of all loops that use this edge, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of loops using this edge.</returns>
+    EdgeLoopRange LoopRange() const;
 
     /// <summary>
     /// V1 of this edge. Do not use this to change the verts, use EulerOps instead.
@@ -181,8 +227,72 @@ class Edge {
     /// </summary>
     /// <returns>V2</returns>
     Vert* V2() const;
+
+    /// <summary>
+    /// Lazy range of faces which use this edge and fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of faces</returns>
+    template<typename Predicate>
+    Range<FilterIterator<EdgeFaceIterator, Predicate>> FacesWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of loops which use this edge and fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of loops</returns>
+    template<typename Predicate>
+    Range<FilterIterator<EdgeLoopIterator, Predicate>> LoopsWhere(Predicate pred) const;
 };
+template<typename Predicate>
+const std::vector<Face*> Edge::Faces(Predicate func) const {
+    std::vector<Face*> result = std::vector<Face*>();
+    for(Face* face : FaceRange()) {
+        if(func(face)) {
+            result.push_back(face);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<EdgeFaceIterator, Predicate>> Edge::FacesWhere(Predicate pred) const {
+    return Filter(FaceRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Loop*> Edge::Loops(Predicate func) const {
+    std::vector<Loop*> result = std::vector<Loop*>();
+    for(Loop* loop : LoopRange()) {
+        if(func(loop)) {
+            result.push_back(loop);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<EdgeLoopIterator, Predicate>> Edge::LoopsWhere(Predicate pred) const {
+    return Filter(LoopRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Vert*> Edge::Verts(Predicate func) const {
+    std::vector<Vert*> result = std::vector<Vert*>();
+    if(func(v1)) {
+        result.push_back(v1);
+    }
+    if(func(v2)) {
+        result.push_back(v2);
+    }
+    return result;
+}
+
 } // namespace Core
 } // namespace Aoba
 
-#endif
\ No newline at end of file
+#include "RangeInline.hpp"
+
+#endif
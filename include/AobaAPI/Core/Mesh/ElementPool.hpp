@@ -0,0 +1,389 @@
+#ifndef AOBA_CORE_MESH_ELEMENTPOOL_HPP
+#define AOBA_CORE_MESH_ELEMENTPOOL_HPP
+
+#include "Handle.hpp"
+#include "Link.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Aoba {
+namespace Core {
+
+class Mesh;
+
+/// <summary>
+/// Block allocator for mesh elements. Elements are created inside blocks registered in the SlotDirectory, so that
+/// every element has a 32-bit slot number which other elements use to refer to it, see Link. Freed slots are kept in
+/// a free list so that subsequent allocations can reuse them.
+/// Every slot has a generation counter, which is increased whenever the element in the slot is freed. Together with
+/// the slot number it forms a handle, which detects references to elements that no longer exist.
+/// </summary>
+template<typename T>
+class ElementPool {
+  private:
+    typedef SlotDirectory<T> Directory;
+
+    struct SlotRange {
+        uint32_t first; // first slot of the range
+        uint32_t count; // number of slots in the range
+    };
+
+    Mesh* owner;                     // mesh which owns the elements of this pool
+    std::vector<uint32_t> ids;       // directory ids of all blocks owned by this pool
+    std::vector<uint32_t> freeSlots; // slots of freed elements, reused by Allocate
+    std::vector<SlotRange> spare;    // ranges of slots which were never used, handed out before adding new blocks
+    uint32_t cursor;                 // first unused slot of the current range
+    uint32_t end;                    // end of the current range
+    std::size_t capacity;            // total number of slots in all blocks
+    std::size_t spareCount;          // number of slots in spare ranges
+
+    /// <summary>
+    /// Keep the unused slots of the current range as a spare range.
+    /// </summary>
+    void RetireCurrentRange();
+
+    /// <summary>
+    /// Acquire a new block with the given number of slots, which becomes the current range.
+    /// </summary>
+    /// <param name="count">Number of slots, at most SlotDirectory::BLOCK_SLOTS</param>
+    void AddBlock(uint32_t count);
+
+    /// <summary>
+    /// Register all blocks of this pool with its owner in the directory.
+    /// </summary>
+    void ClaimBlocks();
+
+  public:
+    /// <summary>
+    /// Constructor, creates an empty pool.
+    /// </summary>
+    /// <param name="owner">Mesh which owns the elements</param>
+    explicit ElementPool(Mesh* owner);
+    ~ElementPool();
+
+    ElementPool(const ElementPool&) = delete;
+    ElementPool& operator=(const ElementPool&) = delete;
+
+    /// <summary>
+    /// Create a new default constructed element, reusing a free slot if one is available.
+    /// </summary>
+    /// <returns>The new element</returns>
+    /// <exception cref="std::bad_alloc">Thrown if the slot directory has no unused block ids left.</exception>
+    T* Allocate();
+
+    /// <summary>
+    /// Destroy the element, returning its slot to the free list.
+    /// </summary>
+    /// <param name="element">Element allocated by this pool</param>
+    void Free(T* element);
+
+    /// <summary>
+    /// Invalidate the handles of an element without freeing its slot, by increasing the generation of the slot. Used
+    /// for killed elements which are kept so that the kill can be undone.
+    /// </summary>
+    /// <param name="element">Element allocated by this pool</param>
+    void Retire(const T* element);
+
+    /// <summary>
+    /// Make the handles of a retired element resolve again, by reverting the generation increase of Retire.
+    /// </summary>
+    /// <param name="element">Element which was retired, and not freed since</param>
+    void Revive(const T* element);
+
+    /// <summary>
+    /// Check wether the element is stored inside one of the blocks of this pool.
+    /// </summary>
+    /// <param name="element">Element to check</param>
+    /// <returns>True if the element belongs to this pool, otherwise false.</returns>
+    bool Owns(const T* element) const;
+
+    /// <summary>
+    /// Make sure that at least count elements can be allocated without adding a new block.
+    /// </summary>
+    /// <param name="count">Number of elements</param>
+    void Reserve(std::size_t count);
+
+    /// <summary>
+    /// Move all blocks and free slots of the other pool into this pool. Elements allocated by the other pool keep
+    /// their slots and remain valid, and are owned by the mesh of this pool afterwards. Handles obtained from the other
+    /// pool resolve inside this pool. The other pool is left empty.
+    /// </summary>
+    /// <param name="other">Pool to merge into this pool</param>
+    void Merge(ElementPool& other);
+
+    /// <summary>
+    /// Release all elements at once, without destroying them one by one. The blocks are kept and reused by
+    /// subsequent allocations. All elements allocated by this pool become invalid, and so do their handles.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Exchange all blocks and free slots with the other pool. Each pool keeps its owner, so the elements of the
+    /// exchanged blocks change their mesh.
+    /// </summary>
+    /// <param name="other">Pool to swap with</param>
+    void Swap(ElementPool& other);
+
+    /// <summary>
+    /// Create a handle which refers to the element.
+    /// </summary>
+    /// <param name="element">Element allocated by this pool</param>
+    /// <returns>Handle of the element, or a null handle if the element does not belong to this pool</returns>
+    Handle<T> HandleOf(const T* element) const;
+
+    /// <summary>
+    /// Find the element a handle refers to.
+    /// </summary>
+    /// <param name="handle">Handle obtained using HandleOf</param>
+    /// <returns>The element, or nullptr if the handle is null, of another pool or the element was freed</returns>
+    T* Resolve(const Handle<T>& handle) const;
+
+    /// <summary>
+    /// Number of bytes used by the pool, including unused slots, generation counters and free lists.
+    /// </summary>
+    /// <returns>Number of bytes</returns>
+    std::size_t MemoryUsage() const;
+
+    /// <summary>
+    /// Total number of slots in all blocks, including used and free slots.
+    /// </summary>
+    /// <returns>Number of slots</returns>
+    std::size_t Capacity() const;
+
+    /// <summary>
+    /// Number of elements which can be allocated without adding a new block.
+    /// </summary>
+    /// <returns>Number of available slots</returns>
+    std::size_t Available() const;
+
+    /// <summary>
+    /// Number of slots which held an element that was freed, and were not reused yet. Slots which were never used
+    /// since the pool was created or cleared are not counted.
+    /// </summary>
+    /// <returns>Number of freed slots</returns>
+    std::size_t Freed() const;
+};
+
+template<typename T>
+ElementPool<T>::ElementPool(Mesh* owner) : owner(owner) {
+    cursor = 0;
+    end = 0;
+    capacity = 0;
+    spareCount = 0;
+}
+
+template<typename T>
+ElementPool<T>::~ElementPool() {
+    // elements are trivially destructible, only the blocks must be released
+    for(uint32_t id : ids) {
+        Directory::Release(id);
+    }
+}
+
+template<typename T>
+void ElementPool<T>::RetireCurrentRange() {
+    if(cursor != end) {
+        SlotRange tail;
+        tail.first = cursor;
+        tail.count = end - cursor;
+        spare.push_back(tail);
+        spareCount += tail.count;
+    }
+    cursor = 0;
+    end = 0;
+}
+
+template<typename T>
+void ElementPool<T>::AddBlock(uint32_t count) {
+    // do not lose the unused tail of the previous range
+    RetireCurrentRange();
+
+    ids.reserve(ids.size() + 1);
+    uint32_t id = Directory::Acquire(owner, count);
+    ids.push_back(id);
+    cursor = id << Directory::BITS;
+    end = cursor + count;
+    capacity += count;
+}
+
+template<typename T>
+void ElementPool<T>::ClaimBlocks() {
+    for(uint32_t id : ids) {
+        Directory::owners[id] = owner;
+    }
+}
+
+template<typename T>
+T* ElementPool<T>::Allocate() {
+    uint32_t slot;
+    if(!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        if(cursor == end && !spare.empty()) {
+            // reuse a block released by Clear, or the unused tail of a block
+            cursor = spare.back().first;
+            end = spare.back().first + spare.back().count;
+            spareCount -= spare.back().count;
+            spare.pop_back();
+        }
+        if(cursor == end) {
+            // grow geometrically, keeping block sizes within the bounds of the directory
+            std::size_t count = std::max<std::size_t>(capacity, 64);
+            AddBlock(static_cast<uint32_t>(std::min<std::size_t>(count, Directory::BLOCK_SLOTS)));
+        }
+        slot = cursor;
+        ++cursor;
+    }
+    T* element = new(Directory::Decode(slot)) T();
+    element->slot = slot;
+    return element;
+}
+
+template<typename T>
+void ElementPool<T>::Free(T* element) {
+    uint32_t slot = element->slot;
+    ++Directory::generations[slot >> Directory::BITS][slot & Directory::MASK];
+    element->~T();
+    freeSlots.push_back(slot);
+}
+
+template<typename T>
+void ElementPool<T>::Retire(const T* element) {
+    ++Directory::generations[element->slot >> Directory::BITS][element->slot & Directory::MASK];
+}
+
+template<typename T>
+void ElementPool<T>::Revive(const T* element) {
+    --Directory::generations[element->slot >> Directory::BITS][element->slot & Directory::MASK];
+}
+
+template<typename T>
+bool ElementPool<T>::Owns(const T* element) const {
+    return element != nullptr && Directory::owners[element->slot >> Directory::BITS] == owner;
+}
+
+template<typename T>
+void ElementPool<T>::Reserve(std::size_t count) {
+    std::size_t available = Available();
+    while(available < count) {
+        std::size_t missing = count - available;
+        uint32_t blockSize = static_cast<uint32_t>(std::min<std::size_t>(missing, Directory::BLOCK_SLOTS));
+        AddBlock(blockSize);
+        available += blockSize;
+    }
+}
+
+template<typename T>
+void ElementPool<T>::Merge(ElementPool& other) {
+    if(&other == this) {
+        return;
+    }
+
+    // unused slots of the other pool become spare slots of this pool
+    other.RetireCurrentRange();
+    freeSlots.insert(freeSlots.end(), other.freeSlots.begin(), other.freeSlots.end());
+    spare.insert(spare.end(), other.spare.begin(), other.spare.end());
+
+    // slot numbers do not change, the blocks only move to the mesh of this pool
+    ids.insert(ids.end(), other.ids.begin(), other.ids.end());
+    ClaimBlocks();
+    capacity += other.capacity;
+    spareCount += other.spareCount;
+
+    other.ids.clear();
+    other.freeSlots.clear();
+    other.spare.clear();
+    other.capacity = 0;
+    other.spareCount = 0;
+}
+
+template<typename T>
+void ElementPool<T>::Clear() {
+    // elements are trivially destructible, every block simply becomes unused
+    freeSlots.clear();
+    cursor = 0;
+    end = 0;
+    spare.clear();
+    for(uint32_t id : ids) {
+        SlotRange range;
+        range.first = id << Directory::BITS;
+        range.count = Directory::capacities[id];
+        spare.push_back(range);
+
+        // every element died, handles to any of them must not resolve
+        uint32_t* generations = Directory::generations[id];
+        for(uint32_t i = 0; i < range.count; ++i) {
+            ++generations[i];
+        }
+    }
+    spareCount = capacity;
+}
+
+template<typename T>
+void ElementPool<T>::Swap(ElementPool& other) {
+    std::swap(ids, other.ids);
+    std::swap(freeSlots, other.freeSlots);
+    std::swap(spare, other.spare);
+    std::swap(cursor, other.cursor);
+    std::swap(end, other.end);
+    std::swap(capacity, other.capacity);
+    std::swap(spareCount, other.spareCount);
+    ClaimBlocks();
+    other.ClaimBlocks();
+}
+
+template<typename T>
+Handle<T> ElementPool<T>::HandleOf(const T* element) const {
+    Handle<T> handle = Handle<T>();
+    if(Owns(element)) {
+        handle.slot = element->slot;
+        handle.generation = Directory::generations[element->slot >> Directory::BITS][element->slot & Directory::MASK];
+    }
+    return handle;
+}
+
+template<typename T>
+T* ElementPool<T>::Resolve(const Handle<T>& handle) const {
+    if(handle.IsNull()) {
+        return nullptr;
+    }
+    uint32_t id = handle.slot >> Directory::BITS;
+    uint32_t offset = handle.slot & Directory::MASK;
+    if(Directory::owners[id] != owner || offset >= Directory::capacities[id]
+        || Directory::generations[id][offset] != handle.generation) {
+        return nullptr;
+    }
+    return Directory::Decode(handle.slot);
+}
+
+template<typename T>
+std::size_t ElementPool<T>::MemoryUsage() const {
+    return capacity * (sizeof(T) + sizeof(uint32_t))
+        + (ids.capacity() + freeSlots.capacity()) * sizeof(uint32_t) + spare.capacity() * sizeof(SlotRange);
+}
+
+template<typename T>
+std::size_t ElementPool<T>::Capacity() const {
+    return capacity;
+}
+
+template<typename T>
+std::size_t ElementPool<T>::Available() const {
+    return freeSlots.size() + spareCount + (end - cursor);
+}
+
+template<typename T>
+std::size_t ElementPool<T>::Freed() const {
+    return freeSlots.size();
+}
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
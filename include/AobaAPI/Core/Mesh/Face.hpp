@@ -3,10 +3,12 @@
 
 #include "../../Math/Vector/Vector3.hpp"
 #include "../EulerOps.hpp"
+#include "Link.hpp"
+#include "Range.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
-#include <functional>
 
 namespace Aoba {
 namespace Core {
@@ -18,6 +20,14 @@ class Vert;
 
 class Face {
     friend class Mesh;
+    template<typename T>
+    friend class MeshIterator;
+    template<typename T>
+    friend class Link;
+    template<typename T>
+    friend class ElementPool;
+    template<typename T>
+    friend class JournalRecord;
 
     friend void KillFace(Face*);
     friend void KillMesh(Mesh*);
@@ -28,19 +38,32 @@ class Face {
     friend void JoinMesh(Mesh*, Mesh*);
 
   private:
-    Loop* l;     // First loop in a list of loops which form the face boundary. use fNext/fPrev for traversal
-    Mesh* m;     // Pointer to parent mesh. Could potentialy be ommited but might pose a safety issue.
-    Face* mNext; // list of all faces in the mesh
-    Face* mPrev; // List of all faces in the mesh
+    Link<Loop> l;     // First loop in a list of loops which form the face boundary. use fNext/fPrev for traversal
+    Link<Face> mNext; // list of all faces in the mesh
+    Link<Face> mPrev; // List of all faces in the mesh
+    uint32_t slot;    // slot number of this face, see SlotDirectory
+
+    /// <summary>
+    /// Mesh which owns the storage of this face.
+    /// </summary>
+    /// <returns>The parent mesh</returns>
+    Mesh* ParentMesh() const {
+        return SlotDirectory<Face>::owners[slot >> SlotDirectory<Face>::BITS];
+    }
+
+    /// <summary>
+    /// Constructor, leaves the face without a slot. Faces are created by their ElementPool, see Mesh::NewFace.
+    /// </summary>
+    Face();
+
   public:
-    std::size_t index;   // index of this vert, not updated automatically, used for tools
+    uint32_t index;      // index of this vert, not updated automatically, used for tools
     int32_t flags;       // flags available for use in other tools
     int32_t flagsIntern; // flags for use in internal tools and operators
+    uint32_t visited;    // generation in which the element was last marked, see Mesh::NewGeneration
     Math::Vec3 no;       // Face normal
     short materialIdx;   // Face material index
 
-    Face();
-
     /// <summary>
     /// Calculate the area of the face.
     /// </summary>
@@ -92,24 +115,124 @@ class Face {
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered edges</returns>
-    const std::vector<Edge*> Edges(std::function<bool(const Edge* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Edge*> Edges(Predicate func) const;
 
     /// <summary>
     /// List of verts which form this face and fulfill the criteria given by the filtering function. 
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered verts</returns>
-    const std::vector<Vert*> Verts(std::function<bool(const Vert* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Vert*> Verts(Predicate func) const;
 
     /// <summary>
     /// List of loops which form this face and fulfill the criteria given by the filtering function. 
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered loops</returns>
-    const std::vector<Loop*> Loops(std::function<bool(const Loop* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Loop*> Loops(Predicate func) const;
+
+    /// <summary>
+    /// Range of all edges of the face in order, traversed without allocating memory.
+    /// Unlike Edges(), an edge is visited once for every loop of the face which uses it.
+    /// </summary>
+    /// <returns>Range of edges of this face.</returns>
+    FaceEdgeRange EdgeRange() const;
+
+    /// <summary>
+    /// Range of all verts of the face in order, traversed without allocating memory.
+    /// Unlike Verts(), a vert is visited once for every loop of the face which starts in it.
+    /// </summary>
+    /// <returns>Range of verts of this face.</returns>
+    FaceVertRange VertRange() const;
+
+    /// <summary>
+    /// Range of all loops of the face in order, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of loops of this face.</returns>
+    FaceLoopRange LoopRange() const;
+
+    /// <summary>
+    /// Lazy range of edges which form this face and fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of edges</returns>
+    template<typename Predicate>
+    Range<FilterIterator<FaceEdgeIterator, Predicate>> EdgesWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of verts which form this face and fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of verts</returns>
+    template<typename Predicate>
+    Range<FilterIterator<FaceVertIterator, Predicate>> VertsWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of loops which form this face and fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of loops</returns>
+    template<typename Predicate>
+    Range<FilterIterator<FaceLoopIterator, Predicate>> LoopsWhere(Predicate pred) const;
 };
 
+template<typename Predicate>
+const std::vector<Edge*> Face::Edges(Predicate func) const {
+    std::vector<Edge*> result = std::vector<Edge*>();
+    for(Edge* edge : EdgeRange()) {
+        if(func(edge) && std::find(result.begin(), result.end(), edge) == result.end()) {
+            result.push_back(edge);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<FaceEdgeIterator, Predicate>> Face::EdgesWhere(Predicate pred) const {
+    return Filter(EdgeRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Vert*> Face::Verts(Predicate func) const {
+    std::vector<Vert*> result = std::vector<Vert*>();
+    for(Vert* vert : VertRange()) {
+        if(func(vert) && std::find(result.begin(), result.end(), vert) == result.end()) {
+            result.push_back(vert);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<FaceVertIterator, Predicate>> Face::VertsWhere(Predicate pred) const {
+    return Filter(VertRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Loop*> Face::Loops(Predicate func) const {
+    std::vector<Loop*> result = std::vector<Loop*>();
+    for(Loop* loop : LoopRange()) {
+        if(func(loop)) {
+            result.push_back(loop);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<FaceLoopIterator, Predicate>> Face::LoopsWhere(Predicate pred) const {
+    return Filter(LoopRange(), pred);
+}
+
 } // namespace Core
 } // namespace Aoba
 
-#endif
\ No newline at end of file
+#include "RangeInline.hpp"
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef AOBA_CORE_MESH_HANDLE_HPP
+#define AOBA_CORE_MESH_HANDLE_HPP
+
+#include <cstdint>
+
+namespace Aoba {
+namespace Core {
+
+class Vert;
+class Edge;
+class Face;
+class Loop;
+
+/// <summary>
+/// Reference to a mesh element using the number of its storage slot and the generation of the slot, see
+/// <see cref="Mesh::GetHandle"/>. Unlike pointers, handles can be checked for validity: once the element is killed,
+/// the handle no longer resolves. Handles only resolve inside the mesh which owns the element.
+/// </summary>
+template<typename T>
+class Handle {
+  public:
+    static const uint32_t NULL_SLOT = UINT32_MAX; // slot of a handle which does not refer to any element
+
+    uint32_t slot;       // number of the storage slot of the element
+    uint32_t generation; // generation of the slot at the time the handle was created
+
+    /// <summary>
+    /// Constructor, creates a null handle.
+    /// </summary>
+    Handle() : slot(NULL_SLOT), generation(0) {
+    }
+
+    /// <summary>
+    /// Checks wether the handle does not refer to any element.
+    /// </summary>
+    /// <returns>True if the handle is null, otherwise False.</returns>
+    bool IsNull() const {
+        return slot == NULL_SLOT;
+    }
+
+    bool operator==(const Handle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+
+    bool operator!=(const Handle& other) const {
+        return !(*this == other);
+    }
+};
+
+typedef Handle<Vert> VertHandle;
+typedef Handle<Edge> EdgeHandle;
+typedef Handle<Face> FaceHandle;
+typedef Handle<Loop> LoopHandle;
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
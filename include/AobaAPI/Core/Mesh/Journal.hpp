@@ -0,0 +1,125 @@
+#ifndef AOBA_CORE_MESH_JOURNAL_HPP
+#define AOBA_CORE_MESH_JOURNAL_HPP
+
+#include "Edge.hpp"
+#include "Face.hpp"
+#include "Loop.hpp"
+#include "Vert.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Aoba {
+namespace Core {
+
+class Mesh;
+
+/// <summary>
+/// Contents of a single element on the other side of a journal step, see <see cref="MeshJournal"/>.
+/// </summary>
+template<typename T>
+class JournalRecord {
+  public:
+    T* element;       // recorded element
+    T image;          // contents before the step while the step is applied, contents after the step once it is undone
+    bool aliveBefore; // wether the element was part of the mesh before the step
+    bool aliveAfter;  // wether the element is part of the mesh after the step
+};
+
+/// <summary>
+/// All elements changed between two checkpoints, along with the lists and counts of the mesh.
+/// Every element is recorded at most once per step.
+/// </summary>
+class JournalStep {
+  public:
+    std::vector<JournalRecord<Vert>> verts;
+    std::vector<JournalRecord<Edge>> edges;
+    std::vector<JournalRecord<Face>> faces;
+    std::vector<JournalRecord<Loop>> loops;
+
+    Vert* meshVerts;           // head of the vert list on the other side of the step
+    Edge* meshEdges;           // head of the edge list on the other side of the step
+    Face* meshFaces;           // head of the face list on the other side of the step
+    std::size_t meshVertCount; // number of verts on the other side of the step
+    std::size_t meshEdgeCount; // number of edges on the other side of the step
+    std::size_t meshFaceCount; // number of faces on the other side of the step
+
+    JournalStep();
+
+    /// <summary>
+    /// Checks wether no element was recorded.
+    /// </summary>
+    /// <returns>True if the step is empty, otherwise False.</returns>
+    bool IsEmpty() const;
+
+    /// <summary>
+    /// Number of bytes used by the records of the step.
+    /// </summary>
+    /// <returns>Number of bytes</returns>
+    std::size_t MemoryUsage() const;
+};
+
+/// <summary>
+/// Undo history of a mesh, see <see cref="Mesh::EnableJournal"/>.
+/// EulerOps record every element before changing it, along with the elements they create and kill. Killed elements
+/// are kept alive by the journal, so that undoing a step only has to copy the recorded elements back. Undo and redo
+/// exchange the recorded contents with the current contents, so both run in time proportional to the size of the step.
+/// </summary>
+class MeshJournal {
+    friend class Mesh;
+
+  private:
+    std::vector<JournalStep> steps; // closed steps, oldest first
+    std::size_t applied;            // number of steps in front of steps which are applied, the rest can be redone
+    std::size_t memory;             // number of bytes used by the records of all closed steps
+
+    JournalStep open;                                  // changes since the last checkpoint
+    std::unordered_map<const void*, std::size_t> seen; // position of every element recorded in the open step
+
+    MeshJournal();
+
+    MeshJournal(const MeshJournal&) = delete;
+    MeshJournal& operator=(const MeshJournal&) = delete;
+
+    /// <summary>
+    /// Record an element in the open step, unless it was recorded there already.
+    /// </summary>
+    /// <param name="element">Element which is about to be changed, created or killed</param>
+    /// <param name="alive">Wether the element is currently part of the mesh</param>
+    /// <returns>Record of the element</returns>
+    template<typename T>
+    JournalRecord<T>& Record(T* element, bool alive);
+
+    /// <summary>
+    /// Records of the given element type inside a step.
+    /// </summary>
+    static std::vector<JournalRecord<Vert>>& Records(JournalStep& step, const Vert*);
+    static std::vector<JournalRecord<Edge>>& Records(JournalStep& step, const Edge*);
+    static std::vector<JournalRecord<Face>>& Records(JournalStep& step, const Face*);
+    static std::vector<JournalRecord<Loop>>& Records(JournalStep& step, const Loop*);
+
+  public:
+    static const std::size_t DEFAULT_MEMORY_LIMIT = 64 * 1024 * 1024; // default for Mesh::SetJournalLimit
+};
+
+template<typename T>
+JournalRecord<T>& MeshJournal::Record(T* element, bool alive) {
+    std::vector<JournalRecord<T>>& records = Records(open, element);
+    auto inserted = seen.insert(std::make_pair(static_cast<const void*>(element), records.size()));
+    if(inserted.second) {
+        JournalRecord<T> record = JournalRecord<T>();
+        record.element = element;
+        record.image = *element;
+        record.aliveBefore = alive;
+        record.aliveAfter = alive;
+        records.push_back(record);
+    }
+    return records[inserted.first->second];
+}
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
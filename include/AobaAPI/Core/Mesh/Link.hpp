@@ -0,0 +1,204 @@
+#ifndef AOBA_CORE_MESH_LINK_HPP
+#define AOBA_CORE_MESH_LINK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace Aoba {
+namespace Core {
+
+class Mesh;
+
+#ifndef AOBA_SLOT_ID_BITS
+// number of bits of a slot which hold the block id, see SlotDirectory. set using the CMake cache variable of the
+// same name, every translation unit must use the same value
+#define AOBA_SLOT_ID_BITS 18
+#endif
+
+/// <summary>
+/// Process wide directory of the storage blocks of all elements of one type. A slot number consists of the id of a
+/// block in its upper bits and the offset of the element inside the block in its lower bits, so that a 32-bit slot
+/// can be turned into a pointer using a single table lookup. Blocks are acquired and released by ElementPool.
+/// The tables are static, so that decoding a slot needs neither a mesh nor a bounds check. They take
+/// ID_COUNT * 36 bytes of zero initialized storage per element type, about 9 MB with the default of 18 id bits, plus
+/// ID_COUNT * 16 bytes for the chunks of the CoordArray. Only the pages of ids in use are touched. The mutex is only
+/// locked when a block is acquired or released, not per element. All meshes of the process share the ID_COUNT - 1
+/// block ids, every mesh uses at least one block per element type it has elements of. Builds which need less static
+/// storage can lower AOBA_SLOT_ID_BITS.
+/// </summary>
+template<typename T>
+class SlotDirectory {
+  public:
+    static const uint32_t BITS = 14;                          // number of bits of the offset inside a block
+    static const uint32_t BLOCK_SLOTS = 1u << BITS;           // maximum number of slots of a block
+    static const uint32_t MASK = BLOCK_SLOTS - 1;             // bits of the offset inside a block
+    static const uint32_t ID_COUNT = 1u << AOBA_SLOT_ID_BITS; // number of block ids, including the null id
+    static const uint32_t NULL_SLOT = (ID_COUNT - 1) << BITS; // slot which refers to no element, decodes to nullptr
+
+    static_assert(AOBA_SLOT_ID_BITS >= 1 && AOBA_SLOT_ID_BITS <= 32 - BITS, "AOBA_SLOT_ID_BITS must be 1 to 18");
+
+    static T* blocks[ID_COUNT];             // first element of every block, nullptr for unused ids
+    static Mesh* owners[ID_COUNT];          // mesh which owns the block
+    static uint32_t* generations[ID_COUNT]; // generation of every slot of the block
+    static uint32_t capacities[ID_COUNT];   // number of slots of the block
+
+    /// <summary>
+    /// Find the element stored in a slot.
+    /// </summary>
+    /// <param name="slot">Slot number</param>
+    /// <returns>The element, or nullptr for NULL_SLOT</returns>
+    static T* Decode(uint32_t slot) {
+        return blocks[slot >> BITS] + (slot & MASK);
+    }
+
+    /// <summary>
+    /// Allocate a block and assign an unused id to it.
+    /// </summary>
+    /// <param name="owner">Mesh which owns the block</param>
+    /// <param name="capacity">Number of slots, at most BLOCK_SLOTS</param>
+    /// <returns>Id of the new block</returns>
+    /// <exception cref="std::bad_alloc">Thrown if all ids are in use.</exception>
+    static uint32_t Acquire(Mesh* owner, uint32_t capacity);
+
+    /// <summary>
+    /// Release the block with the given id, making the id available again. Slots of a reused id start at a higher
+    /// generation than the slots of the released block, so that old handles do not resolve.
+    /// </summary>
+    /// <param name="id">Id of the block</param>
+    static void Release(uint32_t id);
+
+  private:
+    // all members are constant initialized, so that meshes can be created and destroyed during static
+    // initialization and destruction
+    static uint32_t epochs[ID_COUNT]; // first generation of the slots of the next block using the id
+    static uint32_t unused[ID_COUNT]; // stack of released ids
+    static uint32_t unusedCount;      // number of ids on the stack of released ids
+    static uint32_t nextId;           // smallest id which was never used
+    static std::mutex mutex;          // guards unused, unusedCount and nextId
+};
+
+template<typename T>
+const uint32_t SlotDirectory<T>::BITS;
+template<typename T>
+const uint32_t SlotDirectory<T>::BLOCK_SLOTS;
+template<typename T>
+const uint32_t SlotDirectory<T>::MASK;
+template<typename T>
+const uint32_t SlotDirectory<T>::ID_COUNT;
+template<typename T>
+const uint32_t SlotDirectory<T>::NULL_SLOT;
+
+template<typename T>
+T* SlotDirectory<T>::blocks[SlotDirectory<T>::ID_COUNT] = {};
+template<typename T>
+Mesh* SlotDirectory<T>::owners[SlotDirectory<T>::ID_COUNT] = {};
+template<typename T>
+uint32_t* SlotDirectory<T>::generations[SlotDirectory<T>::ID_COUNT] = {};
+template<typename T>
+uint32_t SlotDirectory<T>::capacities[SlotDirectory<T>::ID_COUNT] = {};
+template<typename T>
+uint32_t SlotDirectory<T>::epochs[SlotDirectory<T>::ID_COUNT] = {};
+template<typename T>
+uint32_t SlotDirectory<T>::unused[SlotDirectory<T>::ID_COUNT] = {};
+template<typename T>
+uint32_t SlotDirectory<T>::unusedCount = 0;
+template<typename T>
+uint32_t SlotDirectory<T>::nextId = 0;
+template<typename T>
+std::mutex SlotDirectory<T>::mutex;
+
+template<typename T>
+uint32_t SlotDirectory<T>::Acquire(Mesh* owner, uint32_t capacity) {
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(unusedCount > 0) {
+            --unusedCount;
+            id = unused[unusedCount];
+        } else if(nextId < ID_COUNT - 1) {
+            id = nextId;
+            ++nextId;
+        } else {
+            throw std::bad_alloc();
+        }
+    }
+    try {
+        blocks[id] = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        generations[id] = new uint32_t[capacity];
+    } catch(...) {
+        ::operator delete(blocks[id]);
+        blocks[id] = nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        unused[unusedCount] = id;
+        ++unusedCount;
+        throw;
+    }
+    std::fill(generations[id], generations[id] + capacity, epochs[id]);
+    capacities[id] = capacity;
+    owners[id] = owner;
+    return id;
+}
+
+template<typename T>
+void SlotDirectory<T>::Release(uint32_t id) {
+    uint32_t* first = generations[id];
+    uint32_t* last = generations[id] + capacities[id];
+    if(first != last) {
+        epochs[id] = *std::max_element(first, last) + 1;
+    }
+    ::operator delete(blocks[id]);
+    delete[] generations[id];
+    blocks[id] = nullptr;
+    generations[id] = nullptr;
+    capacities[id] = 0;
+    owners[id] = nullptr;
+    std::lock_guard<std::mutex> lock(mutex);
+    unused[unusedCount] = id;
+    ++unusedCount;
+}
+
+/// <summary>
+/// Reference from one mesh element to another, stored as the 32-bit slot number of the target, see SlotDirectory.
+/// Behaves like a pointer to the target: it converts to T*, can be dereferenced, and pointers can be assigned to it.
+/// Only elements allocated by a mesh can be referenced.
+/// </summary>
+template<typename T>
+class Link {
+  private:
+    uint32_t slot; // slot number of the target element
+
+  public:
+    Link() = default;
+
+    Link(std::nullptr_t) : slot(SlotDirectory<T>::NULL_SLOT) {
+    }
+
+    explicit Link(T* element) {
+        *this = element;
+    }
+
+    Link& operator=(T* element) {
+        slot = element != nullptr ? element->slot : SlotDirectory<T>::NULL_SLOT;
+        return *this;
+    }
+
+    operator T*() const {
+        return SlotDirectory<T>::Decode(slot);
+    }
+
+    T* operator->() const {
+        return SlotDirectory<T>::Decode(slot);
+    }
+
+    T& operator*() const {
+        return *SlotDirectory<T>::Decode(slot);
+    }
+};
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
@@ -2,6 +2,7 @@
 #define AOBA_CORE_MESH_LOOP_HPP
 
 #include "../EulerOps.hpp"
+#include "Link.hpp"
 
 #include <cstdint>
 
@@ -18,6 +19,19 @@ class Loop {
     friend class Face;
     friend class Vert;
     friend class Mesh;
+    friend class VertLoopIterator;
+    friend class VertFaceIterator;
+    friend class EdgeLoopIterator;
+    friend class EdgeFaceIterator;
+    friend class FaceLoopIterator;
+    friend class FaceEdgeIterator;
+    friend class FaceVertIterator;
+    template<typename T>
+    friend class Link;
+    template<typename T>
+    friend class ElementPool;
+    template<typename T>
+    friend class JournalRecord;
 
     friend void EdgeSplit(Edge*, Vert*, Edge*, Vert*);
     friend void KillFace(Face*);
@@ -30,22 +44,34 @@ class Loop {
     friend void JoinMesh(Mesh*, Mesh*);
 
   public:
-    std::size_t index;   // index of this vert, not updated automatically, used for tools
+    uint32_t index;      // index of this vert, not updated automatically, used for tools
     int32_t flags;       // flags available for use in other tools
     int32_t flagsIntern; // flags for use in internal tools and operators
+    uint32_t visited;    // generation in which the element was last marked, see Mesh::NewGeneration
   private:
-    Vert* v;     // First vert of the edge which this loop uses. Specifies edge orientation.
-    Edge* e;     // Edge which this loop uses. Uses verts v, next->v
-    Face* f;     // Face which is bound by this loop.
-    Loop* eNext; // List of loops around edge e.
-    Loop* ePrev; // List of loops around edge e.
-    Loop* fNext; // List of loops which form the boundary of face f.
-    Loop* fPrev; // List of loops which form the boundary of face f.
-    Mesh* m;     // Pointer to parent mesh. Could potentialy be ommited but might pose a safety issue.
+    Link<Vert> v;     // First vert of the edge which this loop uses. Specifies edge orientation.
+    Link<Edge> e;     // Edge which this loop uses. Uses verts v, next->v
+    Link<Face> f;     // Face which is bound by this loop.
+    Link<Loop> eNext; // List of loops around edge e.
+    Link<Loop> ePrev; // List of loops around edge e.
+    Link<Loop> fNext; // List of loops which form the boundary of face f.
+    Link<Loop> fPrev; // List of loops which form the boundary of face f.
+    uint32_t slot;    // slot number of this loop, see SlotDirectory
 
-  public:
+    /// <summary>
+    /// Mesh which owns the storage of this loop.
+    /// </summary>
+    /// <returns>The parent mesh</returns>
+    Mesh* ParentMesh() const {
+        return SlotDirectory<Loop>::owners[slot >> SlotDirectory<Loop>::BITS];
+    }
+
+    /// <summary>
+    /// Constructor, leaves the loop without a slot. Loops are created by their ElementPool, see Mesh::NewLoop.
+    /// </summary>
     Loop();
 
+  public:
     /// <summary>
     /// Vert which defines the direction of this loop.
     /// </summary>
@@ -63,8 +89,23 @@ class Loop {
     /// </summary>
     /// <returns>Face of the loop</returns>
     Face* LoopFace() const;
+
+    /// <summary>
+    /// Next loop along the boundary of the face of this loop.
+    /// </summary>
+    /// <returns>Next loop of the face</returns>
+    Loop* FaceNext() const;
+
+    /// <summary>
+    /// Previous loop along the boundary of the face of this loop.
+    /// </summary>
+    /// <returns>Previous loop of the face</returns>
+    Loop* FacePrev() const;
 };
 
 } // namespace Core
 } // namespace Aoba
-#endif
\ No newline at end of file
+
+#include "RangeInline.hpp"
+
+#endif
@@ -3,9 +3,18 @@
 
 #include "../../Math/Matrix/Matrix4.hpp"
 #include "../EulerOps.hpp"
+#include "CoordArray.hpp"
+#include "ElementPool.hpp"
+#include "Handle.hpp"
+#include "Range.hpp"
 
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace Aoba {
 namespace Core {
@@ -13,6 +22,112 @@ namespace Core {
 class Vert;
 class Edge;
 class Face;
+class Loop;
+class MeshArrays;
+class MeshChanges;
+class MeshJournal;
+class JournalStep;
+
+template<typename T>
+class JournalRecord;
+
+/// <summary>
+/// Correspondence between the elements of a mesh and its clone, see <see cref="Mesh::Clone"/>.
+/// The clone of an element is stored at the position of the original element in list order. Loops are listed face by
+/// face, starting at the first loop of each face.
+/// </summary>
+class MeshCloneMap {
+  public:
+    std::vector<Vert*> verts; // cloned verts, in the order of VertRange of the original mesh
+    std::vector<Edge*> edges; // cloned edges, in the order of EdgeRange of the original mesh
+    std::vector<Face*> faces; // cloned faces, in the order of FaceRange of the original mesh
+    std::vector<Loop*> loops; // cloned loops, in the order of the loops of every face in FaceRange
+};
+
+/// <summary>
+/// Order in which <see cref="Mesh::Reorder"/> arranges the elements of a mesh.
+/// Morton and Hilbert sort elements along a space filling curve over their position, Hilbert keeps consecutive
+/// elements closer together. BreadthFirst visits faces breadth first over shared edges.
+/// </summary>
+enum class ReorderStrategy { Morton, Hilbert, BreadthFirst };
+
+/// <summary>
+/// Memory used by a mesh, in bytes, see <see cref="Mesh::MemoryUsage"/>.
+/// Element storage includes unused slots. On 64-bit builds elements take 60 bytes per vert, 60 per edge, 48 per face
+/// and 48 per loop, compared with 72, 96, 64 and 80 bytes when elements referred to each other by pointers. Edges and
+/// loops shrink by about 40 percent and faces by 25 percent, but verts only by 17 percent, since their coordinates
+/// and normals take 24 bytes. Every slot also has a 4 byte generation counter.
+/// </summary>
+class MeshMemoryUsage {
+  public:
+    std::size_t vertSize; // size of a single vert
+    std::size_t edgeSize; // size of a single edge
+    std::size_t faceSize; // size of a single face
+    std::size_t loopSize; // size of a single loop
+
+    std::size_t verts;     // storage of all verts, including their slot generations
+    std::size_t edges;     // storage of all edges, including their slot generations
+    std::size_t faces;     // storage of all faces, including their slot generations
+    std::size_t loops;     // storage of all loops, including their slot generations
+    std::size_t coords;    // coordinate arrays, see Mesh::EnableCoordArrays
+    std::size_t edgeIndex; // estimated size of the edge index, see Mesh::EnableEdgeIndex
+    std::size_t journal;   // recorded steps of the journal, see Mesh::EnableJournal
+    std::size_t changes;   // estimated size of the tracked changes, see Mesh::EnableChangeTracking
+    std::size_t total;     // sum of all of the above, except the sizes of single elements
+};
+
+/// <summary>
+/// Reason why an element failed validation, see <see cref="Mesh::Validate"/>.
+/// </summary>
+enum class MeshValidationError {
+    WrongMesh,          // element points to a different mesh
+    BrokenMeshList,     // mNext/mPrev of the element are inconsistent, or the element appears twice in the list
+    CountMismatch,      // number of elements in a list differs from the count of the mesh, no element is set
+    NotInMesh,          // element refers to a vert, edge or face which is not in the lists of the mesh
+    BrokenDiskCycle,    // list of edges around a vert is inconsistent
+    BrokenRadialCycle,  // list of loops around an edge is inconsistent
+    BrokenFaceCycle,    // list of loops of a face is inconsistent
+    LoopMismatch,       // loop does not use its face, or its edge does not connect its vert to the next loop
+    SelfLoop,           // both verts of the edge are the same
+    DoubleEdge,         // another edge connects the same verts
+    DoubleFace,         // an earlier face in the list has the same loop cycle, in either orientation
+    TooFewLoops,        // face has less than 3 loops
+};
+
+/// <summary>
+/// Single failed check of <see cref="Mesh::Validate"/>. Exactly one of the element pointers is set, unless the
+/// error concerns the mesh as a whole.
+/// </summary>
+class MeshValidationIssue {
+  public:
+    MeshValidationError error; // failed check
+    const Vert* vert;          // vert which failed the check, or nullptr
+    const Edge* edge;          // edge which failed the check, or nullptr
+    const Face* face;          // face which failed the check, or nullptr
+    const Loop* loop;          // loop which failed the check, or nullptr
+
+    MeshValidationIssue(MeshValidationError error);
+    MeshValidationIssue(MeshValidationError error, const Vert* v);
+    MeshValidationIssue(MeshValidationError error, const Edge* e);
+    MeshValidationIssue(MeshValidationError error, const Face* f);
+    MeshValidationIssue(MeshValidationError error, const Loop* l);
+};
+
+/// <summary>
+/// Result of <see cref="Mesh::Validate"/>.
+/// </summary>
+class MeshValidationReport {
+  public:
+    std::vector<MeshValidationIssue> issues; // all failed checks, grouped by verts, edges, faces in list order
+
+    /// <summary>
+    /// Checks wether all checks passed.
+    /// </summary>
+    /// <returns>True if no issues were found, otherwise False.</returns>
+    bool IsValid() const {
+        return issues.empty();
+    }
+};
 
 class Mesh {
     friend void EdgeSplit(Edge*, Vert*, Edge*, Vert*);
@@ -23,6 +138,7 @@ class Mesh {
     friend void MakeEdge(Vert*, Vert*, Edge*);
     friend void MakeEdgeVert(Vert*, Edge*, Vert*);
     friend void MakeFace(Loop*, Face*);
+    friend void MakeLoop(std::vector<Edge*>, std::vector<Vert*>, Loop*);
     friend void MakeVert(Mesh*, Vert*);
     friend void GlueVert(Vert*, Vert*);
     friend void ManifoldMakeEdge(Vert*, Vert*, Face*, Edge*, Face*);
@@ -34,6 +150,190 @@ class Mesh {
     Edge* edges; // List of all edges in the mesh.
     Face* faces; // list of all faces in the mesh.
                  // List of loops is omitted, because loops can be easily accessed using faces.
+
+    ElementPool<Vert> vertPool; // Storage for verts created using NewVert.
+    ElementPool<Edge> edgePool; // Storage for edges created using NewEdge.
+    ElementPool<Face> facePool; // Storage for faces created using NewFace.
+    ElementPool<Loop> loopPool; // Storage for loops created using NewLoop.
+
+    std::size_t vertCount; // Number of verts in the mesh, maintained by EulerOps.
+    std::size_t edgeCount; // Number of edges in the mesh, maintained by EulerOps.
+    std::size_t faceCount; // Number of faces in the mesh, maintained by EulerOps.
+
+    uint32_t generation; // Most recent generation handed out by NewGeneration.
+
+    /// <summary>
+    /// Hash of an unordered pair of verts, the pair must be stored with the lower address first.
+    /// </summary>
+    struct VertPairHash {
+        std::size_t operator()(const std::pair<const Vert*, const Vert*>& key) const {
+            std::size_t h1 = std::hash<const Vert*>()(key.first);
+            std::size_t h2 = std::hash<const Vert*>()(key.second);
+            return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+        }
+    };
+
+    bool edgeIndexEnabled; // Wether edgeIndex is maintained, see EnableEdgeIndex.
+    std::unordered_map<std::pair<const Vert*, const Vert*>, Edge*, VertPairHash>
+        edgeIndex; // Edges keyed by their sorted pair of verts, maintained by EulerOps.
+
+    bool coordArraysEnabled; // Wether coordinates of verts are stored inside coordArray, see EnableCoordArrays.
+    CoordArray coordArray;   // Coordinates and normals of the verts if coordArraysEnabled is set, outlived by vertPool.
+
+    /// <summary>
+    /// Copy all elements of this mesh into the storage of target, in list order. Target receives the lists and
+    /// counts. Used by Clone and Compact.
+    /// </summary>
+    /// <param name="target">Empty mesh which stores the copies</param>
+    /// <param name="map">Receives the copies, in list order of the original elements</param>
+    void CopyElements(Mesh* target, MeshCloneMap* map) const;
+
+    /// <summary>
+    /// Add an edge to the edge index, using its current verts. Does nothing if the index is disabled.
+    /// </summary>
+    void IndexEdge(Edge* e);
+
+    /// <summary>
+    /// Remove an edge from the edge index, using its current verts. Does nothing if the index is disabled.
+    /// Must be called before the verts of the edge are changed.
+    /// </summary>
+    void UnindexEdge(Edge* e);
+
+    bool classificationEnabled; // Wether classification bits are maintained, see EnableClassificationCache.
+
+    /// <summary>
+    /// Mark the classification of a vert as out of date. Also used to reset the bits of new elements.
+    /// </summary>
+    void Unclassify(Vert* v);
+
+    /// <summary>
+    /// Mark the classification of an edge and both of its verts as out of date.
+    /// </summary>
+    void Unclassify(Edge* e);
+
+    /// <summary>
+    /// Mark the classification of all edges and verts of a face as out of date. Does nothing if the classification
+    /// cache is disabled.
+    /// </summary>
+    void Unclassify(Face* f);
+
+    /// <summary>
+    /// Append linked elements to the end of a mesh list. The elements must already be linked to each other in order.
+    /// </summary>
+    template<typename T>
+    static void AppendToList(T*& head, const std::vector<T*>& elements);
+
+    /// <summary>
+    /// Walk a mesh list for Validate, collecting every element once. Stops at the first element reached twice.
+    /// </summary>
+    template<typename T>
+    static void CollectList(T* head, std::size_t count, std::unordered_set<const T*>& set, std::vector<T*>& list,
+        MeshValidationReport& report);
+
+    /// <summary>
+    /// Collect the verts of a face for Validate.
+    /// </summary>
+    /// <returns>False if the loops of the face do not form a cycle of at most maxLoops loops.</returns>
+    static bool CollectFaceVerts(const Face* f, std::size_t maxLoops, std::vector<const Vert*>& result);
+
+    MeshJournal* journal;     // Undo history, or nullptr while the journal is disabled, see EnableJournal.
+    std::size_t journalLimit; // Number of bytes the closed steps of the journal may use, see SetJournalLimit.
+
+    /// <summary>
+    /// Record an element in the open step of the journal, which must be enabled. The first record of a step discards
+    /// all steps which could be redone, and stores the lists and counts of the mesh.
+    /// </summary>
+    template<typename T>
+    JournalRecord<T>& RecordElement(T* element, bool alive);
+
+    /// <summary>
+    /// Record a vert in the open step of the journal, see RecordElement. Coordinates stored in the coordinate arrays
+    /// are not part of the vert itself, the record keeps them inside its image.
+    /// </summary>
+    JournalRecord<Vert>& RecordElement(Vert* v, bool alive);
+
+    /// <summary>
+    /// Record an element which is created by an EulerOp. Does nothing if neither the journal nor change tracking is
+    /// enabled, that check is inlined so that EulerOps pay nothing while both are disabled.
+    /// </summary>
+    void RecordCreated(Vert* v);
+    void RecordCreated(Edge* e);
+    void RecordCreated(Face* f);
+    void RecordCreated(Loop* l);
+
+    /// <summary>
+    /// Record a created element in the journal or change tracking, whichever is enabled, see RecordCreated.
+    /// </summary>
+    void RecordCreatedElement(Vert* v);
+    void RecordCreatedElement(Edge* e);
+    void RecordCreatedElement(Face* f);
+    void RecordCreatedElement(Loop* l);
+
+    /// <summary>
+    /// Record a changed element in the journal or change tracking, whichever is enabled, see RecordChange.
+    /// </summary>
+    void RecordChangedElement(Vert* v);
+    void RecordChangedElement(Edge* e);
+    void RecordChangedElement(Face* f);
+    void RecordChangedElement(Loop* l);
+
+    /// <summary>
+    /// Release an element which was killed by an EulerOp. While the journal is enabled, the storage is kept until no
+    /// step refers to the element anymore, but handles of the element no longer resolve unless the kill is undone.
+    /// The element must be recorded before it is changed by the EulerOp.
+    /// </summary>
+    void Dispose(Vert* v);
+    void Dispose(Edge* e);
+    void Dispose(Face* f);
+    void Dispose(Loop* l);
+
+    /// <summary>
+    /// Return the storage of recorded elements which are not part of the mesh on the given side of a step.
+    /// </summary>
+    void FreeStep(JournalStep& step, bool after);
+
+    /// <summary>
+    /// Undo or redo a step, by exchanging the recorded elements, lists and counts with the current ones.
+    /// </summary>
+    void ApplyStep(JournalStep& step, bool undo);
+
+    /// <summary>
+    /// Mark the classification of all recorded elements which are part of the mesh on the given side of the step as
+    /// out of date, along with their neighbours. Also clears the bits restored from the records.
+    /// </summary>
+    void UnclassifyStep(JournalStep& step, bool after);
+
+    /// <summary>
+    /// Discard all steps which could be redone.
+    /// </summary>
+    void DiscardRedo();
+
+    /// <summary>
+    /// Discard the oldest steps while the journal uses more memory than its limit. The latest step is always kept.
+    /// </summary>
+    void TrimJournal();
+
+    /// <summary>
+    /// Discard all steps, including the open one, and release all elements which are only kept by the journal.
+    /// The journal stays enabled.
+    /// </summary>
+    void ResetJournal();
+
+    MeshChanges* changes; // Tracked changes, or nullptr while change tracking is disabled, see EnableChangeTracking.
+
+    /// <summary>
+    /// Report recorded elements to change tracking, depending on wether they are part of the mesh on either side of
+    /// the step.
+    /// </summary>
+    template<typename T>
+    void TrackRecords(std::vector<JournalRecord<T>>& records, bool undo);
+
+    /// <summary>
+    /// Report the elements of a step which change when it is undone or redone to change tracking, which must be
+    /// enabled.
+    /// </summary>
+    void TrackStep(JournalStep& step, bool undo);
+
   public:
     /// <summary>
     /// Constructor, initializes empty lists for verts, edges and faces.
@@ -41,11 +341,489 @@ class Mesh {
     Mesh();
 
     /// <summary>
-    /// Checks wether the mesh is in a valid state.
+    /// Destructor, releases the storage of all elements created using NewVert/NewEdge/NewFace/NewLoop.
+    /// Use the <see cref="KillMesh"/> EulerOp to delete a mesh along with all of its elements.
+    /// </summary>
+    ~Mesh();
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    /// <summary>
+    /// Create a new vert inside the storage of this mesh. The vert is not added to the mesh, use EulerOps to do so.
+    /// The vert must only be used in this mesh, and is recycled by the mesh once it is killed. Elements refer to each
+    /// other by their storage slot, so only elements created by a mesh can be added to it.
+    /// </summary>
+    /// <returns>The new vert</returns>
+    Vert* NewVert();
+
+    /// <summary>
+    /// Create a new edge inside the storage of this mesh. The edge is not added to the mesh, use EulerOps to do so.
+    /// The edge must only be used in this mesh, and is recycled by the mesh once it is killed. Elements refer to each
+    /// other by their storage slot, so only elements created by a mesh can be added to it.
+    /// </summary>
+    /// <returns>The new edge</returns>
+    Edge* NewEdge();
+
+    /// <summary>
+    /// Create a new face inside the storage of this mesh. The face is not added to the mesh, use EulerOps to do so.
+    /// The face must only be used in this mesh, and is recycled by the mesh once it is killed. Elements refer to each
+    /// other by their storage slot, so only elements created by a mesh can be added to it.
+    /// </summary>
+    /// <returns>The new face</returns>
+    Face* NewFace();
+
+    /// <summary>
+    /// Create a new loop inside the storage of this mesh. The loop is not added to the mesh, use EulerOps to do so.
+    /// The loop must only be used in this mesh, and is recycled by the mesh once it is killed. Elements refer to each
+    /// other by their storage slot, so only elements created by a mesh can be added to it.
+    /// </summary>
+    /// <returns>The new loop</returns>
+    Loop* NewLoop();
+
+    /// <summary>
+    /// Create a copy of this mesh, including flags, normals and material indices of all elements.
+    /// Elements are copied in a single linear pass, internal pointers are rewritten using dense lookup tables keyed by
+    /// slot. This mesh is not modified, and the cloned elements receive the same index as the originals.
+    /// </summary>
+    /// <returns>The new mesh</returns>
+    Mesh* Clone() const;
+
+    /// <summary>
+    /// Create a copy of this mesh, see <see cref="Clone()"/>, and report which clone belongs to which element.
+    /// </summary>
+    /// <param name="map">Receives the cloned elements, in list order of the original elements</param>
+    /// <returns>The new mesh</returns>
+    Mesh* Clone(MeshCloneMap* map) const;
+
+    /// <summary>
+    /// Delete all elements of the mesh, returning it to an empty state. Runs in linear time, elements are released
+    /// without unlinking them one by one. The element storage is kept, and reused by subsequent NewVert/NewEdge/
+    /// NewFace/NewLoop calls.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Fraction of the used element storage which is left by killed elements that await reuse. Storage which was never
+    /// used, like storage added by Reserve or released by Clear, is not counted, so it does not trigger Compact.
+    /// </summary>
+    /// <returns>Ratio between 0 and 1.</returns>
+    float FreeStorageRatio() const;
+
+    /// <summary>
+    /// Defragment the element storage if the fraction of storage left by killed elements is at least threshold, see
+    /// <see cref="FreeStorageRatio"/>. All elements are moved into fresh, tightly packed storage in the order of the
+    /// vert, edge and face lists, so that traversals walk memory sequentially again. The old storage is released.
+    /// All pointers and handles to elements of the mesh are invalidated. Elements which were created using
+    /// NewVert/NewEdge/NewFace/NewLoop but never added to the mesh are released as well.
+    /// </summary>
+    /// <param name="threshold">Minimal fraction of storage left by killed elements, use 0 to always compact.</param>
+    /// <returns>True if the mesh was compacted, otherwise False.</returns>
+    bool Compact(float threshold);
+
+    /// <summary>
+    /// Arrange the vert, edge and face lists of the mesh in spatial or topological order, and move the elements into
+    /// storage which follows that order, see <see cref="Compact"/>. Traversals over the lists then walk memory almost
+    /// sequentially, and neighbouring elements are stored close to each other.
+    /// Verts are ordered by their coordinates, edges by their center and faces by the average of their verts, or by
+    /// the breadth first traversal of faces. Loops follow the order of their faces.
+    /// All pointers and handles to elements of the mesh are invalidated.
+    /// </summary>
+    /// <param name="strategy">Order to arrange the elements in.</param>
+    void Reorder(ReorderStrategy strategy);
+
+    /// <summary>
+    /// Preallocate storage for elements which are about to be created using NewVert/NewEdge/NewFace/NewLoop.
+    /// Operators creating a known number of elements should call this first, to avoid growing the storage repeatedly.
+    /// </summary>
+    /// <param name="verts">Number of verts to reserve storage for.</param>
+    /// <param name="edges">Number of edges to reserve storage for.</param>
+    /// <param name="faces">Number of faces to reserve storage for.</param>
+    /// <param name="loops">Number of loops to reserve storage for.</param>
+    void Reserve(std::size_t verts, std::size_t edges, std::size_t faces, std::size_t loops);
+
+    /// <summary>
+    /// Number of verts inside the mesh. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of verts.</returns>
+    std::size_t VertCount() const;
+
+    /// <summary>
+    /// Number of edges inside the mesh. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of edges.</returns>
+    std::size_t EdgeCount() const;
+
+    /// <summary>
+    /// Number of faces inside the mesh. Runs in constant time.
+    /// </summary>
+    /// <returns>Number of faces.</returns>
+    std::size_t FaceCount() const;
+
+    /// <summary>
+    /// Add the polygons of an index based mesh to this mesh in a single pass. Edges shared between faces are found
+    /// using a hash table, and the disk and radial lists are linked directly, which is considerably faster than
+    /// creating the same mesh using MakeVert/MakeEdge/MakeLoop/MakeFace.
+    /// The new verts and faces are appended to the vert and face lists in index order.
+    /// </summary>
+    /// <param name="positions">Packed vert coordinates, in x,y,z order.</param>
+    /// <param name="faceOffsets">Offset of the first index of each face in faceIndices, followed by the total number
+    /// of indices. Face i uses faceIndices[faceOffsets[i]] up to faceIndices[faceOffsets[i + 1]].</param>
+    /// <param name="faceIndices">Vert indices of all faces, in loop order.</param>
+    /// <exception cref="std::invalid_argument">
+    /// Thrown if an index is out of range, a face has less than three verts or uses the same vert twice in a row, or a
+    /// face repeats the verts of an earlier face in the same cyclic order, in either orientation. The mesh is left
+    /// untouched in that case.
+    /// </exception>
+    void FromIndexed(const std::vector<float>& positions, const std::vector<std::size_t>& faceOffsets,
+        const std::vector<std::size_t>& faceIndices);
+
+    /// <summary>
+    /// Add the polygons and wire edges of an index based mesh to this mesh in a single pass, like the overload without
+    /// wire edges. The wire edges are appended to the edge list behind the edges of the faces. Pairs which match an
+    /// edge of a face, or an earlier pair, do not create another edge.
+    /// </summary>
+    /// <param name="positions">Packed vert coordinates, in x,y,z order.</param>
+    /// <param name="faceOffsets">Offset of the first index of each face in faceIndices, followed by the total number
+    /// of indices.</param>
+    /// <param name="faceIndices">Vert indices of all faces, in loop order.</param>
+    /// <param name="edgeIndices">Pairs of vert indices, one pair per wire edge.</param>
+    /// <exception cref="std::invalid_argument">
+    /// Thrown if the faces are invalid like in the overload without wire edges, or an edge index is out of range or
+    /// both indices of a pair are the same. The mesh is left untouched in that case.
+    /// </exception>
+    void FromIndexed(const std::vector<float>& positions, const std::vector<std::size_t>& faceOffsets,
+        const std::vector<std::size_t>& faceIndices, const std::vector<std::size_t>& edgeIndices);
+
+    /// <summary>
+    /// Store all elements of this mesh in flat arrays, see <see cref="MeshArrays"/>. Overwrites Vert::index,
+    /// Edge::index, Face::index and Loop::index with the numbers of the elements.
+    /// </summary>
+    /// <param name="arrays">Receives the elements</param>
+    /// <exception cref="std::invalid_argument">
+    /// Thrown if the mesh has too many elements to be numbered using 32 bits.
+    /// </exception>
+    void ToArrays(MeshArrays& arrays) const;
+
+    /// <summary>
+    /// Add the elements stored in flat arrays to this mesh, restoring the exact structure saved by
+    /// <see cref="ToArrays"/>. The arrays are checked first, so that every link refers to an element of a matching
+    /// type and vert. The new elements are then linked on multiple threads, and appended to the lists in array order.
+    /// </summary>
+    /// <param name="arrays">Elements to add</param>
+    /// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+    /// <exception cref="std::invalid_argument">
+    /// Thrown if the arrays are inconsistent, the mesh is left untouched in that case.
+    /// </exception>
+    void FromArrays(const MeshArrays& arrays, std::size_t threadCount);
+
+    /// <summary>
+    /// Enable or disable the coordinate arrays. While enabled, coordinates and normals of all verts in the mesh are
+    /// stored in contiguous per mesh arrays instead of inside the verts, so passes over all coordinates run over
+    /// sequential memory. The arrays follow the storage blocks of the verts, a vert uses the slot matching its own
+    /// storage slot. Vert::Co and Vert::No give access to the coordinates in both modes. Switching modes moves all
+    /// coordinates in linear time, and invalidates references obtained using Vert::Co and Vert::No.
+    /// The coordinate arrays are disabled by default.
+    /// </summary>
+    /// <param name="enable">True to move coordinates into the arrays, False to move them back into the verts.</param>
+    void EnableCoordArrays(bool enable);
+
+    /// <summary>
+    /// Checks wether the coordinate arrays are enabled, see <see cref="EnableCoordArrays"/>.
+    /// </summary>
+    /// <returns>True if the coordinate arrays are enabled, otherwise False.</returns>
+    bool IsCoordArraysEnabled() const;
+
+    /// <summary>
+    /// Coordinate arrays of the mesh. Only holds coordinates while <see cref="IsCoordArraysEnabled"/> is true.
+    /// </summary>
+    /// <returns>The coordinate arrays</returns>
+    const CoordArray& CoordArrays() const;
+
+    /// <summary>
+    /// Enable or disable the edge index. While enabled, the mesh keeps a hash table of all edges keyed by their verts,
+    /// which is kept up to date by EulerOps and makes FindEdge run in constant time on average.
+    /// Enabling the index builds it from the current edges in linear time, disabling it releases its memory.
+    /// The index is disabled by default, since small meshes rarely benefit from it.
+    /// </summary>
+    /// <param name="enable">True to build and maintain the index, False to release it.</param>
+    void EnableEdgeIndex(bool enable);
+
+    /// <summary>
+    /// Checks wether the edge index is enabled, see <see cref="EnableEdgeIndex"/>.
+    /// </summary>
+    /// <returns>True if the edge index is enabled, otherwise False.</returns>
+    bool IsEdgeIndexEnabled() const;
+
+    /// <summary>
+    /// Find the edge between two verts of the mesh. Uses the edge index if it is enabled, otherwise the edges around
+    /// v1 are searched.
+    /// </summary>
+    /// <param name="v1">First vert of the edge.</param>
+    /// <param name="v2">Second vert of the edge.</param>
+    /// <returns>Edge between v1 and v2, or nullptr if the verts are not connected.</returns>
+    Edge* FindEdge(const Vert* v1, const Vert* v2) const;
+
+    /// <summary>
+    /// Enable or disable the classification cache. While enabled, Vert::IsBoundary, Vert::IsManifold, Vert::IsWire,
+    /// Edge::IsContigous and Edge::IsManifold are answered from bits stored in the elements. EulerOps mark the
+    /// elements around every change as unclassified, these fall back to walking the mesh until the next ClassifyAll.
+    /// Enabling the cache classifies all elements, disabling it discards the bits. The cache is disabled by default.
+    /// </summary>
+    /// <param name="enable">True to classify all elements and maintain the cache, False to discard it.</param>
+    void EnableClassificationCache(bool enable);
+
+    /// <summary>
+    /// Checks wether the classification cache is enabled, see <see cref="EnableClassificationCache"/>.
+    /// </summary>
+    /// <returns>True if the classification cache is enabled, otherwise False.</returns>
+    bool IsClassificationCacheEnabled() const;
+
+    /// <summary>
+    /// Classify all verts and edges of the mesh on multiple threads and enable the classification cache.
+    /// Edges are classified before verts, so that verts can use the cached edge classification.
+    /// </summary>
+    void ClassifyAll();
+
+    /// <summary>
+    /// Enable or disable the journal. While enabled, EulerOps record every element before changing it, and keep
+    /// killed elements alive, so that the changes can be undone and redone using <see cref="Undo"/> and
+    /// <see cref="Redo"/> in time proportional to the number of changed elements. Changes are grouped into steps by
+    /// <see cref="Checkpoint"/>. Operators which change attributes of existing elements record them using
+    /// <see cref="RecordChange(Vert*)"/>.
+    /// Clear, Compact, Reorder and JoinMesh discard all steps. Clones do not copy the journal.
+    /// Disabling the journal discards all steps. The journal is disabled by default.
+    /// </summary>
+    /// <param name="enable">True to start recording, False to discard all steps and stop recording.</param>
+    void EnableJournal(bool enable);
+
+    /// <summary>
+    /// Checks wether the journal is enabled, see <see cref="EnableJournal"/>.
+    /// </summary>
+    /// <returns>True if the journal is enabled, otherwise False.</returns>
+    bool IsJournalEnabled() const;
+
+    /// <summary>
+    /// Limit the memory used by the journal. Once the steps use more memory, the oldest steps are discarded, the
+    /// latest step is always kept. Each element is recorded at most once per step, so large operators should not be
+    /// split into many steps. The default limit is MeshJournal::DEFAULT_MEMORY_LIMIT.
+    /// </summary>
+    /// <param name="bytes">Number of bytes the steps may use.</param>
+    void SetJournalLimit(std::size_t bytes);
+
+    /// <summary>
+    /// Close the current step of the journal, so that the changes since the previous checkpoint are undone together.
+    /// Checkpoints without changes since the previous checkpoint are ignored. Elements which were created and killed
+    /// within the step are released right away. Does nothing if the journal is disabled.
+    /// </summary>
+    void Checkpoint();
+
+    /// <summary>
+    /// Undo the latest step of the journal, closing it first if necessary. Pointers to elements which are killed by
+    /// undoing a step remain valid until the step is discarded, and are restored by Redo. Restored elements keep
+    /// their addresses and handles.
+    /// </summary>
+    /// <returns>True if a step was undone, False if there was no step to undo.</returns>
+    bool Undo();
+
+    /// <summary>
+    /// Redo the latest undone step of the journal. Steps which were undone are discarded as soon as the mesh is
+    /// changed again.
+    /// </summary>
+    /// <returns>True if a step was redone, False if there was no step to redo.</returns>
+    bool Redo();
+
+    /// <summary>
+    /// Number of steps which can be undone, including the current step if anything was recorded since the last
+    /// checkpoint.
+    /// </summary>
+    /// <returns>Number of steps.</returns>
+    std::size_t UndoCount() const;
+
+    /// <summary>
+    /// Number of steps which can be redone.
+    /// </summary>
+    /// <returns>Number of steps.</returns>
+    std::size_t RedoCount() const;
+
+    /// <summary>
+    /// Record a vert before changing its coordinates, normal or flags outside of EulerOps, so that the change can be
+    /// undone and is reported by change tracking. Verts only need to be recorded once per step, elements created in
+    /// the current step need not be recorded. Does nothing if neither the journal nor change tracking is enabled, or
+    /// if v is nullptr.
+    /// </summary>
+    /// <param name="v">Vert of this mesh which is about to be changed</param>
+    void RecordChange(Vert* v);
+
+    /// <summary>
+    /// Record an edge before changing it outside of EulerOps, see <see cref="RecordChange(Vert*)"/>.
+    /// </summary>
+    /// <param name="e">Edge of this mesh which is about to be changed</param>
+    void RecordChange(Edge* e);
+
+    /// <summary>
+    /// Record a face before changing its normal, material or flags outside of EulerOps, see
+    /// <see cref="RecordChange(Vert*)"/>.
+    /// </summary>
+    /// <param name="f">Face of this mesh which is about to be changed</param>
+    void RecordChange(Face* f);
+
+    /// <summary>
+    /// Record a loop before changing it outside of EulerOps, see <see cref="RecordChange(Vert*)"/>. Change tracking
+    /// reports the face of the loop as modified.
+    /// </summary>
+    /// <param name="l">Loop of this mesh which is about to be changed</param>
+    void RecordChange(Loop* l);
+
+    /// <summary>
+    /// Set the coordinates of a vert, recording the vert first, see <see cref="RecordChange(Vert*)"/>. Operators use
+    /// this instead of writing to <see cref="Vert::Co()"/>, which is not recorded.
+    /// </summary>
+    /// <param name="v">Vert of this mesh</param>
+    /// <param name="co">New coordinates</param>
+    void SetCo(Vert* v, const Math::Vec3& co);
+
+    /// <summary>
+    /// Set the normal of a vert, recording the vert first, see <see cref="SetCo"/>.
+    /// </summary>
+    /// <param name="v">Vert of this mesh</param>
+    /// <param name="no">New normal</param>
+    void SetNo(Vert* v, const Math::Vec3& no);
+
+    /// <summary>
+    /// Set the normal of a face, recording the face first, see <see cref="SetCo"/>.
+    /// </summary>
+    /// <param name="f">Face of this mesh</param>
+    /// <param name="no">New normal</param>
+    void SetNo(Face* f, const Math::Vec3& no);
+
+    /// <summary>
+    /// Recalculate the normal of a face using <see cref="Face::NormalUpdate"/>, recording the face first.
+    /// </summary>
+    /// <param name="f">Face of this mesh</param>
+    void NormalUpdate(Face* f);
+
+    /// <summary>
+    /// Enable or disable change tracking. While enabled, the mesh collects the verts, edges and faces which were
+    /// created, killed or modified, so that consumers can update their own copies incrementally. EulerOps report
+    /// their elements, operators which change attributes of existing elements report them using
+    /// <see cref="RecordChange(Vert*)"/>. Undo and Redo report the elements they restore. Clear, Compact and Reorder
+    /// replace all elements and set <see cref="MeshChanges::rebuilt"/>, JoinMesh reports the elements of the joined
+    /// mesh as created. Clones do not copy the tracked changes. Change tracking is disabled by default.
+    /// </summary>
+    /// <param name="enable">True to start tracking with empty sets, False to discard the tracked changes.</param>
+    void EnableChangeTracking(bool enable);
+
+    /// <summary>
+    /// Checks wether change tracking is enabled, see <see cref="EnableChangeTracking"/>.
+    /// </summary>
+    /// <returns>True if change tracking is enabled, otherwise False.</returns>
+    bool IsChangeTrackingEnabled() const;
+
+    /// <summary>
+    /// Changes since change tracking was enabled or last reset by TakeChanges. Throws std::invalid_argument if change
+    /// tracking is disabled.
+    /// </summary>
+    /// <returns>The tracked changes</returns>
+    const MeshChanges& Changes() const;
+
+    /// <summary>
+    /// Fetch the tracked changes and reset them, so that the next call only reports later changes. Throws
+    /// std::invalid_argument if change tracking is disabled.
+    /// </summary>
+    /// <returns>Changes since change tracking was enabled or last reset</returns>
+    MeshChanges TakeChanges();
+
+    /// <summary>
+    /// Create a handle which refers to a vert created using NewVert. Handles can be stored instead of pointers to
+    /// detect references to killed verts. Handles remain valid until the vert is killed or the mesh is cleared or
+    /// compacted. Handles of a mesh which is joined into another mesh resolve inside the other mesh.
+    /// </summary>
+    /// <param name="v">Vert created by this mesh</param>
+    /// <returns>Handle of the vert, or a null handle if the vert does not belong to this mesh.</returns>
+    VertHandle GetHandle(const Vert* v) const;
+
+    /// <summary>
+    /// Create a handle which refers to an edge created using NewEdge, see <see cref="GetHandle(const Vert*)"/>.
+    /// </summary>
+    /// <param name="e">Edge created by this mesh</param>
+    /// <returns>Handle of the edge, or a null handle if the edge does not belong to this mesh.</returns>
+    EdgeHandle GetHandle(const Edge* e) const;
+
+    /// <summary>
+    /// Create a handle which refers to a face created using NewFace, see <see cref="GetHandle(const Vert*)"/>.
+    /// </summary>
+    /// <param name="f">Face created by this mesh</param>
+    /// <returns>Handle of the face, or a null handle if the face does not belong to this mesh.</returns>
+    FaceHandle GetHandle(const Face* f) const;
+
+    /// <summary>
+    /// Create a handle which refers to a loop created using NewLoop, see <see cref="GetHandle(const Vert*)"/>.
+    /// </summary>
+    /// <param name="l">Loop created by this mesh</param>
+    /// <returns>Handle of the loop, or a null handle if the loop does not belong to this mesh.</returns>
+    LoopHandle GetHandle(const Loop* l) const;
+
+    /// <summary>
+    /// Find the vert a handle refers to. Runs in constant time.
+    /// Handles of elements killed while the journal is enabled resolve again once the kill is undone.
+    /// </summary>
+    /// <param name="handle">Handle obtained using GetHandle</param>
+    /// <returns>The vert, or nullptr if the handle is null or the vert was killed.</returns>
+    Vert* Resolve(const VertHandle& handle) const;
+
+    /// <summary>
+    /// Find the edge a handle refers to, see <see cref="Resolve(const VertHandle&)"/>.
+    /// </summary>
+    /// <param name="handle">Handle obtained using GetHandle</param>
+    /// <returns>The edge, or nullptr if the handle is null or the edge was killed.</returns>
+    Edge* Resolve(const EdgeHandle& handle) const;
+
+    /// <summary>
+    /// Find the face a handle refers to, see <see cref="Resolve(const VertHandle&)"/>.
+    /// </summary>
+    /// <param name="handle">Handle obtained using GetHandle</param>
+    /// <returns>The face, or nullptr if the handle is null or the face was killed.</returns>
+    Face* Resolve(const FaceHandle& handle) const;
+
+    /// <summary>
+    /// Find the loop a handle refers to, see <see cref="Resolve(const VertHandle&)"/>.
+    /// </summary>
+    /// <param name="handle">Handle obtained using GetHandle</param>
+    /// <returns>The loop, or nullptr if the handle is null or the loop was killed.</returns>
+    Loop* Resolve(const LoopHandle& handle) const;
+
+    /// <summary>
+    /// Report the memory used by the mesh, per element type and in total.
+    /// </summary>
+    /// <returns>Memory used by the mesh</returns>
+    MeshMemoryUsage MemoryUsage() const;
+
+    /// <summary>
+    /// Start a new generation of visit markers. An element counts as visited by an operator if it was marked with
+    /// the generation obtained by the operator, so markers never have to be cleared after use. Operators mark
+    /// elements using <see cref="Mark"/> and <see cref="IsMarked"/>, or <see cref="SetMark"/> and
+    /// <see cref="HasMark"/> if they need multiple flags per element. Generations do not nest, see SetMark.
+    /// Elements which do not belong to the mesh must not be marked.
+    /// </summary>
+    /// <returns>Generation which no element of the mesh is marked with.</returns>
+    uint32_t NewGeneration();
+
+    /// <summary>
+    /// Checks wether the mesh is in a valid state, see <see cref="Validate"/>.
     /// </summary>
     /// <returns>True if the mesh is in a valid state, otherwise False.</returns>
     bool IsValid() const;
 
+    /// <summary>
+    /// Check the whole mesh and report every element which is not in a valid state. Checks the mesh lists and
+    /// counts, the edges around every vert, the loops around every edge and of every face, the pointers between
+    /// elements, and looks for self loops, double edges and double faces. Runs in linear time, the elements are
+    /// split across multiple threads. Elements are only read, so the mesh must not be modified during validation.
+    /// </summary>
+    /// <returns>Report listing all failed checks.</returns>
+    MeshValidationReport Validate() const;
+
     /// <summary>
     /// Transform all mesh elements using a 4x4 transformation matrix.
     /// </summary>
@@ -70,28 +848,172 @@ class Mesh {
     /// <returns>List containing references to all Faces inside the mesh. </returns>
     const std::vector<Face*> Faces() const;
 
+    /// <summary>
+    /// Range of all verts inside the mesh, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of verts inside the mesh.</returns>
+    MeshVertRange VertRange() const;
+
+    /// <summary>
+    /// Range of all edges inside the mesh, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of edges inside the mesh.</returns>
+    MeshEdgeRange EdgeRange() const;
+
+    /// <summary>
+    /// Range of all faces inside the mesh, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of faces inside the mesh.</returns>
+    MeshFaceRange FaceRange() const;
+
     /// <summary>
     /// List of verts iun the mesh which fulfill the criteria given by the filtering function.
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered verts</returns>
-    const std::vector<Vert*> Verts(std::function<bool(const Vert* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Vert*> Verts(Predicate func) const;
 
     /// <summary>
     /// List of edges iun the mesh which fulfill the criteria given by the filtering function.
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered edges</returns>
-    const std::vector<Edge*> Edges(std::function<bool(const Edge* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Edge*> Edges(Predicate func) const;
 
     /// <summary>
     /// List of faces iun the mesh which fulfill the criteria given by the filtering function.
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered faces</returns>
-    const std::vector<Face*> Faces(std::function<bool(const Face* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Face*> Faces(Predicate func) const;
+
+    /// <summary>
+    /// Lazy range of verts in the mesh which fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of verts</returns>
+    template<typename Predicate>
+    Range<FilterIterator<MeshVertIterator, Predicate>> VertsWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of edges in the mesh which fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of edges</returns>
+    template<typename Predicate>
+    Range<FilterIterator<MeshEdgeIterator, Predicate>> EdgesWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of faces in the mesh which fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of faces</returns>
+    template<typename Predicate>
+    Range<FilterIterator<MeshFaceIterator, Predicate>> FacesWhere(Predicate pred) const;
 };
 
+template<typename Predicate>
+const std::vector<Vert*> Mesh::Verts(Predicate func) const {
+    std::vector<Vert*> result = std::vector<Vert*>();
+    for(Vert* vert : VertRange()) {
+        if(func(vert)) {
+            result.push_back(vert);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<MeshVertIterator, Predicate>> Mesh::VertsWhere(Predicate pred) const {
+    return Filter(VertRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Edge*> Mesh::Edges(Predicate func) const {
+    std::vector<Edge*> result = std::vector<Edge*>();
+    for(Edge* edge : EdgeRange()) {
+        if(func(edge)) {
+            result.push_back(edge);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<MeshEdgeIterator, Predicate>> Mesh::EdgesWhere(Predicate pred) const {
+    return Filter(EdgeRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Face*> Mesh::Faces(Predicate func) const {
+    std::vector<Face*> result = std::vector<Face*>();
+    for(Face* face : FaceRange()) {
+        if(func(face)) {
+            result.push_back(face);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<MeshFaceIterator, Predicate>> Mesh::FacesWhere(Predicate pred) const {
+    return Filter(FaceRange(), pred);
+}
+
+inline void Mesh::RecordCreated(Vert* v) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordCreatedElement(v);
+    }
+}
+
+inline void Mesh::RecordCreated(Edge* e) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordCreatedElement(e);
+    }
+}
+
+inline void Mesh::RecordCreated(Face* f) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordCreatedElement(f);
+    }
+}
+
+inline void Mesh::RecordCreated(Loop* l) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordCreatedElement(l);
+    }
+}
+
+inline void Mesh::RecordChange(Vert* v) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordChangedElement(v);
+    }
+}
+
+inline void Mesh::RecordChange(Edge* e) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordChangedElement(e);
+    }
+}
+
+inline void Mesh::RecordChange(Face* f) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordChangedElement(f);
+    }
+}
+
+inline void Mesh::RecordChange(Loop* l) {
+    if(journal != nullptr || changes != nullptr) {
+        RecordChangedElement(l);
+    }
+}
+
 } // namespace Core
 } // namespace Aoba
 
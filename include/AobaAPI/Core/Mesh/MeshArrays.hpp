@@ -0,0 +1,41 @@
+#ifndef AOBA_CORE_MESH_MESH_ARRAYS_HPP
+#define AOBA_CORE_MESH_MESH_ARRAYS_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace Aoba {
+namespace Core {
+
+/// <summary>
+/// All elements of a mesh stored in flat arrays, including wire edges, the order of the disk and radial cycles, flags,
+/// normals and material indices. See <see cref="Mesh::ToArrays"/> and <see cref="Mesh::FromArrays"/>.
+/// Verts, edges and faces are numbered in list order. The loops of every face are numbered in a row, starting with
+/// the first loop of the face. Elements refer to each other by number, NO_INDEX stands for no element.
+/// </summary>
+class MeshArrays {
+  public:
+    static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+    std::vector<float> vertCo;         // coordinates of every vert, in x,y,z order
+    std::vector<float> vertNo;         // normal of every vert, in x,y,z order
+    std::vector<int32_t> vertFlags;    // flags of every vert
+    std::vector<uint32_t> vertEdge;    // first edge of the disk cycle of every vert, NO_INDEX for loose verts
+    std::vector<uint32_t> edgeVerts;   // v1 and v2 of every edge
+    std::vector<uint32_t> edgeDisk;    // next edge of the disk cycles around v1 and v2 of every edge
+    std::vector<uint32_t> edgeLoop;    // first loop of the radial cycle of every edge, NO_INDEX for wire edges
+    std::vector<int32_t> edgeFlags;    // flags of every edge
+    std::vector<uint32_t> faceLoops;   // first loop of every face, followed by the total number of loops
+    std::vector<float> faceNo;         // normal of every face, in x,y,z order
+    std::vector<int16_t> faceMaterial; // material index of every face
+    std::vector<int32_t> faceFlags;    // flags of every face
+    std::vector<uint32_t> loopVert;    // vert every loop starts at
+    std::vector<uint32_t> loopEdge;    // edge of every loop
+    std::vector<uint32_t> loopRadial;  // next loop of the radial cycle of every loop
+    std::vector<int32_t> loopFlags;    // flags of every loop
+};
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
@@ -0,0 +1,456 @@
+#ifndef AOBA_CORE_MESH_RANGE_HPP
+#define AOBA_CORE_MESH_RANGE_HPP
+
+#include <cstddef>
+#include <iterator>
+
+namespace Aoba {
+namespace Core {
+
+class Vert;
+class Edge;
+class Face;
+class Loop;
+class Mesh;
+
+/// <summary>
+/// Pair of iterators which can be used in range based for loops. Ranges walk the mesh structure directly, and do not
+/// allocate any memory. Do not modify the elements traversed by a range using EulerOps while iterating over it.
+/// </summary>
+template<typename Iterator>
+class Range {
+  private:
+    Iterator first; // first element of the range
+    Iterator last;  // one past the last element of the range
+  public:
+    Range(Iterator first, Iterator last);
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    /// <summary>
+    /// Check wether the range contains any elements.
+    /// </summary>
+    /// <returns>True if there are no elements in the range, otherwise false.</returns>
+    bool Empty() const;
+
+    /// <summary>
+    /// Count the elements in the range. Traverses the whole range.
+    /// </summary>
+    /// <returns>Number of elements in the range</returns>
+    std::size_t Size() const;
+
+    /// <summary>
+    /// Copy all elements of the range into the output, for example a std::back_inserter of a caller provided buffer.
+    /// </summary>
+    /// <param name="out">Output iterator</param>
+    /// <returns>Output iterator past the last copied element</returns>
+    template<typename OutputIterator>
+    OutputIterator CopyTo(OutputIterator out) const;
+};
+
+template<typename Iterator>
+Range<Iterator>::Range(Iterator first, Iterator last) : first(first), last(last) {}
+
+template<typename Iterator>
+Iterator Range<Iterator>::begin() const {
+    return first;
+}
+
+template<typename Iterator>
+Iterator Range<Iterator>::end() const {
+    return last;
+}
+
+template<typename Iterator>
+bool Range<Iterator>::Empty() const {
+    return first == last;
+}
+
+template<typename Iterator>
+std::size_t Range<Iterator>::Size() const {
+    std::size_t count = 0;
+    for(Iterator it = first; it != last; ++it) {
+        count++;
+    }
+    return count;
+}
+
+template<typename Iterator>
+template<typename OutputIterator>
+OutputIterator Range<Iterator>::CopyTo(OutputIterator out) const {
+    for(Iterator it = first; it != last; ++it) {
+        *out = *it;
+        ++out;
+    }
+    return out;
+}
+
+/// <summary>
+/// Iterates over the elements of another iterator which fulfill the criteria given by the predicate.
+/// The predicate is stored by value and called directly, so it can be inlined by the compiler.
+/// </summary>
+template<typename Iterator, typename Predicate>
+class FilterIterator {
+  private:
+    Iterator current; // current element of the underlying iterator
+    Iterator last;    // end of the underlying iterator
+    Predicate pred;   // filtering function
+
+    /// <summary>
+    /// Advance the underlying iterator until an element which fulfills the predicate is found.
+    /// </summary>
+    void Seek();
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename Iterator::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename Iterator::pointer pointer;
+    typedef typename Iterator::reference reference;
+
+    FilterIterator(Iterator current, Iterator last, Predicate pred);
+
+    value_type operator*() const;
+    FilterIterator& operator++();
+    FilterIterator operator++(int);
+    bool operator==(const FilterIterator& other) const;
+    bool operator!=(const FilterIterator& other) const;
+};
+
+template<typename Iterator, typename Predicate>
+FilterIterator<Iterator, Predicate>::FilterIterator(Iterator current, Iterator last, Predicate pred)
+    : current(current), last(last), pred(pred) {
+    Seek();
+}
+
+template<typename Iterator, typename Predicate>
+void FilterIterator<Iterator, Predicate>::Seek() {
+    while(current != last && !pred(*current)) {
+        ++current;
+    }
+}
+
+template<typename Iterator, typename Predicate>
+typename Iterator::value_type FilterIterator<Iterator, Predicate>::operator*() const {
+    return *current;
+}
+
+template<typename Iterator, typename Predicate>
+FilterIterator<Iterator, Predicate>& FilterIterator<Iterator, Predicate>::operator++() {
+    ++current;
+    Seek();
+    return *this;
+}
+
+template<typename Iterator, typename Predicate>
+FilterIterator<Iterator, Predicate> FilterIterator<Iterator, Predicate>::operator++(int) {
+    FilterIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+template<typename Iterator, typename Predicate>
+bool FilterIterator<Iterator, Predicate>::operator==(const FilterIterator& other) const {
+    return current == other.current;
+}
+
+template<typename Iterator, typename Predicate>
+bool FilterIterator<Iterator, Predicate>::operator!=(const FilterIterator& other) const {
+    return current != other.current;
+}
+
+/// <summary>
+/// Lazily filter a range. Elements are tested while iterating, no memory is allocated.
+/// </summary>
+/// <param name="range">Range to filter</param>
+/// <param name="pred">Filtering function, called with each element of the range</param>
+/// <returns>Range of elements which fulfill the criteria given by the filtering function</returns>
+template<typename Iterator, typename Predicate>
+Range<FilterIterator<Iterator, Predicate>> Filter(const Range<Iterator>& range, Predicate pred) {
+    FilterIterator<Iterator, Predicate> first = FilterIterator<Iterator, Predicate>(range.begin(), range.end(), pred);
+    FilterIterator<Iterator, Predicate> last = FilterIterator<Iterator, Predicate>(range.end(), range.end(), pred);
+    return Range<FilterIterator<Iterator, Predicate>>(first, last);
+}
+
+/// <summary>
+/// Iterates over all verts, edges or faces of a mesh, following the list of elements in the mesh.
+/// </summary>
+template<typename T>
+class MeshIterator {
+  private:
+    T* start;   // element where the traversal started
+    T* current; // current element, nullptr once all elements have been traversed
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* const* pointer;
+    typedef T* const& reference;
+
+    MeshIterator();
+    MeshIterator(T* start);
+
+    T* operator*() const;
+    MeshIterator& operator++();
+    MeshIterator operator++(int);
+    bool operator==(const MeshIterator& other) const;
+    bool operator!=(const MeshIterator& other) const;
+};
+
+template<typename T>
+MeshIterator<T>::MeshIterator() : start(nullptr), current(nullptr) {}
+
+template<typename T>
+MeshIterator<T>::MeshIterator(T* start) : start(start), current(start) {}
+
+template<typename T>
+T* MeshIterator<T>::operator*() const {
+    return current;
+}
+
+template<typename T>
+MeshIterator<T>& MeshIterator<T>::operator++() {
+    current = current->mNext;
+    if(current == start) {
+        current = nullptr; // back where we started, mesh list traversed
+    }
+    return *this;
+}
+
+template<typename T>
+MeshIterator<T> MeshIterator<T>::operator++(int) {
+    MeshIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+template<typename T>
+bool MeshIterator<T>::operator==(const MeshIterator& other) const {
+    return current == other.current;
+}
+
+template<typename T>
+bool MeshIterator<T>::operator!=(const MeshIterator& other) const {
+    return current != other.current;
+}
+
+/// <summary>
+/// Iterates over the edges around a vert, following the disk cycle.
+/// </summary>
+class VertEdgeIterator {
+  private:
+    const Vert* v; // vert whose edges are traversed
+    Edge* start;   // edge where the traversal started
+    Edge* current; // current edge, nullptr once all edges have been traversed
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Edge* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Edge* const* pointer;
+    typedef Edge* const& reference;
+
+    VertEdgeIterator();
+    VertEdgeIterator(const Vert* v, Edge* start);
+
+    Edge* operator*() const;
+    VertEdgeIterator& operator++();
+    VertEdgeIterator operator++(int);
+    bool operator==(const VertEdgeIterator& other) const;
+    bool operator!=(const VertEdgeIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the loops which start in a vert, following the disk cycle and the radial cycle of each edge.
+/// </summary>
+class VertLoopIterator {
+  private:
+    const Vert* v; // vert whose loops are traversed
+    Edge* start;   // edge where the traversal started
+    Edge* edge;    // edge currently being traversed, nullptr once all edges have been traversed
+    Loop* current; // current loop, nullptr once all loops have been traversed
+
+    /// <summary>
+    /// Advance until a loop starting in v is found, or until all edges have been traversed.
+    /// </summary>
+    void Seek();
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Loop* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Loop* const* pointer;
+    typedef Loop* const& reference;
+
+    VertLoopIterator();
+    VertLoopIterator(const Vert* v, Edge* start);
+
+    Loop* operator*() const;
+    VertLoopIterator& operator++();
+    VertLoopIterator operator++(int);
+    bool operator==(const VertLoopIterator& other) const;
+    bool operator!=(const VertLoopIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the faces around a vert. Each face is visited once for every loop of the face which starts in the
+/// vert, so faces which use the vert multiple times are visited multiple times.
+/// </summary>
+class VertFaceIterator {
+  private:
+    VertLoopIterator loops; // loops starting in the vert
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Face* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Face* const* pointer;
+    typedef Face* const& reference;
+
+    VertFaceIterator();
+    VertFaceIterator(const Vert* v, Edge* start);
+
+    Face* operator*() const;
+    VertFaceIterator& operator++();
+    VertFaceIterator operator++(int);
+    bool operator==(const VertFaceIterator& other) const;
+    bool operator!=(const VertFaceIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the loops which use an edge, following the radial cycle.
+/// </summary>
+class EdgeLoopIterator {
+  private:
+    Loop* start;   // loop where the traversal started
+    Loop* current; // current loop, nullptr once all loops have been traversed
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Loop* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Loop* const* pointer;
+    typedef Loop* const& reference;
+
+    EdgeLoopIterator();
+    EdgeLoopIterator(Loop* start);
+
+    Loop* operator*() const;
+    EdgeLoopIterator& operator++();
+    EdgeLoopIterator operator++(int);
+    bool operator==(const EdgeLoopIterator& other) const;
+    bool operator!=(const EdgeLoopIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the faces which use an edge. Each face is visited once for every loop using the edge, so faces which
+/// use the edge multiple times are visited multiple times.
+/// </summary>
+class EdgeFaceIterator {
+  private:
+    EdgeLoopIterator loops; // loops using the edge
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Face* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Face* const* pointer;
+    typedef Face* const& reference;
+
+    EdgeFaceIterator();
+    EdgeFaceIterator(Loop* start);
+
+    Face* operator*() const;
+    EdgeFaceIterator& operator++();
+    EdgeFaceIterator operator++(int);
+    bool operator==(const EdgeFaceIterator& other) const;
+    bool operator!=(const EdgeFaceIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the loops of a face, in order.
+/// </summary>
+class FaceLoopIterator {
+  private:
+    Loop* start;   // loop where the traversal started
+    Loop* current; // current loop, nullptr once all loops have been traversed
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Loop* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Loop* const* pointer;
+    typedef Loop* const& reference;
+
+    FaceLoopIterator();
+    FaceLoopIterator(Loop* start);
+
+    Loop* operator*() const;
+    FaceLoopIterator& operator++();
+    FaceLoopIterator operator++(int);
+    bool operator==(const FaceLoopIterator& other) const;
+    bool operator!=(const FaceLoopIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the edges of a face, in order. Edges used multiple times by the face are visited multiple times.
+/// </summary>
+class FaceEdgeIterator {
+  private:
+    FaceLoopIterator loops; // loops of the face
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Edge* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Edge* const* pointer;
+    typedef Edge* const& reference;
+
+    FaceEdgeIterator();
+    FaceEdgeIterator(Loop* start);
+
+    Edge* operator*() const;
+    FaceEdgeIterator& operator++();
+    FaceEdgeIterator operator++(int);
+    bool operator==(const FaceEdgeIterator& other) const;
+    bool operator!=(const FaceEdgeIterator& other) const;
+};
+
+/// <summary>
+/// Iterates over the verts of a face, in order. Verts used multiple times by the face are visited multiple times.
+/// </summary>
+class FaceVertIterator {
+  private:
+    FaceLoopIterator loops; // loops of the face
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Vert* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Vert* const* pointer;
+    typedef Vert* const& reference;
+
+    FaceVertIterator();
+    FaceVertIterator(Loop* start);
+
+    Vert* operator*() const;
+    FaceVertIterator& operator++();
+    FaceVertIterator operator++(int);
+    bool operator==(const FaceVertIterator& other) const;
+    bool operator!=(const FaceVertIterator& other) const;
+};
+
+typedef MeshIterator<Vert> MeshVertIterator;
+typedef MeshIterator<Edge> MeshEdgeIterator;
+typedef MeshIterator<Face> MeshFaceIterator;
+
+typedef Range<MeshVertIterator> MeshVertRange;
+typedef Range<MeshEdgeIterator> MeshEdgeRange;
+typedef Range<MeshFaceIterator> MeshFaceRange;
+typedef Range<VertEdgeIterator> VertEdgeRange;
+typedef Range<VertLoopIterator> VertLoopRange;
+typedef Range<VertFaceIterator> VertFaceRange;
+typedef Range<EdgeLoopIterator> EdgeLoopRange;
+typedef Range<EdgeFaceIterator> EdgeFaceRange;
+typedef Range<FaceLoopIterator> FaceLoopRange;
+typedef Range<FaceEdgeIterator> FaceEdgeRange;
+typedef Range<FaceVertIterator> FaceVertRange;
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
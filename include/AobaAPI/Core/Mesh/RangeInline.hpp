@@ -0,0 +1,276 @@
+#ifndef AOBA_CORE_MESH_RANGEINLINE_HPP
+#define AOBA_CORE_MESH_RANGEINLINE_HPP
+
+// definitions of the adjacency iterators declared in Range.hpp. they need the complete element types, so this header
+// is included at the end of every element header, and pulls in the others. defined inline, so that walking a disk or
+// loop cycle compiles down to the pointer chasing itself
+
+#include "Edge.hpp"
+#include "Face.hpp"
+#include "Loop.hpp"
+#include "Vert.hpp"
+
+namespace Aoba {
+namespace Core {
+
+inline VertEdgeIterator::VertEdgeIterator() : v(nullptr), start(nullptr), current(nullptr) {}
+
+inline VertEdgeIterator::VertEdgeIterator(const Vert* v, Edge* start) : v(v), start(start), current(start) {}
+
+inline Edge* VertEdgeIterator::operator*() const {
+    return current;
+}
+
+inline VertEdgeIterator& VertEdgeIterator::operator++() {
+    current = current->v1 == v ? current->v1Next : current->v2Next;
+    if(current == start) {
+        current = nullptr; // back where we started, disk cycle traversed
+    }
+    return *this;
+}
+
+inline VertEdgeIterator VertEdgeIterator::operator++(int) {
+    VertEdgeIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+inline bool VertEdgeIterator::operator==(const VertEdgeIterator& other) const {
+    return current == other.current;
+}
+
+inline bool VertEdgeIterator::operator!=(const VertEdgeIterator& other) const {
+    return current != other.current;
+}
+
+inline VertLoopIterator::VertLoopIterator() : v(nullptr), start(nullptr), edge(nullptr), current(nullptr) {}
+
+inline VertLoopIterator::VertLoopIterator(const Vert* v, Edge* start)
+    : v(v), start(start), edge(start), current(nullptr) {
+    if(edge != nullptr) {
+        current = edge->l;
+        Seek();
+    }
+}
+
+inline void VertLoopIterator::Seek() {
+    while(edge != nullptr) {
+        if(current != nullptr) {
+            if(current->v == v) {
+                return; // loop starting in v found
+            }
+            current = current->eNext;
+            if(current == edge->l) {
+                current = nullptr; // radial cycle traversed
+            }
+            continue;
+        }
+        // radial cycle traversed or wire edge, move on to the next edge
+        edge = edge->v1 == v ? edge->v1Next : edge->v2Next;
+        if(edge == start) {
+            edge = nullptr; // disk cycle traversed
+        } else {
+            current = edge->l;
+        }
+    }
+}
+
+inline Loop* VertLoopIterator::operator*() const {
+    return current;
+}
+
+inline VertLoopIterator& VertLoopIterator::operator++() {
+    current = current->eNext;
+    if(current == edge->l) {
+        current = nullptr;
+    }
+    Seek();
+    return *this;
+}
+
+inline VertLoopIterator VertLoopIterator::operator++(int) {
+    VertLoopIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+inline bool VertLoopIterator::operator==(const VertLoopIterator& other) const {
+    return current == other.current;
+}
+
+inline bool VertLoopIterator::operator!=(const VertLoopIterator& other) const {
+    return current != other.current;
+}
+
+inline VertFaceIterator::VertFaceIterator() : loops() {}
+
+inline VertFaceIterator::VertFaceIterator(const Vert* v, Edge* start) : loops(v, start) {}
+
+inline Face* VertFaceIterator::operator*() const {
+    return (*loops)->f;
+}
+
+inline VertFaceIterator& VertFaceIterator::operator++() {
+    ++loops;
+    return *this;
+}
+
+inline VertFaceIterator VertFaceIterator::operator++(int) {
+    VertFaceIterator result = *this;
+    ++loops;
+    return result;
+}
+
+inline bool VertFaceIterator::operator==(const VertFaceIterator& other) const {
+    return loops == other.loops;
+}
+
+inline bool VertFaceIterator::operator!=(const VertFaceIterator& other) const {
+    return loops != other.loops;
+}
+
+inline EdgeLoopIterator::EdgeLoopIterator() : start(nullptr), current(nullptr) {}
+
+inline EdgeLoopIterator::EdgeLoopIterator(Loop* start) : start(start), current(start) {}
+
+inline Loop* EdgeLoopIterator::operator*() const {
+    return current;
+}
+
+inline EdgeLoopIterator& EdgeLoopIterator::operator++() {
+    current = current->eNext;
+    if(current == start) {
+        current = nullptr;
+    }
+    return *this;
+}
+
+inline EdgeLoopIterator EdgeLoopIterator::operator++(int) {
+    EdgeLoopIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+inline bool EdgeLoopIterator::operator==(const EdgeLoopIterator& other) const {
+    return current == other.current;
+}
+
+inline bool EdgeLoopIterator::operator!=(const EdgeLoopIterator& other) const {
+    return current != other.current;
+}
+
+inline EdgeFaceIterator::EdgeFaceIterator() : loops() {}
+
+inline EdgeFaceIterator::EdgeFaceIterator(Loop* start) : loops(start) {}
+
+inline Face* EdgeFaceIterator::operator*() const {
+    return (*loops)->f;
+}
+
+inline EdgeFaceIterator& EdgeFaceIterator::operator++() {
+    ++loops;
+    return *this;
+}
+
+inline EdgeFaceIterator EdgeFaceIterator::operator++(int) {
+    EdgeFaceIterator result = *this;
+    ++loops;
+    return result;
+}
+
+inline bool EdgeFaceIterator::operator==(const EdgeFaceIterator& other) const {
+    return loops == other.loops;
+}
+
+inline bool EdgeFaceIterator::operator!=(const EdgeFaceIterator& other) const {
+    return loops != other.loops;
+}
+
+inline FaceLoopIterator::FaceLoopIterator() : start(nullptr), current(nullptr) {}
+
+inline FaceLoopIterator::FaceLoopIterator(Loop* start) : start(start), current(start) {}
+
+inline Loop* FaceLoopIterator::operator*() const {
+    return current;
+}
+
+inline FaceLoopIterator& FaceLoopIterator::operator++() {
+    current = current->fNext;
+    if(current == start) {
+        current = nullptr;
+    }
+    return *this;
+}
+
+inline FaceLoopIterator FaceLoopIterator::operator++(int) {
+    FaceLoopIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+inline bool FaceLoopIterator::operator==(const FaceLoopIterator& other) const {
+    return current == other.current;
+}
+
+inline bool FaceLoopIterator::operator!=(const FaceLoopIterator& other) const {
+    return current != other.current;
+}
+
+inline FaceEdgeIterator::FaceEdgeIterator() : loops() {}
+
+inline FaceEdgeIterator::FaceEdgeIterator(Loop* start) : loops(start) {}
+
+inline Edge* FaceEdgeIterator::operator*() const {
+    return (*loops)->e;
+}
+
+inline FaceEdgeIterator& FaceEdgeIterator::operator++() {
+    ++loops;
+    return *this;
+}
+
+inline FaceEdgeIterator FaceEdgeIterator::operator++(int) {
+    FaceEdgeIterator result = *this;
+    ++loops;
+    return result;
+}
+
+inline bool FaceEdgeIterator::operator==(const FaceEdgeIterator& other) const {
+    return loops == other.loops;
+}
+
+inline bool FaceEdgeIterator::operator!=(const FaceEdgeIterator& other) const {
+    return loops != other.loops;
+}
+
+inline FaceVertIterator::FaceVertIterator() : loops() {}
+
+inline FaceVertIterator::FaceVertIterator(Loop* start) : loops(start) {}
+
+inline Vert* FaceVertIterator::operator*() const {
+    return (*loops)->v;
+}
+
+inline FaceVertIterator& FaceVertIterator::operator++() {
+    ++loops;
+    return *this;
+}
+
+inline FaceVertIterator FaceVertIterator::operator++(int) {
+    FaceVertIterator result = *this;
+    ++loops;
+    return result;
+}
+
+inline bool FaceVertIterator::operator==(const FaceVertIterator& other) const {
+    return loops == other.loops;
+}
+
+inline bool FaceVertIterator::operator!=(const FaceVertIterator& other) const {
+    return loops != other.loops;
+}
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
@@ -3,10 +3,13 @@
 
 #include "../../Math/Vector/Vector3.hpp"
 #include "../EulerOps.hpp"
+#include "CoordArray.hpp"
+#include "Link.hpp"
+#include "Range.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
-#include <functional>
 
 namespace Aoba {
 namespace Core {
@@ -17,6 +20,14 @@ class Face;
 
 class Vert {
     friend class Mesh;
+    template<typename T>
+    friend class MeshIterator;
+    template<typename T>
+    friend class Link;
+    template<typename T>
+    friend class ElementPool;
+    template<typename T>
+    friend class JournalRecord;
 
     friend void EdgeSplit(Edge*, Vert*, Edge*, Vert*);
     friend void KillEdge(Edge*);
@@ -29,29 +40,90 @@ class Vert {
     friend void JoinMesh(Mesh*, Mesh*);
 
   public:
-    std::size_t index;   // index of this vert, not updated automatically, used for tools
+    uint32_t index;      // index of this vert, not updated automatically, used for tools
     int32_t flags;       // flags available for use in other tools
     int32_t flagsIntern; // flags for use in internal tools and operators
-    Math::Vec3 co;       // X,Y,Z vertex coordinates
-    Math::Vec3 no;       // X,Y,Z vertex normals
+    uint32_t visited;    // generation in which the element was last marked, see Mesh::NewGeneration
   private:
-    Edge* e;     // List of edges using this vert. Use e->v1/v2 Next/Prev for traversal.
-    Mesh* m;     // Pointer to parent mesh. Could potentialy be ommited but might pose a safety issue.
-    Vert* mNext; // list of all verts in the mesh
-    Vert* mPrev; // List of all verts in the mesh
-  public:
+    Link<Edge> e;     // List of edges using this vert. Use e->v1/v2 Next/Prev for traversal.
+    Link<Vert> mNext; // list of all verts in the mesh
+    Link<Vert> mPrev; // List of all verts in the mesh
+    uint32_t slot;    // slot number of this vert, see SlotDirectory
+
+    Math::Vec3 co; // X,Y,Z vertex coordinates, unused while the block of the vert has a chunk in the CoordArray
+    Math::Vec3 no; // X,Y,Z vertex normals, unused while the block of the vert has a chunk in the CoordArray
+
+    uint8_t classBits; // cached topology classification, zero while not classified, see Mesh::ClassifyAll
+
+    static const uint8_t CLASS_VALID = 1 << 0;    // classBits hold a valid classification
+    static const uint8_t CLASS_BOUNDARY = 1 << 1; // cached result of IsBoundary
+    static const uint8_t CLASS_MANIFOLD = 1 << 2; // cached result of IsManifold
+    static const uint8_t CLASS_WIRE = 1 << 3;     // cached result of IsWire
+
+    /// <summary>
+    /// Mesh which owns the storage of this vert.
+    /// </summary>
+    /// <returns>The parent mesh</returns>
+    Mesh* ParentMesh() const {
+        return SlotDirectory<Vert>::owners[slot >> SlotDirectory<Vert>::BITS];
+    }
+
+    /// <summary>
+    /// Constructor, leaves the vert without a slot. Verts are created by their ElementPool, see Mesh::NewVert.
+    /// </summary>
     Vert();
 
+  public:
+    /// <summary>
+    /// X,Y,Z vertex coordinates. Stored inside the vert, or inside the coordinate arrays of the mesh if they are
+    /// enabled, see <see cref="Mesh::EnableCoordArrays"/>. The reference is valid until the vert is killed, or the
+    /// storage mode of the mesh changes. Writes through the reference are not recorded, use
+    /// <see cref="Mesh::SetCo"/> to change the coordinates of an existing vert.
+    /// </summary>
+    /// <returns>Reference to the coordinates</returns>
+    Math::Vec3& Co() {
+        Math::Vec3* chunk = CoordArray::coChunks[slot >> SlotDirectory<Vert>::BITS];
+        return chunk != nullptr ? chunk[slot & SlotDirectory<Vert>::MASK] : co;
+    }
+
+    /// <summary>
+    /// X,Y,Z vertex coordinates, see <see cref="Co()"/>.
+    /// </summary>
+    /// <returns>Reference to the coordinates</returns>
+    const Math::Vec3& Co() const {
+        const Math::Vec3* chunk = CoordArray::coChunks[slot >> SlotDirectory<Vert>::BITS];
+        return chunk != nullptr ? chunk[slot & SlotDirectory<Vert>::MASK] : co;
+    }
+
+    /// <summary>
+    /// X,Y,Z vertex normal, stored next to the coordinates, see <see cref="Co()"/>.
+    /// </summary>
+    /// <returns>Reference to the normal</returns>
+    Math::Vec3& No() {
+        Math::Vec3* chunk = CoordArray::noChunks[slot >> SlotDirectory<Vert>::BITS];
+        return chunk != nullptr ? chunk[slot & SlotDirectory<Vert>::MASK] : no;
+    }
+
+    /// <summary>
+    /// X,Y,Z vertex normal, see <see cref="No()"/>.
+    /// </summary>
+    /// <returns>Reference to the normal</returns>
+    const Math::Vec3& No() const {
+        const Math::Vec3* chunk = CoordArray::noChunks[slot >> SlotDirectory<Vert>::BITS];
+        return chunk != nullptr ? chunk[slot & SlotDirectory<Vert>::MASK] : no;
+    }
+
     /// <summary>
     /// Check wether the vert is boundary. Vert is boundary if it is connected to a boundary edge.
     /// Isolated verts are not considered boundary verts.
+    /// Answered from the classification cache if the vert is classified, see <see cref="Mesh::ClassifyAll"/>.
     /// </summary>
     /// <returns>True if boundary vert, otherwise false.</returns>
     bool IsBoundary() const;
 
     /// <summary>
     /// Check wether the vert is manifold. Vert is not manifold if it belongs to multiple-face edges or wire edges,
-    /// borders non-adjecent faces or is an isolated vert.
+    /// borders non-adjecent faces or is an isolated vert. Cached like <see cref="IsBoundary"/>.
     /// </summary>
     /// <remarks>
     /// This is sasauge.
@@ -61,7 +133,7 @@ class Vert {
 
     /// <summary>
     /// Check wether the vert is wire. Vert is wire if it is adjecent to a wire edge.
-    /// Isolated verts are not considered wire verts.
+    /// Isolated verts are not considered wire verts. Cached like <see cref="IsBoundary"/>.
     /// </summary>
     /// <returns>True if vert is wire, otherwise false.</returns>
     bool IsWire() const;
@@ -89,14 +161,16 @@ class Vert {
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered edges</returns>
-    const std::vector<Edge*> Edges(std::function<bool(const Edge* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Edge*> Edges(Predicate func) const;
 
     /// <summary>
     /// List of faces which are adjacent to this vert and fulfill the criteria given by the filtering function.
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered faces</returns>
-    const std::vector<Face*> Faces(std::function<bool(const Face* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Face*> Faces(Predicate func) const;
 
     
     /// <summary>
@@ -104,10 +178,106 @@ class Vert {
     /// </summary>
     /// <param name="func">Filtering function</param>
     /// <returns>Filtered loops</returns>
-    const std::vector<Loop*> Loops(std::function<bool(const Loop* const)> func) const;
+    template<typename Predicate>
+    const std::vector<Loop*> Loops(Predicate func) const;
 
+    /// <summary>
+    /// Range of all edges that use this vert, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of edges using this vert.</returns>
+    VertEdgeRange EdgeRange() const;
+
+    /// <summary>
+    /// Range of all faces that use this vert, traversed without allocating memory.
+    /// Unlike Faces(), a face is visited once for every loop of the face which starts in this vert.
+    /// </summary>
+    /// <returns>Range of faces using this vert.</returns>
+    VertFaceRange FaceRange() const;
+
+    /// <summary>
+    /// Range of all loops which start in this vert, traversed without allocating memory.
+    /// </summary>
+    /// <returns>Range of loops using this vert.</returns>
+    VertLoopRange LoopRange() const;
+
+    /// <summary>
+    /// Lazy range of edges adjacent to this vert which fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of edges</returns>
+    template<typename Predicate>
+    Range<FilterIterator<VertEdgeIterator, Predicate>> EdgesWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of faces adjacent to this vert which fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of faces</returns>
+    template<typename Predicate>
+    Range<FilterIterator<VertFaceIterator, Predicate>> FacesWhere(Predicate pred) const;
+
+    /// <summary>
+    /// Lazy range of loops adjacent to this vert which fulfill the criteria given by the filtering function.
+    /// Elements are tested while iterating, without allocating memory.
+    /// </summary>
+    /// <param name="pred">Filtering function</param>
+    /// <returns>Filtered range of loops</returns>
+    template<typename Predicate>
+    Range<FilterIterator<VertLoopIterator, Predicate>> LoopsWhere(Predicate pred) const;
 };
+template<typename Predicate>
+const std::vector<Edge*> Vert::Edges(Predicate func) const {
+    std::vector<Edge*> result = std::vector<Edge*>();
+    for(Edge* edge : EdgeRange()) {
+        if(func(edge)) {
+            result.push_back(edge);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<VertEdgeIterator, Predicate>> Vert::EdgesWhere(Predicate pred) const {
+    return Filter(EdgeRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Face*> Vert::Faces(Predicate func) const {
+    std::vector<Face*> result = std::vector<Face*>();
+    for(Face* face : FaceRange()) {
+        if(func(face) && std::find(result.begin(), result.end(), face) == result.end()) {
+            result.push_back(face);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<VertFaceIterator, Predicate>> Vert::FacesWhere(Predicate pred) const {
+    return Filter(FaceRange(), pred);
+}
+
+template<typename Predicate>
+const std::vector<Loop*> Vert::Loops(Predicate func) const {
+    std::vector<Loop*> result = std::vector<Loop*>();
+    for(Loop* loop : LoopRange()) {
+        if(func(loop)) {
+            result.push_back(loop);
+        }
+    }
+    return result;
+}
+
+template<typename Predicate>
+Range<FilterIterator<VertLoopIterator, Predicate>> Vert::LoopsWhere(Predicate pred) const {
+    return Filter(LoopRange(), pred);
+}
+
 } // namespace Core
 } // namespace Aoba
 
-#endif
\ No newline at end of file
+#include "RangeInline.hpp"
+
+#endif
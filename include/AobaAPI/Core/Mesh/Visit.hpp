@@ -0,0 +1,65 @@
+#ifndef AOBA_CORE_MESH_VISIT_HPP
+#define AOBA_CORE_MESH_VISIT_HPP
+
+#include <cstdint>
+
+namespace Aoba {
+namespace Core {
+
+/// <summary>
+/// Set a flag on the element for the given generation. Flags in flagsIntern are only valid while the element is
+/// stamped with the generation which set them, flags of older generations are discarded on the first write.
+/// Use <see cref="Mesh::NewGeneration"/> to obtain a generation, flags never have to be cleared afterwards.
+/// Every element holds a single stamp, so generations must not nest: marking an element for a newer generation
+/// discards its marks of all older generations. An operator must not call another operator which marks elements
+/// while it still relies on its own marks.
+/// </summary>
+/// <param name="element">Vert, Edge, Face or Loop to mark</param>
+/// <param name="generation">Generation of the operator</param>
+/// <param name="flag">Flag bits to set</param>
+template<typename T>
+void SetMark(T* element, uint32_t generation, int32_t flag) {
+    if(element->visited != generation) {
+        element->visited = generation;
+        element->flagsIntern = 0;
+    }
+    element->flagsIntern |= flag;
+}
+
+/// <summary>
+/// Check whether the element has a flag set during the given generation, see <see cref="SetMark"/>.
+/// </summary>
+/// <param name="element">Vert, Edge, Face or Loop to check</param>
+/// <param name="generation">Generation of the operator</param>
+/// <param name="flag">Flag bits to check</param>
+/// <returns>True if any of the flag bits were set during the generation, otherwise false.</returns>
+template<typename T>
+bool HasMark(const T* element, uint32_t generation, int32_t flag) {
+    return element->visited == generation && (element->flagsIntern & flag) != 0;
+}
+
+/// <summary>
+/// Mark the element as visited during the given generation, without setting a flag, see <see cref="SetMark"/>.
+/// </summary>
+/// <param name="element">Vert, Edge, Face or Loop to mark</param>
+/// <param name="generation">Generation of the operator</param>
+template<typename T>
+void Mark(T* element, uint32_t generation) {
+    SetMark(element, generation, 0);
+}
+
+/// <summary>
+/// Check whether the element was marked during the given generation, with or without flags, see <see cref="Mark"/>.
+/// </summary>
+/// <param name="element">Vert, Edge, Face or Loop to check</param>
+/// <param name="generation">Generation of the operator</param>
+/// <returns>True if the element was marked during the generation, otherwise false.</returns>
+template<typename T>
+bool IsMarked(const T* element, uint32_t generation) {
+    return element->visited == generation;
+}
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
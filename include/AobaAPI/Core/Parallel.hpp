@@ -0,0 +1,66 @@
+#ifndef AOBA_CORE_PARALLEL_HPP
+#define AOBA_CORE_PARALLEL_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Aoba {
+namespace Core {
+
+/// <summary>
+/// Split the range [0, count) into contiguous chunks and process them on at most threadCount threads, using
+/// func(begin, end). The calling thread processes the first chunk. Ranges smaller than two grains are processed on the
+/// calling thread only. func must not throw, and must not modify data used by other chunks.
+/// </summary>
+/// <param name="count">Number of items to process</param>
+/// <param name="grainSize">Minimal number of items processed by a single thread</param>
+/// <param name="threadCount">Maximal number of threads including the calling thread, 0 for one per core</param>
+/// <param name="func">Function called with the bounds of each chunk</param>
+template<typename Func>
+void ParallelFor(std::size_t count, std::size_t grainSize, std::size_t threadCount, Func func) {
+    if(threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if(grainSize == 0) {
+        grainSize = 1;
+    }
+    if(threadCount > count / grainSize) {
+        threadCount = count / grainSize;
+    }
+    if(threadCount <= 1) {
+        if(count > 0) {
+            func(std::size_t(0), count);
+        }
+        return;
+    }
+
+    std::size_t chunkSize = (count + threadCount - 1) / threadCount;
+    std::vector<std::thread> workers = std::vector<std::thread>();
+    workers.reserve(threadCount - 1);
+    for(std::size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        std::size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        workers.push_back(std::thread(func, begin, end));
+    }
+    func(std::size_t(0), chunkSize);
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/// <summary>
+/// Split the range [0, count) into contiguous chunks and process them using one thread per core, see
+/// <see cref="ParallelFor(std::size_t, std::size_t, std::size_t, Func)"/>.
+/// </summary>
+/// <param name="count">Number of items to process</param>
+/// <param name="grainSize">Minimal number of items processed by a single thread</param>
+/// <param name="func">Function called with the bounds of each chunk</param>
+template<typename Func>
+void ParallelFor(std::size_t count, std::size_t grainSize, Func func) {
+    ParallelFor(count, grainSize, 0, func);
+}
+
+} // namespace Core
+} // namespace Aoba
+
+#endif
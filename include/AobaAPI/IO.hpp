@@ -1,8 +1,12 @@
 #ifndef AOBA_IO_HPP
 #define AOBA_IO_HPP
 
+#include "IO/AobaFile.hpp"
 #include "IO/ExportObj.hpp"
 #include "IO/ExportStl.hpp"
+#include "IO/ImportObj.hpp"
+#include "IO/ImportStl.hpp"
 #include "IO/IndexMesh.hpp"
+#include "IO/Text.hpp"
 
 #endif
\ No newline at end of file
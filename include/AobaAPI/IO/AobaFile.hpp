@@ -0,0 +1,80 @@
+#ifndef AOBA_IO_AOBA_FILE_HPP
+#define AOBA_IO_AOBA_FILE_HPP
+
+#include "../Core.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Aoba {
+namespace IO {
+
+/// <summary>
+/// Save the given mesh into a binary aoba file stored at the given path, see
+/// <see cref="SaveAoba(std::vector<char>&, Core::Mesh*)"/>.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh to save</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the file can not be written, or the mesh has too many elements to be numbered using 32 bits.
+/// </exception>
+void SaveAoba(std::string path, Core::Mesh* mesh);
+
+/// <summary>
+/// Save the given mesh into binary aoba data in memory. The file stores the arrays of
+/// <see cref="Core::MeshArrays"/>, so that the exact structure of the mesh is restored when loading, including wire
+/// edges, the order of the disk and radial cycles, flags, normals and material indices.
+/// The file starts with a versioned header and a table of sections, followed by one section per array. Sections start
+/// at multiples of 64 bytes, numbers are stored in the byte order of the machine which saved the file.
+/// Overwrites the index of all elements.
+/// </summary>
+/// <param name="buffer">Replaced with the contents of the aoba file</param>
+/// <param name="mesh">Mesh to save</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the mesh has too many elements to be numbered using 32 bits.
+/// </exception>
+void SaveAoba(std::vector<char>& buffer, Core::Mesh* mesh);
+
+/// <summary>
+/// Load a binary aoba file stored at the given path into the given mesh, see
+/// <see cref="LoadAoba(const std::vector<char>&, Core::Mesh*, std::size_t)"/>.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh which receives the elements of the file</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the file can not be read or is malformed, the mesh is left untouched in that case.
+/// </exception>
+void LoadAoba(std::string path, Core::Mesh* mesh);
+
+/// <summary>
+/// Load a binary aoba file stored at the given path into the given mesh, see
+/// <see cref="LoadAoba(const std::vector<char>&, Core::Mesh*, std::size_t)"/>. Every section is read straight into
+/// its array.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh which receives the elements of the file</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the file can not be read or is malformed, the mesh is left untouched in that case.
+/// </exception>
+void LoadAoba(std::string path, Core::Mesh* mesh, std::size_t threadCount);
+
+/// <summary>
+/// Load the contents of a binary aoba file into the given mesh, see
+/// <see cref="SaveAoba(std::vector<char>&, Core::Mesh*)"/>. The sections are copied into arrays without parsing,
+/// the elements are then added to the mesh using <see cref="Core::Mesh::FromArrays"/>. Sections which are unknown to
+/// this version are skipped.
+/// </summary>
+/// <param name="buffer">Contents of the aoba file</param>
+/// <param name="mesh">Mesh which receives the elements of the file</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the contents are malformed, were saved using a newer version or a different byte order. The mesh is
+/// left untouched in that case.
+/// </exception>
+void LoadAoba(const std::vector<char>& buffer, Core::Mesh* mesh, std::size_t threadCount);
+
+} // namespace IO
+} // namespace Aoba
+
+#endif
@@ -18,6 +18,17 @@ namespace IO {
 /// <param name="mesh">Mesh to export</param>
 void ExportObj(std::string path, Core::Mesh* mesh);
 
+/// <summary>
+/// Export the given mesh into a text-based obj file stored at the given path, see
+/// <see cref="ExportObj(std::string, Core::Mesh*)"/>. Verts, faces and edges are formatted in chunks on multiple
+/// threads and written in order, so the file does not depend on the number of threads. Coordinates are written with
+/// the fewest digits which read back as the same float. The mesh is only read.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh to export</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+void ExportObj(std::string path, Core::Mesh* mesh, std::size_t threadCount);
+
 } // namespace IO
 } // namespace Aoba
 
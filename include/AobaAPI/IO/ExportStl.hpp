@@ -4,6 +4,7 @@
 #include "../Core.hpp"
 
 #include <string>
+#include <vector>
 
 namespace Aoba {
 namespace IO {
@@ -18,6 +19,25 @@ namespace IO {
 /// <param name="mesh">Mesh to export</param>
 void ExportStl(std::string path, Core::Mesh* mesh);
 
+/// <summary>
+/// Export the given mesh into a binary stl file stored at the given path, see
+/// <see cref="ExportStl(std::vector<char>&, Core::Mesh*, std::size_t)"/>. The file is written at once.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh to export</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+void ExportStl(std::string path, Core::Mesh* mesh, std::size_t threadCount);
+
+/// <summary>
+/// Export the given mesh into binary stl data in memory. Faces are triangulated into fans, every triangle gets its own
+/// normal. Faces are split across multiple threads, each fills the triangles of its faces at their final position, so
+/// the data does not depend on the number of threads. The mesh is only read.
+/// </summary>
+/// <param name="buffer">Replaced with the contents of the stl file</param>
+/// <param name="mesh">Mesh to export</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+void ExportStl(std::vector<char>& buffer, Core::Mesh* mesh, std::size_t threadCount);
+
 } // namespace IO
 } // namespace Aoba
 
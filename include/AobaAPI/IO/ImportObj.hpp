@@ -0,0 +1,51 @@
+#ifndef AOBA_IO_IMPORT_OBJ_HPP
+#define AOBA_IO_IMPORT_OBJ_HPP
+
+#include "../Core.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Aoba {
+namespace IO {
+
+/// <summary>
+/// Import a text-based obj file stored at the given path into the given mesh, see
+/// <see cref="ImportObj(const std::vector<char>&, Core::Mesh*, std::size_t)"/>.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh which receives the verts, edges and faces of the file</param>
+void ImportObj(std::string path, Core::Mesh* mesh);
+
+/// <summary>
+/// Import a text-based obj file stored at the given path into the given mesh, see
+/// <see cref="ImportObj(const std::vector<char>&, Core::Mesh*, std::size_t)"/>. The file is read at once.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh which receives the verts, edges and faces of the file</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the file can not be read or is malformed, the mesh is left untouched in that case.
+/// </exception>
+void ImportObj(std::string path, Core::Mesh* mesh, std::size_t threadCount);
+
+/// <summary>
+/// Import the contents of a text-based obj file into the given mesh. Verts (v), faces (f) and wire edges (l) are read,
+/// including negative indices and faces with any number of verts. Everything else, like texture coordinates, normals
+/// and groups, is ignored, as well as comments starting with '#' on any line. Faces which repeat the verts of an
+/// earlier face in the same cyclic order, in either orientation, are skipped, since they would be double faces.
+/// The text is split at line boundaries and parsed on multiple threads, the elements are then added to the mesh in
+/// file order using <see cref="Core::Mesh::FromIndexed"/>.
+/// </summary>
+/// <param name="buffer">Contents of the obj file</param>
+/// <param name="mesh">Mesh which receives the verts, edges and faces of the file</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the contents are malformed, the mesh is left untouched in that case.
+/// </exception>
+void ImportObj(const std::vector<char>& buffer, Core::Mesh* mesh, std::size_t threadCount);
+
+} // namespace IO
+} // namespace Aoba
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef AOBA_IO_IMPORT_STL_HPP
+#define AOBA_IO_IMPORT_STL_HPP
+
+#include "../Core.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Aoba {
+namespace IO {
+
+class ImportStlResult {
+  public:
+    std::size_t triangles;  // triangles found in the file
+    std::size_t degenerate; // triangles dropped, because at least two of their corners were welded together
+    std::size_t duplicate;  // triangles dropped, because they use the same three verts as an earlier triangle
+    std::size_t verts;      // verts added to the mesh
+};
+
+/// <summary>
+/// Import a binary or ascii stl file stored at the given path into the given mesh, welding only corners with exactly
+/// the same coordinates, see <see cref="ImportStl(const std::vector<char>&, Core::Mesh*, float, std::size_t)"/>.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh which receives the verts, edges and faces of the file</param>
+/// <returns>Number of triangles read and dropped</returns>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the file can not be read or is malformed, the mesh is left untouched in that case.
+/// </exception>
+const ImportStlResult ImportStl(std::string path, Core::Mesh* mesh);
+
+/// <summary>
+/// Import a binary or ascii stl file stored at the given path into the given mesh, see
+/// <see cref="ImportStl(const std::vector<char>&, Core::Mesh*, float, std::size_t)"/>. The file is read at once.
+/// </summary>
+/// <param name="path">File path</param>
+/// <param name="mesh">Mesh which receives the verts, edges and faces of the file</param>
+/// <param name="epsilon">Distance up to which corners are welded</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+/// <returns>Number of triangles read and dropped</returns>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the file can not be read or is malformed, the mesh is left untouched in that case.
+/// </exception>
+const ImportStlResult ImportStl(std::string path, Core::Mesh* mesh, float epsilon, std::size_t threadCount);
+
+/// <summary>
+/// Import the contents of a binary or ascii stl file into the given mesh. Stl files store every triangle with its own
+/// corners, corners are welded into shared verts to connect the triangles: corners with the same coordinates, and
+/// corners which are connected through a chain of corners closer than epsilon to each other, share a vert placed at
+/// the first of these corners. Triangles with two corners on the same vert are dropped, as well as triangles which use
+/// the same three verts as an earlier triangle, since they would be double faces. Verts are only created for the
+/// remaining triangles. The stored normals are ignored.
+/// Corners are parsed and looked up in a spatial hash on multiple threads, the result does not depend on the number
+/// of threads. The verts and faces are added to the mesh in file order using
+/// <see cref="Core::Mesh::FromIndexed"/>.
+/// </summary>
+/// <param name="buffer">Contents of the stl file</param>
+/// <param name="mesh">Mesh which receives the verts, edges and faces of the file</param>
+/// <param name="epsilon">Distance up to which corners are welded, 0 to weld corners with the same coordinates</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+/// <returns>Number of triangles read and dropped</returns>
+/// <exception cref="std::invalid_argument">
+/// Thrown if the contents are malformed or epsilon is negative, the mesh is left untouched in that case.
+/// </exception>
+const ImportStlResult ImportStl(const std::vector<char>& buffer, Core::Mesh* mesh, float epsilon,
+    std::size_t threadCount);
+
+} // namespace IO
+} // namespace Aoba
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "../Core.hpp"
 
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
 namespace Aoba {
 namespace IO {
 
@@ -12,11 +16,72 @@ class IndexMesh {
     std::vector<std::size_t> edges;     // packed edge vertex indices, in v1,v2 order
     std::vector<std::size_t> triangles; // indices of triangle coordinates, v1,v2,v3 order
 
+  private:
+    const Core::Mesh* tracked; // mesh the arrays were last built from by Update, or nullptr
+
+    std::unordered_map<const Core::Vert*, std::size_t> vertSlots; // position of every vert in vertexCoords / 3
+    std::vector<std::size_t> freeVertSlots;                       // slots of killed verts, reused by new verts
+    std::unordered_map<const Core::Edge*, std::size_t> edgeSlots; // position of every edge in edges / 2
+    std::vector<const Core::Edge*> edgeOwners;                    // edge stored in every slot of edges
+    std::unordered_map<const Core::Face*, std::vector<std::size_t>> faceTriangles; // triangles of every face
+    std::vector<const Core::Face*> triangleOwners;                // face every triangle of triangles belongs to
+
+    /// <summary>
+    /// Rebuild all arrays and the element slots from the mesh, in the order of its element lists.
+    /// </summary>
+    void Rebuild(Core::Mesh* m);
+
+    /// <summary>
+    /// Give a vert a slot and write its coordinates.
+    /// </summary>
+    void AddVert(const Core::Vert* v);
+
+    /// <summary>
+    /// Append an edge, or rewrite it if it already has a slot.
+    /// </summary>
+    void WriteEdge(const Core::Edge* e);
+
+    /// <summary>
+    /// Remove an edge, the last edge is moved into its slot.
+    /// </summary>
+    void RemoveEdge(const Core::Edge* e);
+
+    /// <summary>
+    /// Triangulate a face, reusing its triangle slots as far as possible.
+    /// </summary>
+    void WriteFace(const Core::Face* f);
+
+    /// <summary>
+    /// Remove a face, the last triangles are moved into its triangle slots.
+    /// </summary>
+    void RemoveFace(const Core::Face* f);
+
+    /// <summary>
+    /// Remove the triangle in the given slot, the last triangle is moved into it.
+    /// </summary>
+    void RemoveTriangle(std::size_t slot);
+
+  public:
+    IndexMesh();
+
     /// <summary>
     /// populate the data of this index mesh from mesh.
     /// </summary>
     /// <param name="m">Mesh to convert to index-based representation</param>
     void FromMesh(Core::Mesh* m);
+
+    /// <summary>
+    /// Bring the data of this index mesh up to date with the mesh, using the changes tracked by the mesh, see
+    /// <see cref="Core::Mesh::EnableChangeTracking"/>. The first call enables change tracking and builds all arrays,
+    /// later calls only patch the coordinates of modified verts and splice the edges and triangles of created,
+    /// killed and modified elements. The changes of the mesh are reset, so the mesh must not have other consumers of
+    /// its changes. Does not write Vert::index.
+    /// Verts keep their index until they are killed, slots of killed verts stay in vertexCoords and are reused by new
+    /// verts. Removed edges and triangles are replaced by the last ones, so their order is not kept. The arrays are
+    /// rebuilt if the mesh was cleared, compacted or reordered, or if a different mesh is passed.
+    /// </summary>
+    /// <param name="m">Mesh to convert to index-based representation</param>
+    void Update(Core::Mesh* m);
 };
 
 } // namespace IO
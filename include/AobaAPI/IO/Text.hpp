@@ -0,0 +1,51 @@
+#ifndef AOBA_IO_TEXT_HPP
+#define AOBA_IO_TEXT_HPP
+
+#include <cstddef>
+
+namespace Aoba {
+namespace IO {
+
+/// <summary>
+/// Number of characters FormatFloat writes at most.
+/// </summary>
+const std::size_t FORMAT_FLOAT_MAX = 16;
+
+/// <summary>
+/// Number of characters FormatIndex writes at most.
+/// </summary>
+const std::size_t FORMAT_INDEX_MAX = 20;
+
+/// <summary>
+/// Write the shortest decimal representation of a float which reads back as the same float. Numbers from 1e-5 up to
+/// 1e9 are written without exponent, others in the form 1.5e-07. Infinities are written as inf and -inf, NaN as nan.
+/// No terminating null character is written.
+/// </summary>
+/// <param name="value">Number to format</param>
+/// <param name="buffer">Buffer with room for at least FORMAT_FLOAT_MAX characters</param>
+/// <returns>Number of characters written</returns>
+std::size_t FormatFloat(float value, char* buffer);
+
+/// <summary>
+/// Write an unsigned integer in decimal. No terminating null character is written.
+/// </summary>
+/// <param name="value">Number to format</param>
+/// <param name="buffer">Buffer with room for at least FORMAT_INDEX_MAX characters</param>
+/// <returns>Number of characters written</returns>
+std::size_t FormatIndex(std::size_t value, char* buffer);
+
+/// <summary>
+/// Read a decimal floating point number, rounded to the nearest float like strtof. Accepts an optional sign, digits
+/// with an optional decimal point and an optional exponent, as well as inf, infinity and nan. Leading whitespace is
+/// not skipped. Common numbers are converted without calling strtof.
+/// </summary>
+/// <param name="text">Characters to read, no terminating null character is required</param>
+/// <param name="length">Number of characters available</param>
+/// <param name="value">Receives the number</param>
+/// <returns>Number of characters read, 0 if the text does not start with a number</returns>
+std::size_t ParseFloat(const char* text, std::size_t length, float& value);
+
+} // namespace IO
+} // namespace Aoba
+
+#endif
@@ -11,6 +11,13 @@ namespace Ops {
 
 enum class DeleteMode { All, FacesOnly, FacesAndEdges };
 
+/// <summary>
+/// Weight of each face in the normal of a vert, see <see cref="RecalculateVertNormals"/>.
+/// Uniform weighs all faces equally, Area by the area of the face, Angle by the angle of the face corner in the vert.
+/// AreaAndAngle multiplies both.
+/// </summary>
+enum class VertNormalWeighting { Uniform, Area, Angle, AreaAndAngle };
+
 /// <summary>
 /// Deletes the given mesh elements according to the specified delete mode.
 /// </summary>
@@ -168,6 +175,19 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
 /// <param name="faces">Faces to operate on</param>
 void RecalculateFaceNormals(Core::Mesh* m, const std::vector<Core::Face*>& faces);
 
+/// <summary>
+/// Recalculate vert normals for given verts, as the weighted sum of the normals of the faces using them. Normals of
+/// the faces using the verts are recalculated first. The work is split across multiple threads, every vert sums up
+/// its faces in the same order on any number of threads, so the result does not depend on the thread count.
+/// Verts without faces get a zero normal.
+/// </summary>
+/// <param name="m">Mesh on which to operate on</param>
+/// <param name="verts">Verts to operate on</param>
+/// <param name="weighting">Weight of each face in the normal of a vert</param>
+/// <param name="threadCount">Maximal number of threads to use, 0 to use one thread per core</param>
+void RecalculateVertNormals(Core::Mesh* m, const std::vector<Core::Vert*>& verts, VertNormalWeighting weighting,
+    std::size_t threadCount);
+
 /// <summary>
 /// Reverse ordering of the face loop, flipping its orientation
 /// </summary>
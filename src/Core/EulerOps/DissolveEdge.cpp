@@ -10,7 +10,7 @@ void DissolveEdge(Edge* e, Face* fSurvivor) {
     // check if the edge is dissolvable
     // edge is not dissolvable if
     // 1. it is not manifold
-    if(e->Loops().size() != 2 || !(e->IsManifold())) {
+    if(e->LoopRange().Size() != 2 || !(e->IsManifold())) {
         throw std::invalid_argument("Edge must have two adjecent faces and must be manifold.");
     }
     // get the ohter face and loops around this edge
@@ -40,6 +40,20 @@ void DissolveEdge(Edge* e, Face* fSurvivor) {
         faceLoop = faceLoop->fNext;
     } while(faceLoop != survLoop);
 
+    // record everything which is about to change, see Mesh::EnableJournal
+    Mesh* m = e->ParentMesh();
+    m->RecordChange(e);
+    m->RecordChange(fSurvivor);
+    m->RecordChange(other);
+    m->RecordChange(other->mNext);
+    m->RecordChange(other->mPrev);
+    for(Loop* loop : fSurvivor->LoopRange()) {
+        m->RecordChange(loop);
+    }
+    for(Loop* loop : other->LoopRange()) {
+        m->RecordChange(loop);
+    }
+
     // replace fnext/fprev pointers inside both loops
     Loop* otherNext = otherLoop->fNext;
     Loop* otherPrev = otherLoop->fPrev;
@@ -64,16 +78,17 @@ void DissolveEdge(Edge* e, Face* fSurvivor) {
     e->l = nullptr;
     KillEdge(e);
     // delete unused face loops.
-    delete otherLoop;
-    delete survLoop;
+    m->Dispose(otherLoop);
+    m->Dispose(survLoop);
 
     // delete the other face
     other->mPrev->mNext = other->mNext;
     other->mNext->mPrev = other->mPrev;
-    if(other->m->faces == other) {
-        other->m->faces = other->mNext;
+    if(m->faces == other) {
+        m->faces = other->mNext;
     }
-    delete other;
+    m->faceCount--;
+    m->Dispose(other);
 
     return;
 }
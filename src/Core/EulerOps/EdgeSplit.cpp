@@ -5,8 +5,35 @@ namespace Aoba {
 namespace Core {
 
 void EdgeSplit(Edge* e, Vert* v, Edge* newe, Vert* newv) {
-    newe->m = e->m;
-    newv->m = e->m; // v can be nullptr
+    Mesh* m = e->ParentMesh();
+
+    // record everything which is about to change, see Mesh::EnableJournal
+    m->RecordCreated(newe);
+    m->RecordCreated(newv);
+    m->RecordChange(e);
+    m->RecordChange(e->v1);
+    m->RecordChange(e->v2);
+    m->RecordChange(e->v1Next);
+    m->RecordChange(e->v1Prev);
+    m->RecordChange(e->v2Next);
+    m->RecordChange(e->v2Prev);
+    m->RecordChange(m->edges);
+    m->RecordChange(m->edges->mPrev);
+    m->RecordChange(m->verts);
+    m->RecordChange(m->verts->mPrev);
+    if(e->l != nullptr) {
+        Loop* current = e->l;
+        do {
+            m->RecordChange(current);
+            m->RecordChange(current->fNext);
+            m->RecordChange(current->fPrev);
+            current = current->eNext;
+        } while(current != e->l);
+    }
+
+    // the verts of e change, it is indexed again once the split is done
+    m->UnindexEdge(e);
+    m->Unclassify(e);
     // add the new edge between the appropriate verts
     // if v is not specified, add the new edge around v1.
 
@@ -52,10 +79,10 @@ void EdgeSplit(Edge* e, Vert* v, Edge* newe, Vert* newv) {
             Loop* current = e->l;
             std::vector<Loop*> newLoops = std::vector<Loop*>();
             do {
-                Loop* newl = new Loop();
+                Loop* newl = m->NewLoop();
+                m->RecordCreated(newl);
                 newl->f = current->f;
                 newl->e = newe;
-                newl->m = e->m;
                 if(current->v == e->v1) {
                     // change loop vert
                     current->v = newv;
@@ -133,10 +160,10 @@ void EdgeSplit(Edge* e, Vert* v, Edge* newe, Vert* newv) {
             Loop* current = e->l;
             std::vector<Loop*> newLoops = std::vector<Loop*>();
             do {
-                Loop* newl = new Loop();
+                Loop* newl = m->NewLoop();
+                m->RecordCreated(newl);
                 newl->f = current->f;
                 newl->e = newe;
-                newl->m = e->m;
                 if(current->v == e->v2) {
                     // change loop vert
                     current->v = newv;
@@ -174,18 +201,25 @@ void EdgeSplit(Edge* e, Vert* v, Edge* newe, Vert* newv) {
     }
 
     // add newe, newv to mesh...
-    Mesh* m = e->m;
     m->edges->mPrev->mNext = newe;
     newe->mPrev = m->edges->mPrev;
     m->edges->mPrev = newe;
     newe->mNext = m->edges;
     m->edges = newe;
+    m->edgeCount++;
 
     m->verts->mPrev->mNext = newv;
     newv->mPrev = m->verts->mPrev;
     m->verts->mPrev = newv;
     newv->mNext = m->verts;
     m->verts = newv;
+    m->vertCount++;
+
+    m->IndexEdge(e);
+    m->IndexEdge(newe);
+    // newv only uses e and newe, the verts of e changed
+    m->Unclassify(e);
+    m->Unclassify(newe);
 }
 
 } // namespace Core
@@ -20,17 +20,15 @@ void GlueFace(Face* f1, Edge* e1, Face* f2, Edge* e2) {
     // verify that inputs are ok
 
     // get loops of e1, e2, find the loop referencing f1, f2
-    std::vector<Loop*> e1Loops = e1->Loops();
-    std::vector<Loop*> e2Loops = e2->Loops();
     Loop* e1Loop = nullptr;
     Loop* e2Loop = nullptr;
-    for(Loop* loop : e1Loops) {
+    for(Loop* loop : e1->LoopRange()) {
         if(loop->f == f1) {
             e1Loop = loop;
             break;
         }
     }
-    for(Loop* loop : e2Loops) {
+    for(Loop* loop : e2->LoopRange()) {
         if(loop->f == f2) {
             e2Loop = loop;
             break;
@@ -74,8 +72,7 @@ void GlueFace(Face* f1, Edge* e1, Face* f2, Edge* e2) {
     for(std::size_t i = 0; i < f1Loops.size(); ++i) {
         // if the current edge borders both f1 and f2
         // current loops must use the current edge
-        std::vector<Loop*> edgeLoops = f1Loops.at(i)->e->Loops();
-        for(Loop* l : edgeLoops) {
+        for(Loop* l : f1Loops.at(i)->e->LoopRange()) {
             if(l->f == f2) {
                 // edge is used by the face f2 as well
                 // if not used in current loop, input is invalid
@@ -87,8 +84,7 @@ void GlueFace(Face* f1, Edge* e1, Face* f2, Edge* e2) {
         }
 
         // check vert faces. 
-        std::vector<Face*> vertFaces = f1Loops.at(i)->v->Faces();
-        for(Face* f : vertFaces) {
+        for(Face* f : f1Loops.at(i)->v->FaceRange()) {
             // if vert is used by f2, vert must be vert of the current f2Loop
             if(f2 == f) {
                 if(f1Loops.at(i) != f2Loops.at(i)) {
@@ -9,8 +9,8 @@ namespace Core {
 void deleteMergeableFaces(Edge* v1e1, Edge* v1e2, Edge* v2e1, Edge* v2e2) {
     // check if v1e1, v1e2 share a face
     std::vector<Face*> facesv1 = std::vector<Face*>();
-    for(Face* fe1 : v1e1->Faces()) {
-        for(Face* fe2 : v1e2->Faces()) {
+    for(Face* fe1 : v1e1->FaceRange()) {
+        for(Face* fe2 : v1e2->FaceRange()) {
             if(fe1 == fe2) {
                 facesv1.push_back(fe1);
             }
@@ -22,8 +22,8 @@ void deleteMergeableFaces(Edge* v1e1, Edge* v1e2, Edge* v2e1, Edge* v2e2) {
 
     // check if v2e1, v2e2 share a face
     std::vector<Face*> facesv2 = std::vector<Face*>();
-    for(Face* fe1 : v2e1->Faces()) {
-        for(Face* fe2 : v2e2->Faces()) {
+    for(Face* fe1 : v2e1->FaceRange()) {
+        for(Face* fe2 : v2e2->FaceRange()) {
             if(fe1 == fe2) {
                 facesv2.push_back(fe1);
             }
@@ -38,13 +38,13 @@ void deleteMergeableFaces(Edge* v1e1, Edge* v1e2, Edge* v2e1, Edge* v2e2) {
     std::vector<Face*> facesToKill = std::vector<Face*>();
 
     for(Face* fv1 : facesv1) {
-        std::vector<Edge*> fv1Edges = fv1->Edges();
         for(Face* fv2 : facesv2) {
             bool notFound = false;
-            for(Edge* fv2Edge : fv2->Edges()) {
+            for(Edge* fv2Edge : fv2->EdgeRange()) {
                 if(fv2Edge != v2e1 && fv2Edge != v2e2) {
                     // ignoring edges aroud v2, v1
                     // checking edges here. if the faces are same, edges will be same, but opposite orientation
+                    FaceEdgeRange fv1Edges = fv1->EdgeRange();
                     if(std::find(fv1Edges.begin(), fv1Edges.end(), fv2Edge) == fv1Edges.end()) {
                         // edge from face fv2 was not found in face fv1
                         notFound = true;
@@ -69,17 +69,23 @@ void deleteMergeableFaces(Edge* v1e1, Edge* v1e2, Edge* v2e1, Edge* v2e2) {
 // this code is... interesting
 // several parts are rather costly, and some checks could be separated, at the cost of safety
 void GlueVert(Vert* v1, Vert* v2) {
+    Mesh* m = v1->ParentMesh();
     std::vector<Edge*> v1Edges = v1->Edges();
     std::vector<Edge*> v2Edges = v2->Edges();
 
-    // check if there is an edge between v1, v2
-    Edge* common = nullptr;
-    for(Edge* e : v1Edges) {
-        if(e->Other(v1) == v2) {
-            common = e;
-            break;
-        }
+    // all edges around v1 and v2 and the verts on their other side change their neighbourhood
+    for(Edge* edge : v1Edges) {
+        m->Unclassify(edge);
     }
+    for(Edge* edge : v2Edges) {
+        m->Unclassify(edge);
+    }
+    m->Unclassify(v1);
+    m->RecordChange(v1);
+    m->RecordChange(v2);
+
+    // check if there is an edge between v1, v2
+    Edge* common = m->FindEdge(v1, v2);
 
     // TODO: in order to handle the case where v1 and v2 belong to the same face
     // but do not share an edge
@@ -89,9 +95,8 @@ void GlueVert(Vert* v1, Vert* v2) {
     if(common == nullptr) {
         // check if v1 and v2 are used by the same face...
         Face* found = nullptr;
-        std::vector<Face*> v1Faces = v1->Faces();
-        std::vector<Face*> v2Faces = v2->Faces();
-        for(Face* f1 : v1Faces) {
+        VertFaceRange v2Faces = v2->FaceRange();
+        for(Face* f1 : v1->FaceRange()) {
             if(std::find(v2Faces.begin(), v2Faces.end(), f1) != v2Faces.end()) {
                 // edge from face fv2 was not found in face fv1
                 found = f1;
@@ -101,8 +106,8 @@ void GlueVert(Vert* v1, Vert* v2) {
         if(found != nullptr) {
             // v1 and v2 are used in the same face
             // split the face using manifoldMakeEdge
-            Edge* newe = new Edge();
-            Face* newf = new Face();
+            Edge* newe = m->NewEdge();
+            Face* newf = m->NewFace();
             ManifoldMakeEdge(v1, v2, found, newe, newf);
             common = newe;
         }
@@ -152,8 +157,9 @@ void GlueVert(Vert* v1, Vert* v2) {
     if(common != nullptr) {
         // check if common edge has faces
         // TODO: this can likely be optimized
+        // faces are killed while iterating, so a copy of the list is required
         for(Face* face : common->Faces()) {
-            if(face->Loops().size() <= 3) {
+            if(face->LoopRange().Size() <= 3) {
                 // faces with loops < 3 should not exist, but check anyways
                 // if face has 3 loops, this means that it's a triangle
                 // therefore, it's edges are already inside pairEdges lists.
@@ -162,9 +168,16 @@ void GlueVert(Vert* v1, Vert* v2) {
             } else {
                 // face has 4 or more loops, therefore, it will remain
                 // find the loop which uses this edge and remove it from face list via fNext, fPrev
-                std::vector<Loop*> loops = common->Loops();
-                for(Loop* loop : loops) {
+                // iteration stops as soon as the loop is removed
+                for(Loop* loop : common->LoopRange()) {
                     if(loop->f == face) {
+                        m->RecordChange(loop);
+                        m->RecordChange(loop->fNext);
+                        m->RecordChange(loop->fPrev);
+                        m->RecordChange(loop->eNext);
+                        m->RecordChange(loop->ePrev);
+                        m->RecordChange(face);
+                        m->RecordChange(common);
                         // remove loop from face list of loops
                         loop->fNext->fPrev = loop->fPrev;
                         loop->fPrev->fNext = loop->fNext;
@@ -180,7 +193,7 @@ void GlueVert(Vert* v1, Vert* v2) {
                             loop->ePrev->eNext = loop->eNext;
                             loop->eNext->ePrev = loop->ePrev;
                         }
-                        delete loop;
+                        m->Dispose(loop);
                         break;
                     }
                 }
@@ -195,6 +208,14 @@ void GlueVert(Vert* v1, Vert* v2) {
     // remove all v2 references from edges and loops and replace them with references to v1
     // add the edge to list of edges around v1
     for(Edge* edge : v2OtherEdges) {
+        m->RecordChange(edge);
+        m->RecordChange(v1);
+        if(v1->e != nullptr) {
+            m->RecordChange(v1->e);
+            m->RecordChange(v1->e->Prev(v1));
+        }
+        // the edge is keyed by v2, it is indexed again once it uses v1
+        m->UnindexEdge(edge);
         if(edge->v1 == v2) {
             edge->v1 = v1;
             if(v1->e == nullptr) {
@@ -253,11 +274,13 @@ void GlueVert(Vert* v1, Vert* v2) {
             }
         }
 
-        for(Loop* loop : edge->Loops()) {
+        for(Loop* loop : edge->LoopRange()) {
             if(loop->v == v2) {
+                m->RecordChange(loop);
                 loop->v = v1;
             }
         }
+        m->IndexEdge(edge);
     }
 
     // for edges with pairs
@@ -266,7 +289,15 @@ void GlueVert(Vert* v1, Vert* v2) {
     for(std::size_t i = 0; i < v2PairEdges.size(); ++i) {
         Edge* edge = v2PairEdges.at(i);
         Edge* pairEdge = v1PairEdges.at(i);
+        m->RecordChange(edge);
+        m->RecordChange(pairEdge);
+        // loops are moved to the pair edge while iterating, so a copy of the list is required
         for(Loop* loop : edge->Loops()) {
+            m->RecordChange(loop);
+            if(pairEdge->l != nullptr) {
+                m->RecordChange(pairEdge->l);
+                m->RecordChange(pairEdge->l->ePrev);
+            }
             loop->e = pairEdge;
             if(loop->v == v2) {
                 loop->v = v1;
@@ -305,6 +336,10 @@ void GlueVert(Vert* v1, Vert* v2) {
             next = edge->v1Next;
         }
 
+        m->RecordChange(prev);
+        m->RecordChange(next);
+        m->RecordChange(edge->mPrev);
+        m->RecordChange(edge->mNext);
         if(next->v1 == other) {
             next->v1Prev = prev;
         } else {
@@ -319,25 +354,31 @@ void GlueVert(Vert* v1, Vert* v2) {
 
         // remove edge from mesh list of edges
         if(edge->mNext == edge && edge->mPrev == edge) {
-            edge->m->edges = nullptr;
+            m->edges = nullptr;
         } else {
             edge->mPrev->mNext = edge->mNext;
             edge->mNext->mPrev = edge->mPrev;
-            if(edge->m->edges == edge) {
-                edge->m->edges = edge->mNext;
+            if(m->edges == edge) {
+                m->edges = edge->mNext;
             }
         }
-        delete edge;
+        m->edgeCount--;
+        m->UnindexEdge(edge);
+        m->Dispose(edge);
     }
 
     // remove v2 from mesh list of verts
     // not checking if v2 is last, because v1 must remain
+    m->RecordChange(v2);
+    m->RecordChange(v2->mPrev);
+    m->RecordChange(v2->mNext);
     v2->mPrev->mNext = v2->mNext;
     v2->mNext->mPrev = v2->mPrev;
-    if(v2->m->verts == v2) {
-        v2->m->verts = v2->mNext;
+    if(m->verts == v2) {
+        m->verts = v2->mNext;
     }
-    delete v2;
+    m->vertCount--;
+    m->Dispose(v2);
 
     return;
 }
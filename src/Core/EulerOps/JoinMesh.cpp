@@ -5,14 +5,37 @@ namespace Aoba {
 namespace Core {
 
 void JoinMesh(Mesh* m1, Mesh* m2) {
+    // joining is not recorded, steps of both meshes are discarded while they still own their elements
+    if(m1->journal != nullptr) {
+        m1->ResetJournal();
+    }
+    if(m2->journal != nullptr) {
+        m2->ResetJournal();
+    }
+    // all elements of m2 are new to the consumers of m1
+    MeshChanges* changes = m1->changes;
+
+    // coordinates of m2 follow the storage mode of m1.
+    // chunks are handed to m1 along with the vert blocks of m2, so the coordinates of m2 keep their addresses
+    m2->EnableCoordArrays(m1->coordArraysEnabled);
+    if(m1->coordArraysEnabled) {
+        m1->coordArray.Merge(m2->coordArray);
+    }
+    // m1 does not maintain the classification of m2 unless it maintains its own
+    if(!m1->classificationEnabled) {
+        m2->EnableClassificationCache(false);
+    }
+
     // join verts
     if(m2->verts) {
-        // make all m2 verts point to m1
-        Vert* current = m2->verts;
-        do {
-            current->m = m1;
-            current = current->mNext;
-        } while(current != m2->verts);
+        // all m2 verts are new to the consumers of m1
+        if(changes != nullptr) {
+            Vert* current = m2->verts;
+            do {
+                changes->Created(current);
+                current = current->mNext;
+            } while(current != m2->verts);
+        }
 
         // merge the lists
         if(m1->verts) {
@@ -34,15 +57,17 @@ void JoinMesh(Mesh* m1, Mesh* m2) {
 
     // join edges
     if(m2->edges) {
-        // make all m2 edges point to m1
-        Edge* current = m2->edges;
-        do {
-            current->m = m1;
-            current = current->mNext;
-        } while(current != m2->edges);
+        // all m2 edges are new to the consumers of m1
+        if(changes != nullptr) {
+            Edge* current = m2->edges;
+            do {
+                changes->Created(current);
+                current = current->mNext;
+            } while(current != m2->edges);
+        }
 
         // merge the lists
-        if(m1->verts) {
+        if(m1->edges) {
             Edge* m1Start = m1->edges;
             Edge* m1End = m1->edges->mPrev;
             Edge* m2Start = m2->edges;
@@ -61,20 +86,17 @@ void JoinMesh(Mesh* m1, Mesh* m2) {
 
     // join faces and loops
     if(m2->faces) {
-        // make all m2 faces and their loops point to m1
-        Face* current = m2->faces;
-        do {
-            Loop* currentLoop = current->l;
-            while(currentLoop->fNext != current->l) {
-                currentLoop->m = m1;
-                currentLoop = currentLoop->fNext;
-            }
-            current->m = m1;
-            current = current->mNext;
-        } while(current != m2->faces);
+        // all m2 faces are new to the consumers of m1
+        if(changes != nullptr) {
+            Face* current = m2->faces;
+            do {
+                changes->Created(current);
+                current = current->mNext;
+            } while(current != m2->faces);
+        }
 
         // merge the lists
-        if(m1->verts) {
+        if(m1->faces) {
             Face* m1Start = m1->faces;
             Face* m1End = m1->faces->mPrev;
             Face* m2Start = m2->faces;
@@ -91,6 +113,35 @@ void JoinMesh(Mesh* m1, Mesh* m2) {
         m2->faces = nullptr;
     }
 
+    // m1 now holds all elements of m2
+    m1->vertCount += m2->vertCount;
+    m1->edgeCount += m2->edgeCount;
+    m1->faceCount += m2->faceCount;
+    m2->vertCount = 0;
+    m2->edgeCount = 0;
+    m2->faceCount = 0;
+
+    // edges of m2 never share verts with edges of m1, so the indices can be merged directly
+    if(m1->edgeIndexEnabled) {
+        if(m2->edgeIndexEnabled) {
+            m1->edgeIndex.insert(m2->edgeIndex.begin(), m2->edgeIndex.end());
+        } else {
+            m1->edgeIndexEnabled = false;
+            m1->EnableEdgeIndex(true);
+        }
+    }
+
+    // elements of m2 may carry markers of generations which m1 has not handed out yet
+    if(m1->generation < m2->generation) {
+        m1->generation = m2->generation;
+    }
+
+    // move the element storage of m2 into m1, so that elements of m2 outlive m2 and belong to m1
+    m1->vertPool.Merge(m2->vertPool);
+    m1->edgePool.Merge(m2->edgePool);
+    m1->facePool.Merge(m2->facePool);
+    m1->loopPool.Merge(m2->loopPool);
+
     delete m2;
 }
 
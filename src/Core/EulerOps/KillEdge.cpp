@@ -6,13 +6,24 @@ namespace Core {
 
 void KillEdge(Edge* e) {
     // Kill all faces using this edge
-    if(e->l != nullptr) {
-        std::vector<Face*> edgeFaces = e->Faces();
-        for(Face* f : edgeFaces) {
-            KillFace(f);
-        }
+    // KillFace moves e->l to the next loop, until there are none left
+    while(e->l != nullptr) {
+        KillFace(e->l->LoopFace());
     }
 
+    Mesh* m = e->ParentMesh();
+    m->RecordChange(e);
+    m->RecordChange(e->v1);
+    m->RecordChange(e->v2);
+    m->RecordChange(e->v1Next);
+    m->RecordChange(e->v1Prev);
+    m->RecordChange(e->v2Next);
+    m->RecordChange(e->v2Prev);
+    m->RecordChange(e->mNext);
+    m->RecordChange(e->mPrev);
+    m->UnindexEdge(e);
+    m->Unclassify(e);
+
     // for v1, check if this is the only edge
     if(e->v1->e == e && e->v1Next == e && e->v1Prev == e) {
         e->v1->e = nullptr;
@@ -64,16 +75,17 @@ void KillEdge(Edge* e) {
 
     // remove edge from list of edges in mesh.
     if(e->mNext == e && e->mPrev == e) {
-        e->m->edges = nullptr;
+        m->edges = nullptr;
     } else {
         e->mPrev->mNext = e->mNext;
         e->mNext->mPrev = e->mPrev;
-        if(e->m->edges == e) {
-            e->m->edges = e->mNext;
+        if(m->edges == e) {
+            m->edges = e->mNext;
         }
     }
 
-    delete e;
+    m->edgeCount--;
+    m->Dispose(e);
 }
 
 } // namespace Core
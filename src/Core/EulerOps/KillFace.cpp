@@ -5,9 +5,20 @@ namespace Aoba {
 namespace Core {
 
 void KillFace(Face* f) {
+    Mesh* m = f->ParentMesh();
+    m->RecordChange(f);
+    m->RecordChange(f->mNext);
+    m->RecordChange(f->mPrev);
+    m->Unclassify(f);
+
     // iterate over all face loops
     Loop* currentLoop = f->l;
     do {
+        m->RecordChange(currentLoop);
+        m->RecordChange(currentLoop->eNext);
+        m->RecordChange(currentLoop->ePrev);
+        m->RecordChange(currentLoop->e);
+
         // remove loop from list of loops around an edge.
         if(currentLoop->eNext == currentLoop && currentLoop->ePrev == currentLoop) {
             // this is the only face using this edge.
@@ -23,22 +34,24 @@ void KillFace(Face* f) {
 
         Loop* toDelete = currentLoop;
         currentLoop = currentLoop->fNext;
-        delete toDelete;
+        m->Dispose(toDelete);
     } while(currentLoop != f->l);
 
     // remove face from list of faces in mesh.
     if(f->mNext == f && f->mPrev == f) {
-        f->m->faces = nullptr;
+        m->faces = nullptr;
     } else {
         f->mPrev->mNext = f->mNext;
         f->mNext->mPrev = f->mPrev;
-        if(f->m->faces == f) {
-            f->m->faces = f->mNext;
+        if(m->faces == f) {
+            m->faces = f->mNext;
         }
     }
 
+    m->faceCount--;
+
     // delete face
-    delete f;
+    m->Dispose(f);
 }
 
 } // namespace Core
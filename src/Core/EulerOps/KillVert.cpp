@@ -5,26 +5,30 @@ namespace Aoba {
 namespace Core {
 
 void KillVert(Vert* v) {
+    Mesh* m = v->ParentMesh();
     // Kill all edges (and faces) using this edge
-    std::vector<Edge*> vertEdges = v->Edges();
-    if(vertEdges.size() > 0) {
-        for(auto it = vertEdges.begin(); it != vertEdges.end(); ++it) {
-            KillEdge(*it);
-        }
+    // KillEdge moves v->e to the next edge, until there are none left
+    while(v->e != nullptr) {
+        KillEdge(v->e);
     }
 
+    m->RecordChange(v);
+    m->RecordChange(v->mNext);
+    m->RecordChange(v->mPrev);
+
     // remove vert from list of verts in mesh.
     if(v->mNext == v && v->mPrev == v) {
-        v->m->verts = nullptr;
+        m->verts = nullptr;
     } else {
         v->mPrev->mNext = v->mNext;
         v->mNext->mPrev = v->mPrev;
-        if(v->m->verts == v) {
-            v->m->verts = v->mNext;
+        if(m->verts == v) {
+            m->verts = v->mNext;
         }
     }
 
-    delete v;
+    m->vertCount--;
+    m->Dispose(v);
 }
 
 } // namespace Core
@@ -12,15 +12,30 @@ void MakeEdge(Vert* v1, Vert* v2, Edge* newe) {
         throw std::invalid_argument("Self-loop edges are not allowed");
     }
 
-    for(Core::Edge* edge : v1->Edges()) {
-        if(edge->Other(v1) == v2) {
-            throw std::invalid_argument("Edge already exists between v1 and v2");
-        }
+    Mesh* m = v1->ParentMesh();
+    if(m->FindEdge(v1, v2) != nullptr) {
+        throw std::invalid_argument("Edge already exists between v1 and v2");
+    }
+
+    // record everything which is about to change, see Mesh::EnableJournal
+    m->RecordCreated(newe);
+    if(m->edges != nullptr) {
+        m->RecordChange(m->edges);
+        m->RecordChange(m->edges->mPrev);
+    }
+    m->RecordChange(v1);
+    if(v1->e != nullptr) {
+        m->RecordChange(v1->e);
+        m->RecordChange(v1->e->Prev(v1));
+    }
+    m->RecordChange(v2);
+    if(v2->e != nullptr) {
+        m->RecordChange(v2->e);
+        m->RecordChange(v2->e->Prev(v2));
     }
 
     // add newe to the mesh.
     // mesh might not have any edges at this point.
-    Mesh* m = v1->m;
     if(m->edges == nullptr) {
         // empty mesh case
         m->edges = newe;
@@ -34,12 +49,14 @@ void MakeEdge(Vert* v1, Vert* v2, Edge* newe) {
         newe->mNext = m->edges;
         m->edges = newe;
     }
+    m->edgeCount++;
 
     // add verts v1 and v2 to edge, set loops to nullptr
     newe->v1 = v1;
     newe->v2 = v2;
     newe->l = nullptr;
-    newe->m = v1->m;
+    m->IndexEdge(newe);
+    m->Unclassify(newe);
 
     // set list of edges around v1.
     if(v1->e == nullptr) {
@@ -9,17 +9,30 @@ void MakeEdgeVert(Vert* v, Edge* newe, Vert* newv) {
 
     // add newv to the mesh.
     // no need to check for nullptr since v is already in the mesh.
-    Mesh* m = v->m;
-    newv->m = m;
+    Mesh* m = v->ParentMesh();
+    m->RecordCreated(newv);
+    m->RecordCreated(newe);
+    m->RecordChange(m->verts);
+    m->RecordChange(m->verts->mPrev);
+    if(m->edges != nullptr) {
+        m->RecordChange(m->edges);
+        m->RecordChange(m->edges->mPrev);
+    }
+    m->RecordChange(v);
+    if(v->e != nullptr) {
+        m->RecordChange(v->e);
+        m->RecordChange(v->e->Prev(v));
+    }
+
     m->verts->mPrev->mNext = newv;
     newv->mPrev = m->verts->mPrev;
     m->verts->mPrev = newv;
     newv->mNext = m->verts;
     m->verts = newv;
+    m->vertCount++;
 
     // add newe to the mesh.
     // mesh might not have any edges at this point.
-    newe->m = m;
     if(m->edges == nullptr) {
         // empty mesh case
         m->edges = newe;
@@ -33,11 +46,14 @@ void MakeEdgeVert(Vert* v, Edge* newe, Vert* newv) {
         newe->mNext = m->edges;
         m->edges = newe;
     }
+    m->edgeCount++;
 
     // add existing vert v as v1, newv as v2 of the edge, set loops to nullptr
     newe->v1 = v;
     newe->v2 = newv;
     newe->l = nullptr;
+    m->IndexEdge(newe);
+    m->Unclassify(newe);
 
     // set list of edges around newv - v2.
     // since v2 is a new vert, it only has this single edge that is adjecent.
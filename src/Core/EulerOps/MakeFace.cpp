@@ -7,13 +7,19 @@ namespace Aoba {
 namespace Core {
 
 void MakeFace(Loop* loop, Face* newf) {
-    Mesh* m = loop->m;
+    Mesh* m = loop->ParentMesh();
+    m->RecordCreated(newf);
+    if(m->faces != nullptr) {
+        m->RecordChange(m->faces);
+        m->RecordChange(m->faces->mPrev);
+    }
 
     // set the first loop of the face
     newf->l = loop;
     Loop* current = loop;
 
     do {
+        m->RecordChange(current);
         current->f = newf;
         current = current->fNext;
     } while(current != loop);
@@ -30,9 +36,7 @@ void MakeFace(Loop* loop, Face* newf) {
         newf->mNext = m->faces;
         m->faces = newf;
     }
-
-    // link face to mesh
-    newf->m = m;
+    m->faceCount++;
 }
 
 } // namespace Core
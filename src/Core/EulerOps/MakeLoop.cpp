@@ -11,12 +11,16 @@ void MakeLoop(std::vector<Edge*> edges, std::vector<Vert*> verts, Loop* first) {
         throw std::invalid_argument("Face must have at least 3 distinct edges.");
     }
 
+    Mesh* m = edges.at(0)->ParentMesh();
     std::vector<Loop*> newLoops = std::vector<Loop*>();
     newLoops.reserve(edges.size());
 
     newLoops.push_back(first);
     for(std::size_t i = 0; i < edges.size() - 1; i++) {
-        newLoops.push_back(new Loop());
+        newLoops.push_back(m->NewLoop());
+    }
+    for(Loop* newl : newLoops) {
+        m->RecordCreated(newl);
     }
 
     // create loops for each vert-edge pair
@@ -28,7 +32,12 @@ void MakeLoop(std::vector<Edge*> edges, std::vector<Vert*> verts, Loop* first) {
         // TODO: check wether vert is adjecent to edge
         newl->e = currentEdge;
         newl->v = verts.at(i);
-        newl->m = currentEdge->m;
+        m->RecordChange(currentEdge);
+        if(currentEdge->l != nullptr) {
+            m->RecordChange(currentEdge->l);
+            m->RecordChange(currentEdge->l->ePrev);
+        }
+        m->Unclassify(currentEdge);
 
         // add the new loop to edge
         // no existing loops using edge
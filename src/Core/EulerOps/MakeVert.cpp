@@ -6,8 +6,13 @@ namespace Aoba {
 namespace Core {
 
 void MakeVert(Mesh* m, Vert* newv) {
+    m->RecordCreated(newv);
+    if(m->verts != nullptr) {
+        m->RecordChange(m->verts);
+        m->RecordChange(m->verts->mPrev);
+    }
+
     newv->e = nullptr; // new verts don't have any edges
-    newv->m = m; // set pointer to mesh from vert.
 
     if(m->verts == nullptr) {
         // empty mesh case
@@ -22,6 +27,8 @@ void MakeVert(Mesh* m, Vert* newv) {
         newv->mNext = m->verts;
         m->verts = newv;
     }
+    m->vertCount++;
+    m->Unclassify(newv);
 }
 
 } // namespace Core
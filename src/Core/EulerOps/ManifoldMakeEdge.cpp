@@ -8,6 +8,7 @@ namespace Core {
 
 void ManifoldMakeEdge(Vert* v1, Vert* v2, Face* f, Edge* newe, Face* newf) {
     // TODO: check wether inputs are valid
+    Mesh* m = f->ParentMesh();
 
     // make the edge between v1, v2
     MakeEdge(v1, v2, newe);
@@ -15,7 +16,7 @@ void ManifoldMakeEdge(Vert* v1, Vert* v2, Face* f, Edge* newe, Face* newf) {
     // find loops with starting point in l1, l2
     Loop* loop1 = nullptr;
     Loop* loop2 = nullptr;
-    for(Core::Loop* loop : f->Loops()) {
+    for(Core::Loop* loop : f->LoopRange()) {
         if(loop->v == v1) {
             loop1 = loop;
         }
@@ -28,12 +29,21 @@ void ManifoldMakeEdge(Vert* v1, Vert* v2, Face* f, Edge* newe, Face* newf) {
     }
 
     // Make two new loops
-    Loop* newl1 = new Loop();
-    Loop* newl2 = new Loop();
+    Loop* newl1 = m->NewLoop();
+    Loop* newl2 = m->NewLoop();
     newl1->v = v2;
     newl2->v = v1;
-    newl1->m = f->m;
-    newl2->m = f->m;
+
+    // record everything which is about to change, see Mesh::EnableJournal
+    m->RecordCreated(newl1);
+    m->RecordCreated(newl2);
+    m->RecordCreated(newf);
+    m->RecordChange(f);
+    m->RecordChange(m->faces);
+    m->RecordChange(m->faces->mPrev);
+    for(Loop* loop : f->LoopRange()) {
+        m->RecordChange(loop);
+    }
 
     // add the new loops to face loops
     newl1->fPrev = loop2->fPrev;
@@ -71,13 +81,12 @@ void ManifoldMakeEdge(Vert* v1, Vert* v2, Face* f, Edge* newe, Face* newf) {
     }
 
     // add newf to list of faces in mesh
-    Mesh* m = f->m;
-    newf->m = m;
     m->faces->mPrev->mNext = newf;
     newf->mPrev = m->faces->mPrev;
     m->faces->mPrev = newf;
     newf->mNext = m->faces;
     m->faces = newf;
+    m->faceCount++;
 
     return;
 }
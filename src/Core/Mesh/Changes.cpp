@@ -0,0 +1,144 @@
+#include "AobaAPI/Core/Mesh/Changes.hpp"
+
+namespace Aoba {
+namespace Core {
+
+namespace {
+
+template<typename T>
+void AddCreated(T* element, std::unordered_set<T*>& created, std::unordered_set<T*>& modified,
+                std::unordered_set<const T*>& killed) {
+    // storage of a killed element was reused, consumers see the same element with new contents
+    if(killed.erase(element) != 0) {
+        modified.insert(element);
+        return;
+    }
+    created.insert(element);
+}
+
+template<typename T>
+void AddKilled(T* element, std::unordered_set<T*>& created, std::unordered_set<T*>& modified,
+               std::unordered_set<const T*>& killed) {
+    // elements created since the last reset were never seen by consumers
+    if(created.erase(element) != 0) {
+        return;
+    }
+    modified.erase(element);
+    killed.insert(element);
+}
+
+template<typename T>
+void AddModified(T* element, std::unordered_set<T*>& created, std::unordered_set<T*>& modified) {
+    if(created.count(element) == 0) {
+        modified.insert(element);
+    }
+}
+
+template<typename T>
+std::size_t SetMemoryUsage(const std::unordered_set<T>& set) {
+    // every entry is a separately allocated node holding the value, the hash and a pointer to the next node
+    return set.bucket_count() * sizeof(void*) + set.size() * (sizeof(T) + sizeof(void*) + sizeof(std::size_t));
+}
+
+} // namespace
+
+MeshChanges::MeshChanges() {
+    rebuilt = false;
+}
+
+bool MeshChanges::IsEmpty() const {
+    return !rebuilt && createdVerts.empty() && modifiedVerts.empty() && killedVerts.empty() && createdEdges.empty()
+           && modifiedEdges.empty() && killedEdges.empty() && createdFaces.empty() && modifiedFaces.empty()
+           && killedFaces.empty();
+}
+
+void MeshChanges::Clear() {
+    createdVerts.clear();
+    modifiedVerts.clear();
+    killedVerts.clear();
+    createdEdges.clear();
+    modifiedEdges.clear();
+    killedEdges.clear();
+    createdFaces.clear();
+    modifiedFaces.clear();
+    killedFaces.clear();
+    rebuilt = false;
+}
+
+std::size_t MeshChanges::MemoryUsage() const {
+    return sizeof(MeshChanges) + SetMemoryUsage(createdVerts) + SetMemoryUsage(modifiedVerts)
+           + SetMemoryUsage(killedVerts) + SetMemoryUsage(createdEdges) + SetMemoryUsage(modifiedEdges)
+           + SetMemoryUsage(killedEdges) + SetMemoryUsage(createdFaces) + SetMemoryUsage(modifiedFaces)
+           + SetMemoryUsage(killedFaces);
+}
+
+void MeshChanges::Created(Vert* v) {
+    if(rebuilt) {
+        return;
+    }
+    AddCreated(v, createdVerts, modifiedVerts, killedVerts);
+}
+
+void MeshChanges::Created(Edge* e) {
+    if(rebuilt) {
+        return;
+    }
+    AddCreated(e, createdEdges, modifiedEdges, killedEdges);
+}
+
+void MeshChanges::Created(Face* f) {
+    if(rebuilt) {
+        return;
+    }
+    AddCreated(f, createdFaces, modifiedFaces, killedFaces);
+}
+
+void MeshChanges::Killed(Vert* v) {
+    if(rebuilt) {
+        return;
+    }
+    AddKilled(v, createdVerts, modifiedVerts, killedVerts);
+}
+
+void MeshChanges::Killed(Edge* e) {
+    if(rebuilt) {
+        return;
+    }
+    AddKilled(e, createdEdges, modifiedEdges, killedEdges);
+}
+
+void MeshChanges::Killed(Face* f) {
+    if(rebuilt) {
+        return;
+    }
+    AddKilled(f, createdFaces, modifiedFaces, killedFaces);
+}
+
+void MeshChanges::Modified(Vert* v) {
+    if(rebuilt) {
+        return;
+    }
+    AddModified(v, createdVerts, modifiedVerts);
+}
+
+void MeshChanges::Modified(Edge* e) {
+    if(rebuilt) {
+        return;
+    }
+    AddModified(e, createdEdges, modifiedEdges);
+}
+
+void MeshChanges::Modified(Face* f) {
+    if(rebuilt) {
+        return;
+    }
+    AddModified(f, createdFaces, modifiedFaces);
+}
+
+void MeshChanges::Rebuilt() {
+    Clear();
+    rebuilt = true;
+}
+
+} // namespace Core
+} // namespace Aoba
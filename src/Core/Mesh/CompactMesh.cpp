@@ -0,0 +1,387 @@
+#include "AobaAPI/Core/Mesh/CompactMesh.hpp"
+
+#include "AobaAPI/Core/Mesh/Edge.hpp"
+#include "AobaAPI/Core/Mesh/Face.hpp"
+#include "AobaAPI/Core/Mesh/Loop.hpp"
+#include "AobaAPI/Core/Mesh/Vert.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace Aoba {
+namespace Core {
+
+CompactVert::CompactVert(const CompactMesh* cm, std::size_t idx) : cm(cm), idx(idx) {
+}
+
+std::size_t CompactVert::Index() const {
+    return idx;
+}
+
+const Math::Vec3& CompactVert::Co() const {
+    return cm->vertCo[idx];
+}
+
+const Math::Vec3& CompactVert::No() const {
+    return cm->vertNo[idx];
+}
+
+std::size_t CompactVert::EdgeCount() const {
+    return cm->vertEdgeOffsets[idx + 1] - cm->vertEdgeOffsets[idx];
+}
+
+CompactEdge CompactVert::Edge(std::size_t i) const {
+    return CompactEdge(cm, cm->vertEdges[cm->vertEdgeOffsets[idx] + i]);
+}
+
+std::size_t CompactVert::FaceCount() const {
+    return cm->vertFaceOffsets[idx + 1] - cm->vertFaceOffsets[idx];
+}
+
+CompactFace CompactVert::Face(std::size_t i) const {
+    return CompactFace(cm, cm->vertFaces[cm->vertFaceOffsets[idx] + i]);
+}
+
+bool CompactVert::IsBoundary() const {
+    for(uint32_t i = cm->vertEdgeOffsets[idx]; i < cm->vertEdgeOffsets[idx + 1]; ++i) {
+        if(CompactEdge(cm, cm->vertEdges[i]).IsBoundary()) {
+            return true; // boundary edge found
+        }
+    }
+    return false; // no boundary edges found, or isolated vert
+}
+
+bool CompactVert::IsManifold() const {
+    const uint32_t begin = cm->vertEdgeOffsets[idx];
+    const uint32_t end = cm->vertEdgeOffsets[idx + 1];
+    if(begin == end) {
+        return false; // isolated vert
+    }
+    // same traversal as Vert::IsManifold, using loop indices
+    std::size_t boundaryEdgeCount = 0;
+    uint32_t lastBoundary = 0;
+    for(uint32_t i = begin; i < end; ++i) {
+        CompactEdge edge = CompactEdge(cm, cm->vertEdges[i]);
+        if(!edge.IsManifold()) {
+            return false; // non manifold edge found
+        }
+        if(edge.IsBoundary()) {
+            boundaryEdgeCount++;
+            lastBoundary = cm->vertEdges[i];
+        }
+    }
+    const std::size_t edgeCount = end - begin;
+    if(boundaryEdgeCount > 2) {
+        return false; // boundary verts always have two adjecent boundary edges.
+    }
+
+    // traverse the edges using loops, starting from a boundary edge or from the first edge
+    const uint32_t startEdge = boundaryEdgeCount > 0 ? lastBoundary : cm->vertEdges[begin];
+    uint32_t currentLoop = cm->edgeLoops[cm->edgeLoopOffsets[startEdge]];
+    const bool forward = cm->loopVert[currentLoop] == idx;
+    std::size_t traversedEdgeCount = 1;
+    while(true) {
+        // always two loops, already checked for manifold
+        currentLoop = cm->loopRadialNext[forward ? cm->LoopPrev(currentLoop) : cm->LoopNext(currentLoop)];
+        traversedEdgeCount++;
+        const uint32_t currentEdge = cm->loopEdge[currentLoop];
+        if(boundaryEdgeCount > 0 ? CompactEdge(cm, currentEdge).IsBoundary() : currentEdge == startEdge) {
+            break;
+        }
+    }
+    return traversedEdgeCount >= edgeCount;
+}
+
+bool CompactVert::IsWire() const {
+    for(uint32_t i = cm->vertEdgeOffsets[idx]; i < cm->vertEdgeOffsets[idx + 1]; ++i) {
+        if(CompactEdge(cm, cm->vertEdges[i]).IsWire()) {
+            return true; // wire edge found
+        }
+    }
+    return false; // no wire edges found, or isolated vert
+}
+
+bool CompactVert::operator==(const CompactVert& other) const {
+    return cm == other.cm && idx == other.idx;
+}
+
+bool CompactVert::operator!=(const CompactVert& other) const {
+    return !(*this == other);
+}
+
+CompactEdge::CompactEdge(const CompactMesh* cm, std::size_t idx) : cm(cm), idx(idx) {
+}
+
+std::size_t CompactEdge::Index() const {
+    return idx;
+}
+
+CompactVert CompactEdge::V1() const {
+    return CompactVert(cm, cm->edgeVerts[2 * idx]);
+}
+
+CompactVert CompactEdge::V2() const {
+    return CompactVert(cm, cm->edgeVerts[2 * idx + 1]);
+}
+
+CompactVert CompactEdge::Other(const CompactVert& v) const {
+    if(v == V1()) {
+        return V2();
+    } else if(v == V2()) {
+        return V1();
+    } else {
+        throw std::invalid_argument("Specified vert not used by the edge.");
+    }
+}
+
+std::size_t CompactEdge::LoopCount() const {
+    return cm->edgeLoopOffsets[idx + 1] - cm->edgeLoopOffsets[idx];
+}
+
+CompactFace CompactEdge::Face(std::size_t i) const {
+    return CompactFace(cm, cm->loopFace[cm->edgeLoops[cm->edgeLoopOffsets[idx] + i]]);
+}
+
+float CompactEdge::CalcLength() const {
+    return (V1().Co() - V2().Co()).Magnitude();
+}
+
+bool CompactEdge::IsBoundary() const {
+    return LoopCount() == 1;
+}
+
+bool CompactEdge::IsContigous() const {
+    // identical to IsManifold, except for wire edges
+    return IsWire() || IsManifold();
+}
+
+bool CompactEdge::IsManifold() const {
+    const std::size_t count = LoopCount();
+    if(count == 0 || count > 2) {
+        return false; // wire edge, or more than 2 loops per edge
+    }
+    if(count == 2) {
+        const uint32_t first = cm->edgeLoopOffsets[idx];
+        if(cm->loopVert[cm->edgeLoops[first]] == cm->loopVert[cm->edgeLoops[first + 1]]) {
+            return false; // adjecent faces pointing in separate direction
+        }
+    }
+    return true;
+}
+
+bool CompactEdge::IsWire() const {
+    return LoopCount() == 0;
+}
+
+bool CompactEdge::operator==(const CompactEdge& other) const {
+    return cm == other.cm && idx == other.idx;
+}
+
+bool CompactEdge::operator!=(const CompactEdge& other) const {
+    return !(*this == other);
+}
+
+CompactFace::CompactFace(const CompactMesh* cm, std::size_t idx) : cm(cm), idx(idx) {
+}
+
+std::size_t CompactFace::Index() const {
+    return idx;
+}
+
+const Math::Vec3& CompactFace::No() const {
+    return cm->faceNo[idx];
+}
+
+std::size_t CompactFace::LoopCount() const {
+    return cm->faceLoopOffsets[idx + 1] - cm->faceLoopOffsets[idx];
+}
+
+CompactVert CompactFace::Vert(std::size_t i) const {
+    return CompactVert(cm, cm->loopVert[cm->faceLoopOffsets[idx] + i]);
+}
+
+CompactEdge CompactFace::Edge(std::size_t i) const {
+    return CompactEdge(cm, cm->loopEdge[cm->faceLoopOffsets[idx] + i]);
+}
+
+Math::Vec3 CompactFace::CalcCenterAverage() const {
+    Math::Vec3 result = Math::Vec3();
+    for(uint32_t i = cm->faceLoopOffsets[idx]; i < cm->faceLoopOffsets[idx + 1]; ++i) {
+        result += cm->vertCo[cm->loopVert[i]];
+    }
+    result /= float(LoopCount());
+    return result;
+}
+
+bool CompactFace::operator==(const CompactFace& other) const {
+    return cm == other.cm && idx == other.idx;
+}
+
+bool CompactFace::operator!=(const CompactFace& other) const {
+    return !(*this == other);
+}
+
+CompactMesh::CompactMesh() {
+    vertEdgeOffsets.push_back(0);
+    vertFaceOffsets.push_back(0);
+    edgeLoopOffsets.push_back(0);
+    faceLoopOffsets.push_back(0);
+}
+
+CompactMesh::CompactMesh(const Mesh* m) {
+    FromMesh(m);
+}
+
+void CompactMesh::FromMesh(const Mesh* m) {
+    const std::size_t vertCount = m->VertCount();
+    const std::size_t edgeCount = m->EdgeCount();
+    const std::size_t faceCount = m->FaceCount();
+    // every edge is listed at both of its verts, and vert numbers offset by one are used below
+    if(vertCount >= UINT32_MAX || edgeCount >= UINT32_MAX / 2 || faceCount >= UINT32_MAX) {
+        *this = CompactMesh();
+        throw std::invalid_argument("Too many elements.");
+    }
+
+    // number verts and copy their coordinates
+    vertCo.clear();
+    vertNo.clear();
+    vertCo.reserve(vertCount);
+    vertNo.reserve(vertCount);
+    for(Core::Vert* vert : m->VertRange()) {
+        vert->index = vertCo.size();
+        vertCo.push_back(vert->Co());
+        vertNo.push_back(vert->No());
+    }
+
+    // number edges
+    edgeVerts.clear();
+    edgeVerts.reserve(2 * edgeCount);
+    std::size_t edgeIdx = 0;
+    for(Core::Edge* edge : m->EdgeRange()) {
+        edge->index = edgeIdx++;
+        edgeVerts.push_back(static_cast<uint32_t>(edge->V1()->index));
+        edgeVerts.push_back(static_cast<uint32_t>(edge->V2()->index));
+    }
+
+    // number faces and loops, loops of a face are stored next to each other
+    faceNo.clear();
+    faceNo.reserve(faceCount);
+    faceLoopOffsets.clear();
+    faceLoopOffsets.reserve(faceCount + 1);
+    loopVert.clear();
+    loopEdge.clear();
+    loopFace.clear();
+    for(Core::Face* face : m->FaceRange()) {
+        face->index = faceNo.size();
+        faceNo.push_back(face->no);
+        faceLoopOffsets.push_back(static_cast<uint32_t>(loopVert.size()));
+        for(Loop* loop : face->LoopRange()) {
+            loop->index = loopVert.size();
+            loopVert.push_back(static_cast<uint32_t>(loop->LoopVert()->index));
+            loopEdge.push_back(static_cast<uint32_t>(loop->LoopEdge()->index));
+            loopFace.push_back(static_cast<uint32_t>(face->index));
+        }
+    }
+    if(loopVert.size() >= UINT32_MAX) {
+        *this = CompactMesh();
+        throw std::invalid_argument("Too many elements.");
+    }
+    faceLoopOffsets.push_back(static_cast<uint32_t>(loopVert.size()));
+
+    // loops around every edge, in radial order
+    edgeLoopOffsets.clear();
+    edgeLoopOffsets.reserve(edgeCount + 1);
+    edgeLoops.clear();
+    edgeLoops.reserve(loopVert.size());
+    loopRadialNext.assign(loopVert.size(), 0);
+    for(Core::Edge* edge : m->EdgeRange()) {
+        const uint32_t first = static_cast<uint32_t>(edgeLoops.size());
+        edgeLoopOffsets.push_back(first);
+        for(Loop* loop : edge->LoopRange()) {
+            edgeLoops.push_back(static_cast<uint32_t>(loop->index));
+        }
+        const uint32_t last = static_cast<uint32_t>(edgeLoops.size());
+        for(uint32_t i = first; i < last; ++i) {
+            loopRadialNext[edgeLoops[i]] = edgeLoops[i + 1 < last ? i + 1 : first];
+        }
+    }
+    edgeLoopOffsets.push_back(static_cast<uint32_t>(edgeLoops.size()));
+
+    // edges and distinct faces around every vert
+    vertEdgeOffsets.clear();
+    vertEdgeOffsets.reserve(vertCount + 1);
+    vertEdges.clear();
+    vertEdges.reserve(2 * edgeCount);
+    vertFaceOffsets.clear();
+    vertFaceOffsets.reserve(vertCount + 1);
+    vertFaces.clear();
+    vertFaces.reserve(loopVert.size());
+    // last vert which added each face, offset by one so that zero means none
+    std::vector<uint32_t> faceSeen = std::vector<uint32_t>(faceCount, 0);
+    for(Core::Vert* vert : m->VertRange()) {
+        const uint32_t seen = static_cast<uint32_t>(vert->index + 1);
+        vertEdgeOffsets.push_back(static_cast<uint32_t>(vertEdges.size()));
+        vertFaceOffsets.push_back(static_cast<uint32_t>(vertFaces.size()));
+        for(Core::Edge* edge : vert->EdgeRange()) {
+            vertEdges.push_back(static_cast<uint32_t>(edge->index));
+            for(uint32_t i = edgeLoopOffsets[edge->index]; i < edgeLoopOffsets[edge->index + 1]; ++i) {
+                const uint32_t face = loopFace[edgeLoops[i]];
+                if(faceSeen[face] != seen) {
+                    faceSeen[face] = seen;
+                    vertFaces.push_back(face);
+                }
+            }
+        }
+    }
+    vertEdgeOffsets.push_back(static_cast<uint32_t>(vertEdges.size()));
+    vertFaceOffsets.push_back(static_cast<uint32_t>(vertFaces.size()));
+}
+
+uint32_t CompactMesh::LoopNext(uint32_t loop) const {
+    const uint32_t face = loopFace[loop];
+    return loop + 1 < faceLoopOffsets[face + 1] ? loop + 1 : faceLoopOffsets[face];
+}
+
+uint32_t CompactMesh::LoopPrev(uint32_t loop) const {
+    const uint32_t face = loopFace[loop];
+    return loop > faceLoopOffsets[face] ? loop - 1 : faceLoopOffsets[face + 1] - 1;
+}
+
+std::size_t CompactMesh::VertCount() const {
+    return vertCo.size();
+}
+
+std::size_t CompactMesh::EdgeCount() const {
+    return edgeVerts.size() / 2;
+}
+
+std::size_t CompactMesh::FaceCount() const {
+    return faceNo.size();
+}
+
+std::size_t CompactMesh::LoopCount() const {
+    return loopVert.size();
+}
+
+CompactVert CompactMesh::Vert(std::size_t idx) const {
+    return CompactVert(this, idx);
+}
+
+CompactEdge CompactMesh::Edge(std::size_t idx) const {
+    return CompactEdge(this, idx);
+}
+
+CompactFace CompactMesh::Face(std::size_t idx) const {
+    return CompactFace(this, idx);
+}
+
+const std::vector<Math::Vec3>& CompactMesh::Coords() const {
+    return vertCo;
+}
+
+const std::vector<Math::Vec3>& CompactMesh::Normals() const {
+    return vertNo;
+}
+
+} // namespace Core
+} // namespace Aoba
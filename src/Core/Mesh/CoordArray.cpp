@@ -0,0 +1,126 @@
+#include "AobaAPI/Core/Mesh/CoordArray.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace Aoba {
+namespace Core {
+
+Math::Vec3* CoordArray::coChunks[CoordArray::Directory::ID_COUNT] = {};
+Math::Vec3* CoordArray::noChunks[CoordArray::Directory::ID_COUNT] = {};
+
+CoordArray::CoordArray() {
+    size = 0;
+}
+
+CoordArray::~CoordArray() {
+    Release();
+}
+
+void CoordArray::Renumber() {
+    starts.clear();
+    size = 0;
+    for(uint32_t id : ids) {
+        starts.push_back(size);
+        size += Directory::capacities[id];
+    }
+
+    // keep chunks sorted by address, so that slots can be found using binary search
+    byAddress.clear();
+    for(std::size_t i = 0; i < ids.size(); ++i) {
+        byAddress.push_back(i);
+    }
+    std::sort(byAddress.begin(), byAddress.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return std::less<const Math::Vec3*>()(coChunks[ids[lhs]], coChunks[ids[rhs]]);
+    });
+}
+
+void CoordArray::Attach(uint32_t id) {
+    if(coChunks[id] != nullptr) {
+        return;
+    }
+    Math::Vec3* co = new Math::Vec3[Directory::capacities[id]];
+    Math::Vec3* no = nullptr;
+    try {
+        no = new Math::Vec3[Directory::capacities[id]];
+        ids.push_back(id);
+    } catch(...) {
+        delete[] co;
+        delete[] no;
+        throw;
+    }
+    coChunks[id] = co;
+    noChunks[id] = no;
+    Renumber();
+}
+
+void CoordArray::Merge(CoordArray& other) {
+    if(&other == this) {
+        return;
+    }
+    ids.insert(ids.end(), other.ids.begin(), other.ids.end());
+    Renumber();
+
+    other.ids.clear();
+    other.Renumber();
+}
+
+void CoordArray::Release() {
+    for(uint32_t id : ids) {
+        delete[] coChunks[id];
+        delete[] noChunks[id];
+        coChunks[id] = nullptr;
+        noChunks[id] = nullptr;
+    }
+    ids.clear();
+    Renumber();
+}
+
+void CoordArray::Swap(CoordArray& other) {
+    std::swap(ids, other.ids);
+    std::swap(starts, other.starts);
+    std::swap(byAddress, other.byAddress);
+    std::swap(size, other.size);
+}
+
+std::size_t CoordArray::Size() const {
+    return size;
+}
+
+std::size_t CoordArray::ChunkCount() const {
+    return ids.size();
+}
+
+std::size_t CoordArray::ChunkSize(std::size_t chunk) const {
+    return Directory::capacities[ids[chunk]];
+}
+
+Math::Vec3* CoordArray::CoChunk(std::size_t chunk) const {
+    return coChunks[ids[chunk]];
+}
+
+Math::Vec3* CoordArray::NoChunk(std::size_t chunk) const {
+    return noChunks[ids[chunk]];
+}
+
+std::size_t CoordArray::ChunkStart(std::size_t chunk) const {
+    return starts[chunk];
+}
+
+std::size_t CoordArray::MemoryUsage() const {
+    return size * 2 * sizeof(Math::Vec3) + ids.capacity() * sizeof(uint32_t) + starts.capacity() * sizeof(std::size_t)
+           + byAddress.capacity() * sizeof(std::size_t);
+}
+
+std::size_t CoordArray::SlotOf(const Math::Vec3* co) const {
+    // find the last chunk which starts at or before co
+    auto it = std::upper_bound(byAddress.begin(), byAddress.end(), co, [this](const Math::Vec3* lhs, std::size_t rhs) {
+        return std::less<const Math::Vec3*>()(lhs, coChunks[ids[rhs]]);
+    });
+    --it;
+    return starts[*it] + static_cast<std::size_t>(co - coChunks[ids[*it]]);
+}
+
+} // namespace Core
+} // namespace Aoba
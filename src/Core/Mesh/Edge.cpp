@@ -1,5 +1,6 @@
 #include "AobaAPI/Core/Mesh/Edge.hpp"
 
+#include "AobaAPI/Core/Mesh/Face.hpp"
 #include "AobaAPI/Core/Mesh/Loop.hpp"
 #include "AobaAPI/Core/Mesh/Vert.hpp"
 
@@ -13,6 +14,7 @@ Edge::Edge() {
     index = 0;
     flags = 0;
     flagsIntern = 0;
+    visited = 0;
     v1 = nullptr;
     v2 = nullptr;
     l = nullptr;
@@ -20,9 +22,10 @@ Edge::Edge() {
     v1Prev = nullptr;
     v2Next = nullptr;
     v2Prev = nullptr;
-    m = nullptr;
     mNext = nullptr;
     mPrev = nullptr;
+    slot = SlotDirectory<Edge>::NULL_SLOT;
+    classBits = 0;
 }
 
 Edge* Edge::Next(const Vert* v) const {
@@ -51,8 +54,8 @@ Edge* Edge::Prev(const Vert* v) const {
 
     Loop* current = loop->fPrev;
     do {
-        Math::Vec3& vc = current->v->co;
-        Math::Vec3& vn = current->fNext->v->co;
+        Math::Vec3& vc = current->v->Co();
+        Math::Vec3& vn = current->fNext->v->Co();
         result.x += (vc.y - vn.y) * (vc.z + vn.z);
         result.y += (vc.z - vn.z) * (vc.x + vn.x);
         result.z += (vc.x - vn.x) * (vc.y + vn.y);
@@ -60,8 +63,8 @@ Edge* Edge::Prev(const Vert* v) const {
     } while(current != loop->fNext->fNext);
     //if face is not triangular, additional iteration to make a quad
     if(loop->fNext->fNext != loop->fPrev) {
-        Math::Vec3& vc = loop->fNext->fNext->v->co;
-        Math::Vec3& vn = loop->fPrev->v->co;
+        Math::Vec3& vc = loop->fNext->fNext->v->Co();
+        Math::Vec3& vn = loop->fPrev->v->Co();
         result.x += (vc.y - vn.y) * (vc.z + vn.z);
         result.y += (vc.z - vn.z) * (vc.x + vn.x);
         result.z += (vc.x - vn.x) * (vc.y + vn.y);
@@ -94,7 +97,7 @@ float Edge::CalcFaceAngleSigned() const {
     Math::Vec3 no2 = CalcLocalNormal(l->eNext);
 
     Math::Vec3 cross = no1.Cross(no2);
-    Math::Vec3 dir = l->fNext->v->co - l->v->co;
+    Math::Vec3 dir = l->fNext->v->Co() - l->v->Co();
 
     if(dir.Dot(cross) > 0.0f) {
         return no1.Angle(no2);
@@ -104,7 +107,7 @@ float Edge::CalcFaceAngleSigned() const {
 }
 
 float Edge::CalcLength() const {
-    return (this->v1->co - this->v2->co).Magnitude();
+    return (this->v1->Co() - this->v2->Co()).Magnitude();
 }
 
 Vert* Edge::Other(const Vert* v) const {
@@ -128,6 +131,9 @@ bool Edge::IsBoundary() const {
 }
 
 bool Edge::IsContigous() const {
+    if(classBits & CLASS_VALID) {
+        return (classBits & CLASS_CONTIGOUS) != 0;
+    }
     if(this->l == nullptr) {
         return true; // wire edge
     }
@@ -154,6 +160,9 @@ bool Edge::IsContigous() const {
 }
 
 bool Edge::IsManifold() const {
+    if(classBits & CLASS_VALID) {
+        return (classBits & CLASS_MANIFOLD) != 0;
+    }
     if(this->l == nullptr) {
         return false; // wire edge
     }
@@ -219,48 +228,12 @@ const std::vector<Vert*> Edge::Verts() const {
     return std::vector<Vert*> {this->v1, this->v2};
 }
 
-const std::vector<Face*> Edge::Faces(std::function<bool(const Face* const)> func) const {
-    std::vector<Face*> result = std::vector<Face*>();
-    if(this->l == nullptr) {
-        return result;
-    }
-
-    Loop* currentLoop = this->l;
-    do {
-        if(func(currentLoop->f)) {
-            result.push_back(currentLoop->f);
-        }
-        currentLoop = currentLoop->eNext;
-    } while(currentLoop != this->l);
-    return result;
+EdgeFaceRange Edge::FaceRange() const {
+    return EdgeFaceRange(EdgeFaceIterator(l), EdgeFaceIterator());
 }
 
-const std::vector<Loop*> Edge::Loops(std::function<bool(const Loop* const)> func) const {
-    std::vector<Loop*> result = std::vector<Loop*>();
-    if(this->l == nullptr) {
-        return result;
-    }
-
-    Loop* currentLoop = this->l;
-    do {
-        if(func(currentLoop)) {
-            result.push_back(currentLoop);
-        }
-        currentLoop = currentLoop->eNext;
-    } while(currentLoop != this->l);
-    return result;
-}
-
-const std::vector<Vert*> Edge::Verts(std::function<bool(const Vert* const)> func) const {
-    std::vector<Vert*> result = std::vector<Vert*>();
-
-    if(func(v1)) {
-        result.push_back(v1);
-    }
-    if(func(v2)) {
-        result.push_back(v2);
-    }
-    return result;
+EdgeLoopRange Edge::LoopRange() const {
+    return EdgeLoopRange(EdgeLoopIterator(l), EdgeLoopIterator());
 }
 
 Vert* Edge::V1() const {
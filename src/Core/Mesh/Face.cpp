@@ -11,12 +11,13 @@ namespace Core {
 
 Face::Face() {
     l = nullptr;
-    m = nullptr;
     mNext = nullptr;
     mPrev = nullptr;
+    slot = SlotDirectory<Face>::NULL_SLOT;
     index = 0;
     flags = 0;
     flagsIntern = 0;
+    visited = 0;
     materialIdx = 0;
 }
 
@@ -31,7 +32,7 @@ Math::Vec3 Face::CalcCenterAverage() const {
     std::vector<Vert*> faceVerts = Verts();
     Math::Vec3 result = Math::Vec3();
     for(int i = 0; i < faceVerts.size(); i++) {
-        result += faceVerts.at(i)->co;
+        result += faceVerts.at(i)->Co();
     }
     result /= float(faceVerts.size());
     return result;
@@ -70,8 +71,8 @@ void Face::NormalUpdate() {
 
     Loop* current = l;
     do {
-        Math::Vec3& vc = current->v->co;
-        Math::Vec3& vn = current->fNext->v->co;
+        Math::Vec3& vc = current->v->Co();
+        Math::Vec3& vn = current->fNext->v->Co();
         no.x += (vc.y - vn.y) * (vc.z + vn.z);
         no.y += (vc.z - vn.z) * (vc.x + vn.x);
         no.z += (vc.x - vn.x) * (vc.y + vn.y);
@@ -120,51 +121,16 @@ const std::vector<Loop*> Face::Loops() const {
     return result;
 }
 
-const std::vector<Edge*> Face::Edges(std::function<bool(const Edge* const)> func) const {
-    std::vector<Edge*> result = std::vector<Edge*>();
-    // iterate over all loops in face
-    Loop* currentLoop = l;
-    do {
-        if(func(currentLoop->e)) {
-            if(std::find(result.begin(), result.end(), currentLoop->e) == result.end()) { // check if already added
-                result.push_back(currentLoop->e);
-            }
-        }
-        currentLoop = currentLoop->fNext;
-    } while(currentLoop != l);
-    return result;
+FaceEdgeRange Face::EdgeRange() const {
+    return FaceEdgeRange(FaceEdgeIterator(l), FaceEdgeIterator());
 }
 
-const std::vector<Vert*> Face::Verts(std::function<bool(const Vert* const)> func) const {
-    std::vector<Vert*> result = std::vector<Vert*>();
-    // iterate over all loops in current list
-    Loop* currentLoop = l;
-    do {
-        if(func(currentLoop->v)) {
-            if(std::find(result.begin(), result.end(), currentLoop->v) == result.end()) { // check if already added
-                result.push_back(currentLoop->v);
-            }
-        }
-        currentLoop = currentLoop->fNext;
-    } while(currentLoop != l);
-    return result;
+FaceVertRange Face::VertRange() const {
+    return FaceVertRange(FaceVertIterator(l), FaceVertIterator());
 }
 
-const std::vector<Loop*> Face::Loops(std::function<bool(const Loop* const)> func) const {
-    std::vector<Loop*> result = std::vector<Loop*>();
-    Loop* current = l;
-
-    if(func(current)) {
-        result.push_back(current);
-    }
-    while(current->fNext != l) {
-        current = current->fNext;
-        if(func(current)) {
-            result.push_back(current);
-        }
-    }
-
-    return result;
+FaceLoopRange Face::LoopRange() const {
+    return FaceLoopRange(FaceLoopIterator(l), FaceLoopIterator());
 }
 
 } // namespace Core
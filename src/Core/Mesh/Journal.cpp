@@ -0,0 +1,47 @@
+#include "AobaAPI/Core/Mesh/Journal.hpp"
+
+namespace Aoba {
+namespace Core {
+
+JournalStep::JournalStep() {
+    meshVerts = nullptr;
+    meshEdges = nullptr;
+    meshFaces = nullptr;
+    meshVertCount = 0;
+    meshEdgeCount = 0;
+    meshFaceCount = 0;
+}
+
+bool JournalStep::IsEmpty() const {
+    return verts.empty() && edges.empty() && faces.empty() && loops.empty();
+}
+
+std::size_t JournalStep::MemoryUsage() const {
+    return sizeof(JournalStep) + verts.capacity() * sizeof(JournalRecord<Vert>)
+           + edges.capacity() * sizeof(JournalRecord<Edge>) + faces.capacity() * sizeof(JournalRecord<Face>)
+           + loops.capacity() * sizeof(JournalRecord<Loop>);
+}
+
+MeshJournal::MeshJournal() {
+    applied = 0;
+    memory = 0;
+}
+
+std::vector<JournalRecord<Vert>>& MeshJournal::Records(JournalStep& step, const Vert*) {
+    return step.verts;
+}
+
+std::vector<JournalRecord<Edge>>& MeshJournal::Records(JournalStep& step, const Edge*) {
+    return step.edges;
+}
+
+std::vector<JournalRecord<Face>>& MeshJournal::Records(JournalStep& step, const Face*) {
+    return step.faces;
+}
+
+std::vector<JournalRecord<Loop>>& MeshJournal::Records(JournalStep& step, const Loop*) {
+    return step.loops;
+}
+
+} // namespace Core
+} // namespace Aoba
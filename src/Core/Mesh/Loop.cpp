@@ -3,6 +3,7 @@
 #include "AobaAPI/Core/Mesh/Loop.hpp"
 
 #include "AobaAPI/Core/Mesh/Edge.hpp"
+#include "AobaAPI/Core/Mesh/Face.hpp"
 #include "AobaAPI/Core/Mesh/Vert.hpp"
 
 #include <stdexcept>
@@ -22,6 +23,7 @@ Loop::Loop() {
     index = 0;
     flags = 0;
     flagsIntern = 0;
+    visited = 0;
     v = nullptr;
     e = nullptr;
     f = nullptr;
@@ -29,12 +31,20 @@ Loop::Loop() {
     ePrev = nullptr;
     fNext = nullptr;
     fPrev = nullptr;
-    m = nullptr;
+    slot = SlotDirectory<Loop>::NULL_SLOT;
 }
 
 Face* Loop::LoopFace() const {
     return f;
 }
 
+Loop* Loop::FaceNext() const {
+    return fNext;
+}
+
+Loop* Loop::FacePrev() const {
+    return fPrev;
+}
+
 } // namespace Core
 } // namespace Aoba
\ No newline at end of file
@@ -1,157 +1,1890 @@
 #include "AobaAPI/Core/Mesh/Mesh.hpp"
 
+#include "AobaAPI/Core/Mesh/Changes.hpp"
 #include "AobaAPI/Core/Mesh/Edge.hpp"
 #include "AobaAPI/Core/Mesh/Face.hpp"
+#include "AobaAPI/Core/Mesh/Journal.hpp"
 #include "AobaAPI/Core/Mesh/Loop.hpp"
 #include "AobaAPI/Core/Mesh/Vert.hpp"
+#include "AobaAPI/Core/Mesh/Visit.hpp"
+#include "AobaAPI/Core/Parallel.hpp"
 #include "AobaAPI/Math/Matrix/Matrix3.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
 namespace Aoba {
 namespace Core {
 
-Mesh::Mesh() {
-    edges = nullptr;
-    verts = nullptr;
-    faces = nullptr;
+namespace {
+
+// number of bits per axis used by space filling curve keys
+const int CURVE_BITS = 21;
+
+// spread the lowest 21 bits of x, leaving two zero bits between each of them
+uint64_t SpreadBits(uint64_t x) {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+}
+
+uint64_t MortonKey(uint32_t x, uint32_t y, uint32_t z) {
+    return SpreadBits(x) << 2 | SpreadBits(y) << 1 | SpreadBits(z);
+}
+
+uint64_t HilbertKey(uint32_t x, uint32_t y, uint32_t z) {
+    // convert the coordinates to the transposed hilbert index, see J. Skilling, "Programming the Hilbert curve"
+    uint32_t axes[3] = {x, y, z};
+    for(uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+        uint32_t p = q - 1;
+        for(int i = 0; i < 3; ++i) {
+            if(axes[i] & q) {
+                axes[0] ^= p;
+            } else {
+                uint32_t t = (axes[0] ^ axes[i]) & p;
+                axes[0] ^= t;
+                axes[i] ^= t;
+            }
+        }
+    }
+    axes[1] ^= axes[0];
+    axes[2] ^= axes[1];
+    uint32_t t = 0;
+    for(uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+        if(axes[2] & q) {
+            t ^= q - 1;
+        }
+    }
+    for(int i = 0; i < 3; ++i) {
+        axes[i] ^= t;
+    }
+    // the bits of the transposed index are interleaved the same way as a morton key
+    return MortonKey(axes[0], axes[1], axes[2]);
+}
+
+// compares elements by their curve key only
+struct KeyLess {
+    template<typename T>
+    bool operator()(const std::pair<uint64_t, T>& lhs, const std::pair<uint64_t, T>& rhs) const {
+        return lhs.first < rhs.first;
+    }
+};
+
+// a cycle of distinct items, walked from its smallest item towards the smaller of its neighbors, so that all
+// rotations and both orientations of the same cycle are walked in the same order
+template<typename T>
+class CanonicalCycle {
+  public:
+    CanonicalCycle(const T* items, std::size_t size) : items(items), size(size), start(0), forward(true) {
+        std::less<T> less = std::less<T>();
+        for(std::size_t i = 1; i < size; ++i) {
+            if(less(items[i], items[start])) {
+                start = i;
+            }
+        }
+        forward = less(items[(start + 1) % size], items[(start + size - 1) % size]);
+    }
+
+    const T& operator[](std::size_t i) const {
+        return forward ? items[(start + i) % size] : items[(start + size - i) % size];
+    }
+
+    bool operator==(const CanonicalCycle& other) const {
+        if(size != other.size) {
+            return false;
+        }
+        for(std::size_t i = 0; i < size; ++i) {
+            if((*this)[i] != other[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t Hash() const {
+        std::hash<T> hash = std::hash<T>();
+        std::size_t result = size;
+        for(std::size_t i = 0; i < size; ++i) {
+            result = result * 0x9e3779b97f4a7c15ULL + hash((*this)[i]);
+        }
+        return result;
+    }
+
+    struct Hasher {
+        std::size_t operator()(const CanonicalCycle& cycle) const {
+            return cycle.Hash();
+        }
+    };
+
+  private:
+    const T* items;
+    std::size_t size;
+    std::size_t start;
+    bool forward;
+};
+
+// run check(element, issues) for all elements on multiple threads. elements are split into blocks, which collect their
+// issues separately, so that the report does not depend on the number of threads
+template<typename T, typename Func>
+std::vector<MeshValidationIssue> ValidateBlocks(const std::vector<T*>& elements, Func check) {
+    const std::size_t BLOCK_SIZE = 1024;
+    const std::size_t blockCount = (elements.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<std::vector<MeshValidationIssue>> blockIssues =
+        std::vector<std::vector<MeshValidationIssue>>(blockCount);
+    ParallelFor(blockCount, 4, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t block = begin; block < end; ++block) {
+            const std::size_t last = std::min(elements.size(), (block + 1) * BLOCK_SIZE);
+            for(std::size_t i = block * BLOCK_SIZE; i < last; ++i) {
+                check(elements[i], blockIssues[block]);
+            }
+        }
+    });
+
+    std::vector<MeshValidationIssue> result = std::vector<MeshValidationIssue>();
+    for(const std::vector<MeshValidationIssue>& issues : blockIssues) {
+        result.insert(result.end(), issues.begin(), issues.end());
+    }
+    return result;
+}
+
+// exchange the recorded contents of all elements with their current contents
+template<typename T>
+void SwapRecords(std::vector<JournalRecord<T>>& records) {
+    for(JournalRecord<T>& record : records) {
+        T current = *record.element;
+        *record.element = record.image;
+        record.image = current;
+    }
+}
+
+// invalidate the handles of recorded elements which are killed by undoing or redoing their step, and restore the
+// handles of elements which are brought back
+template<typename T>
+void RetireRecords(std::vector<JournalRecord<T>>& records, ElementPool<T>& pool, bool undo) {
+    for(JournalRecord<T>& record : records) {
+        bool aliveNow = undo ? record.aliveBefore : record.aliveAfter;
+        bool aliveThen = undo ? record.aliveAfter : record.aliveBefore;
+        if(aliveThen && !aliveNow) {
+            pool.Retire(record.element);
+        } else if(aliveNow && !aliveThen) {
+            pool.Revive(record.element);
+        }
+    }
+}
+
+// return the storage of recorded elements which are not part of the mesh on the given side of their step
+template<typename T>
+void FreeRecords(std::vector<JournalRecord<T>>& records, ElementPool<T>& pool, bool after) {
+    for(JournalRecord<T>& record : records) {
+        if(!(after ? record.aliveAfter : record.aliveBefore)) {
+            pool.Free(record.element);
+        }
+    }
+}
+
+// remove records of elements which were created and killed within the same step, and release their storage
+template<typename T>
+void DropTransient(std::vector<JournalRecord<T>>& records, ElementPool<T>& pool) {
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < records.size(); ++i) {
+        if(!records[i].aliveBefore && !records[i].aliveAfter) {
+            pool.Free(records[i].element);
+            continue;
+        }
+        if(kept != i) {
+            records[kept] = records[i];
+        }
+        ++kept;
+    }
+    records.erase(records.begin() + kept, records.end());
+    records.shrink_to_fit();
+}
+
+// dense numbers of elements, looked up by slot. slots are dense inside a block, so every block in use gets a range
+// of the table which starts at the base of its id. the elements themselves are not touched
+template<typename T>
+class SlotNumbers {
+  private:
+    typedef SlotDirectory<T> Directory;
+
+    uint32_t firstId;              // smallest block id in use
+    std::vector<uint32_t> bases;   // start of the range of every block id from firstId on
+    std::vector<uint32_t> numbers; // number of the element in every slot
+
+  public:
+    // number the slots in the given order
+    explicit SlotNumbers(const std::vector<uint32_t>& slots) : firstId(0) {
+        if(slots.empty()) {
+            return;
+        }
+        const uint32_t UNUSED = UINT32_MAX;
+        firstId = slots.front() >> Directory::BITS;
+        uint32_t lastId = firstId;
+        for(uint32_t slot : slots) {
+            firstId = std::min(firstId, slot >> Directory::BITS);
+            lastId = std::max(lastId, slot >> Directory::BITS);
+        }
+        bases.assign(lastId - firstId + 1, UNUSED);
+        for(uint32_t slot : slots) {
+            bases[(slot >> Directory::BITS) - firstId] = 0;
+        }
+        uint32_t total = 0;
+        for(std::size_t i = 0; i < bases.size(); ++i) {
+            if(bases[i] != UNUSED) {
+                bases[i] = total;
+                total += Directory::capacities[firstId + i];
+            }
+        }
+        numbers.resize(total);
+        for(std::size_t i = 0; i < slots.size(); ++i) {
+            numbers[bases[(slots[i] >> Directory::BITS) - firstId] + (slots[i] & Directory::MASK)] =
+                static_cast<uint32_t>(i);
+        }
+    }
+
+    uint32_t operator[](uint32_t slot) const {
+        return numbers[bases[(slot >> Directory::BITS) - firstId] + (slot & Directory::MASK)];
+    }
+};
+
+} // namespace
+
+Mesh::Mesh() : vertPool(this), edgePool(this), facePool(this), loopPool(this) {
+    edges = nullptr;
+    verts = nullptr;
+    faces = nullptr;
+    vertCount = 0;
+    edgeCount = 0;
+    faceCount = 0;
+    generation = 0;
+    edgeIndexEnabled = false;
+    coordArraysEnabled = false;
+    classificationEnabled = false;
+    journal = nullptr;
+    journalLimit = MeshJournal::DEFAULT_MEMORY_LIMIT;
+    changes = nullptr;
+}
+
+Mesh::~Mesh() {
+    // element storage is released by the pools, the journal and change tracking only release their records
+    EnableJournal(false);
+    EnableChangeTracking(false);
+}
+
+Vert* Mesh::NewVert() {
+    Vert* v = vertPool.Allocate();
+    if(coordArraysEnabled) {
+        // the slot may still hold the coordinates of a killed vert
+        coordArray.Attach(v->slot >> SlotDirectory<Vert>::BITS);
+        v->Co() = Math::Vec3();
+        v->No() = Math::Vec3();
+    }
+    return v;
+}
+
+Edge* Mesh::NewEdge() {
+    return edgePool.Allocate();
+}
+
+Face* Mesh::NewFace() {
+    return facePool.Allocate();
+}
+
+Loop* Mesh::NewLoop() {
+    return loopPool.Allocate();
+}
+
+Mesh* Mesh::Clone() const {
+    MeshCloneMap map = MeshCloneMap();
+    return Clone(&map);
+}
+
+Mesh* Mesh::Clone(MeshCloneMap* map) const {
+    Mesh* clone = new Mesh();
+    CopyElements(clone, map);
+    clone->generation = generation;
+    clone->EnableEdgeIndex(edgeIndexEnabled);
+    // copies carry the classification bits of the originals
+    clone->classificationEnabled = classificationEnabled;
+    return clone;
+}
+
+void Mesh::CopyElements(Mesh* target, MeshCloneMap* map) const {
+    const std::size_t GRAIN_SIZE = 16384;
+
+    // number all elements by slot, so that pointers can be remapped without writing to the originals
+    std::vector<Vert*> srcVerts = std::vector<Vert*>();
+    std::vector<uint32_t> vertSlots = std::vector<uint32_t>();
+    srcVerts.reserve(vertCount);
+    vertSlots.reserve(vertCount);
+    for(Vert* vert : VertRange()) {
+        srcVerts.push_back(vert);
+        vertSlots.push_back(vert->slot);
+    }
+    std::vector<Edge*> srcEdges = std::vector<Edge*>();
+    std::vector<uint32_t> edgeSlots = std::vector<uint32_t>();
+    srcEdges.reserve(edgeCount);
+    edgeSlots.reserve(edgeCount);
+    for(Edge* edge : EdgeRange()) {
+        srcEdges.push_back(edge);
+        edgeSlots.push_back(edge->slot);
+    }
+    std::vector<Face*> srcFaces = std::vector<Face*>();
+    std::vector<uint32_t> faceSlots = std::vector<uint32_t>();
+    srcFaces.reserve(faceCount);
+    faceSlots.reserve(faceCount);
+    std::vector<Loop*> srcLoops = std::vector<Loop*>();
+    std::vector<uint32_t> loopSlots = std::vector<uint32_t>();
+    for(Face* face : FaceRange()) {
+        srcFaces.push_back(face);
+        faceSlots.push_back(face->slot);
+        for(Loop* loop : face->LoopRange()) {
+            srcLoops.push_back(loop);
+            loopSlots.push_back(loop->slot);
+        }
+    }
+    const SlotNumbers<Vert> vertNumbers = SlotNumbers<Vert>(vertSlots);
+    const SlotNumbers<Edge> edgeNumbers = SlotNumbers<Edge>(edgeSlots);
+    const SlotNumbers<Face> faceNumbers = SlotNumbers<Face>(faceSlots);
+    const SlotNumbers<Loop> loopNumbers = SlotNumbers<Loop>(loopSlots);
+
+    // allocation is not thread safe, create all elements up front
+    target->Reserve(srcVerts.size(), srcEdges.size(), srcFaces.size(), srcLoops.size());
+    map->verts.resize(srcVerts.size());
+    target->coordArraysEnabled = coordArraysEnabled;
+    for(std::size_t i = 0; i < srcVerts.size(); ++i) {
+        map->verts[i] = target->NewVert();
+    }
+    map->edges.resize(srcEdges.size());
+    for(std::size_t i = 0; i < srcEdges.size(); ++i) {
+        map->edges[i] = target->NewEdge();
+    }
+    map->faces.resize(srcFaces.size());
+    for(std::size_t i = 0; i < srcFaces.size(); ++i) {
+        map->faces[i] = target->NewFace();
+    }
+    map->loops.resize(srcLoops.size());
+    for(std::size_t i = 0; i < srcLoops.size(); ++i) {
+        map->loops[i] = target->NewLoop();
+    }
+
+    // copy all attributes, then redirect the links into the copies. the copies keep their own slots.
+    // every element is written by exactly one chunk, the originals are only read.
+    std::vector<Vert*>& newVerts = map->verts;
+    std::vector<Edge*>& newEdges = map->edges;
+    std::vector<Face*>& newFaces = map->faces;
+    std::vector<Loop*>& newLoops = map->loops;
+
+    ParallelFor(srcVerts.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Vert* vert = newVerts[i];
+            uint32_t slot = vert->slot;
+            *vert = *srcVerts[i];
+            vert->slot = slot;
+            // coordinates stored in the coordinate arrays are not part of the vert
+            vert->Co() = srcVerts[i]->Co();
+            vert->No() = srcVerts[i]->No();
+            vert->e = vert->e == nullptr ? nullptr : newEdges[edgeNumbers[vert->e->slot]];
+            vert->mNext = newVerts[vertNumbers[vert->mNext->slot]];
+            vert->mPrev = newVerts[vertNumbers[vert->mPrev->slot]];
+        }
+    });
+
+    ParallelFor(srcEdges.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Edge* edge = newEdges[i];
+            uint32_t slot = edge->slot;
+            *edge = *srcEdges[i];
+            edge->slot = slot;
+            edge->v1 = newVerts[vertNumbers[edge->v1->slot]];
+            edge->v2 = newVerts[vertNumbers[edge->v2->slot]];
+            edge->l = edge->l == nullptr ? nullptr : newLoops[loopNumbers[edge->l->slot]];
+            edge->v1Next = newEdges[edgeNumbers[edge->v1Next->slot]];
+            edge->v1Prev = newEdges[edgeNumbers[edge->v1Prev->slot]];
+            edge->v2Next = newEdges[edgeNumbers[edge->v2Next->slot]];
+            edge->v2Prev = newEdges[edgeNumbers[edge->v2Prev->slot]];
+            edge->mNext = newEdges[edgeNumbers[edge->mNext->slot]];
+            edge->mPrev = newEdges[edgeNumbers[edge->mPrev->slot]];
+        }
+    });
+
+    ParallelFor(srcFaces.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Face* face = newFaces[i];
+            uint32_t slot = face->slot;
+            *face = *srcFaces[i];
+            face->slot = slot;
+            face->l = newLoops[loopNumbers[face->l->slot]];
+            face->mNext = newFaces[faceNumbers[face->mNext->slot]];
+            face->mPrev = newFaces[faceNumbers[face->mPrev->slot]];
+        }
+    });
+
+    ParallelFor(srcLoops.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Loop* loop = newLoops[i];
+            uint32_t slot = loop->slot;
+            *loop = *srcLoops[i];
+            loop->slot = slot;
+            loop->v = newVerts[vertNumbers[loop->v->slot]];
+            loop->e = newEdges[edgeNumbers[loop->e->slot]];
+            loop->f = newFaces[faceNumbers[loop->f->slot]];
+            loop->eNext = newLoops[loopNumbers[loop->eNext->slot]];
+            loop->ePrev = newLoops[loopNumbers[loop->ePrev->slot]];
+            loop->fNext = newLoops[loopNumbers[loop->fNext->slot]];
+            loop->fPrev = newLoops[loopNumbers[loop->fPrev->slot]];
+        }
+    });
+
+    target->verts = newVerts.empty() ? nullptr : newVerts.front();
+    target->edges = newEdges.empty() ? nullptr : newEdges.front();
+    target->faces = newFaces.empty() ? nullptr : newFaces.front();
+    target->vertCount = newVerts.size();
+    target->edgeCount = newEdges.size();
+    target->faceCount = newFaces.size();
+}
+
+void Mesh::Reorder(ReorderStrategy strategy) {
+    std::vector<Vert*> vertOrder = std::vector<Vert*>();
+    std::vector<Edge*> edgeOrder = std::vector<Edge*>();
+    std::vector<Face*> faceOrder = std::vector<Face*>();
+    vertOrder.reserve(vertCount);
+    edgeOrder.reserve(edgeCount);
+    faceOrder.reserve(faceCount);
+
+    if(strategy == ReorderStrategy::BreadthFirst) {
+        // visit faces breadth first over shared edges, verts and edges are ordered by the first face using them
+        const uint32_t gen = NewGeneration();
+        for(Face* seed : FaceRange()) {
+            if(IsMarked(seed, gen)) {
+                continue;
+            }
+            Mark(seed, gen);
+            std::size_t next = faceOrder.size();
+            faceOrder.push_back(seed);
+            while(next < faceOrder.size()) {
+                Face* face = faceOrder[next];
+                ++next;
+                for(Loop* loop : face->LoopRange()) {
+                    Vert* vert = loop->v;
+                    Edge* edge = loop->e;
+                    if(!IsMarked(vert, gen)) {
+                        Mark(vert, gen);
+                        vertOrder.push_back(vert);
+                    }
+                    if(!IsMarked(edge, gen)) {
+                        Mark(edge, gen);
+                        edgeOrder.push_back(edge);
+                    }
+                    for(Loop* radial : edge->LoopRange()) {
+                        Face* other = radial->f;
+                        if(!IsMarked(other, gen)) {
+                            Mark(other, gen);
+                            faceOrder.push_back(other);
+                        }
+                    }
+                }
+            }
+        }
+        // wire edges and isolated verts keep their relative order, after all face elements
+        for(Edge* edge : EdgeRange()) {
+            if(!IsMarked(edge, gen)) {
+                edgeOrder.push_back(edge);
+            }
+        }
+        for(Vert* vert : VertRange()) {
+            if(!IsMarked(vert, gen)) {
+                vertOrder.push_back(vert);
+            }
+        }
+    } else {
+        // quantize coordinates inside the bounding box of the mesh
+        Math::Vec3 min = verts == nullptr ? Math::Vec3() : verts->Co();
+        Math::Vec3 max = min;
+        for(Vert* vert : VertRange()) {
+            for(std::size_t axis = 0; axis < 3; ++axis) {
+                min(axis) = std::min(min(axis), vert->Co()(axis));
+                max(axis) = std::max(max(axis), vert->Co()(axis));
+            }
+        }
+        Math::Vec3 scale = Math::Vec3();
+        const float CELLS = static_cast<float>((1u << CURVE_BITS) - 1);
+        for(std::size_t axis = 0; axis < 3; ++axis) {
+            scale(axis) = max(axis) > min(axis) ? CELLS / (max(axis) - min(axis)) : 0.0f;
+        }
+        auto key = [&](const Math::Vec3& co) {
+            uint32_t cell[3];
+            for(std::size_t axis = 0; axis < 3; ++axis) {
+                float value = (co(axis) - min(axis)) * scale(axis);
+                cell[axis] = static_cast<uint32_t>(std::min(std::max(value, 0.0f), CELLS));
+            }
+            if(strategy == ReorderStrategy::Morton) {
+                return MortonKey(cell[0], cell[1], cell[2]);
+            }
+            return HilbertKey(cell[0], cell[1], cell[2]);
+        };
+
+        // elements with equal keys keep their relative order
+        std::vector<std::pair<uint64_t, Vert*>> vertKeys = std::vector<std::pair<uint64_t, Vert*>>();
+        vertKeys.reserve(vertCount);
+        for(Vert* vert : VertRange()) {
+            vertKeys.push_back(std::make_pair(key(vert->Co()), vert));
+        }
+        std::vector<std::pair<uint64_t, Edge*>> edgeKeys = std::vector<std::pair<uint64_t, Edge*>>();
+        edgeKeys.reserve(edgeCount);
+        for(Edge* edge : EdgeRange()) {
+            edgeKeys.push_back(std::make_pair(key((edge->v1->Co() + edge->v2->Co()) / 2), edge));
+        }
+        std::vector<std::pair<uint64_t, Face*>> faceKeys = std::vector<std::pair<uint64_t, Face*>>();
+        faceKeys.reserve(faceCount);
+        for(Face* face : FaceRange()) {
+            faceKeys.push_back(std::make_pair(key(face->CalcCenterAverage()), face));
+        }
+
+        std::stable_sort(vertKeys.begin(), vertKeys.end(), KeyLess());
+        std::stable_sort(edgeKeys.begin(), edgeKeys.end(), KeyLess());
+        std::stable_sort(faceKeys.begin(), faceKeys.end(), KeyLess());
+        for(const std::pair<uint64_t, Vert*>& vertKey : vertKeys) {
+            vertOrder.push_back(vertKey.second);
+        }
+        for(const std::pair<uint64_t, Edge*>& edgeKey : edgeKeys) {
+            edgeOrder.push_back(edgeKey.second);
+        }
+        for(const std::pair<uint64_t, Face*>& faceKey : faceKeys) {
+            faceOrder.push_back(faceKey.second);
+        }
+    }
+
+    // relink the lists in the new order
+    for(std::size_t i = 0; i < vertOrder.size(); ++i) {
+        vertOrder[i]->mNext = vertOrder[i + 1 < vertOrder.size() ? i + 1 : 0];
+        vertOrder[i]->mPrev = vertOrder[i > 0 ? i - 1 : vertOrder.size() - 1];
+    }
+    for(std::size_t i = 0; i < edgeOrder.size(); ++i) {
+        edgeOrder[i]->mNext = edgeOrder[i + 1 < edgeOrder.size() ? i + 1 : 0];
+        edgeOrder[i]->mPrev = edgeOrder[i > 0 ? i - 1 : edgeOrder.size() - 1];
+    }
+    for(std::size_t i = 0; i < faceOrder.size(); ++i) {
+        faceOrder[i]->mNext = faceOrder[i + 1 < faceOrder.size() ? i + 1 : 0];
+        faceOrder[i]->mPrev = faceOrder[i > 0 ? i - 1 : faceOrder.size() - 1];
+    }
+    verts = vertOrder.empty() ? nullptr : vertOrder.front();
+    edges = edgeOrder.empty() ? nullptr : edgeOrder.front();
+    faces = faceOrder.empty() ? nullptr : faceOrder.front();
+
+    // move the elements into storage which follows the new list order
+    Compact(0.0f);
+}
+
+float Mesh::FreeStorageRatio() const {
+    // storage which was never used, like reserved storage, is neither counted as used nor as freed
+    std::size_t unused = vertPool.Available() + edgePool.Available() + facePool.Available() + loopPool.Available();
+    std::size_t freed = vertPool.Freed() + edgePool.Freed() + facePool.Freed() + loopPool.Freed();
+    std::size_t used = vertPool.Capacity() + edgePool.Capacity() + facePool.Capacity() + loopPool.Capacity()
+        - (unused - freed);
+    if(used == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(freed) / static_cast<float>(used);
+}
+
+bool Mesh::Compact(float threshold) {
+    if(FreeStorageRatio() < threshold) {
+        return false;
+    }
+
+    // copy all elements into fresh storage in list order
+    Mesh storage;
+    MeshCloneMap map = MeshCloneMap();
+    CopyElements(&storage, &map);
+
+    // release the old elements, then take over the fresh storage.
+    // the old storage is released along with the temporary mesh
+    Clear();
+    vertPool.Swap(storage.vertPool);
+    edgePool.Swap(storage.edgePool);
+    facePool.Swap(storage.facePool);
+    loopPool.Swap(storage.loopPool);
+    coordArray.Swap(storage.coordArray);
+
+    verts = storage.verts;
+    edges = storage.edges;
+    faces = storage.faces;
+    vertCount = storage.vertCount;
+    edgeCount = storage.edgeCount;
+    faceCount = storage.faceCount;
+
+    if(edgeIndexEnabled) {
+        edgeIndexEnabled = false;
+        EnableEdgeIndex(true);
+    }
+    return true;
+}
+
+void Mesh::Clear() {
+    if(journal != nullptr) {
+        ResetJournal();
+    }
+    if(changes != nullptr) {
+        changes->Rebuilt();
+    }
+
+    // elements inside the pools are released all at once, without unlinking them
+    verts = nullptr;
+    edges = nullptr;
+    faces = nullptr;
+    vertCount = 0;
+    edgeCount = 0;
+    faceCount = 0;
+    // the index stays enabled, but keeps its buckets for reuse
+    edgeIndex.clear();
+
+    vertPool.Clear();
+    edgePool.Clear();
+    facePool.Clear();
+    loopPool.Clear();
+}
+
+void Mesh::Reserve(std::size_t verts, std::size_t edges, std::size_t faces, std::size_t loops) {
+    vertPool.Reserve(verts);
+    edgePool.Reserve(edges);
+    facePool.Reserve(faces);
+    loopPool.Reserve(loops);
+}
+
+std::size_t Mesh::VertCount() const {
+    return vertCount;
+}
+
+std::size_t Mesh::EdgeCount() const {
+    return edgeCount;
+}
+
+std::size_t Mesh::FaceCount() const {
+    return faceCount;
+}
+
+void Mesh::FromIndexed(const std::vector<float>& positions, const std::vector<std::size_t>& faceOffsets,
+    const std::vector<std::size_t>& faceIndices) {
+    FromIndexed(positions, faceOffsets, faceIndices, std::vector<std::size_t>());
+}
+
+void Mesh::FromIndexed(const std::vector<float>& positions, const std::vector<std::size_t>& faceOffsets,
+    const std::vector<std::size_t>& faceIndices, const std::vector<std::size_t>& edgeIndices) {
+    if(positions.size() % 3 != 0) {
+        throw std::invalid_argument("Number of coordinates must be divisible by three.");
+    }
+    std::size_t numVerts = positions.size() / 3;
+    if(faceOffsets.empty()) {
+        if(!faceIndices.empty()) {
+            throw std::invalid_argument("Face offsets must end with the number of face indices.");
+        }
+    } else if(faceOffsets.front() != 0 || faceOffsets.back() != faceIndices.size()) {
+        throw std::invalid_argument("Face offsets must start at zero and end with the number of face indices.");
+    }
+
+    std::size_t numFaces = faceOffsets.empty() ? 0 : faceOffsets.size() - 1;
+
+    // validate all faces first, so that the mesh is left untouched on failure
+    for(std::size_t i = 0; i < numFaces; ++i) {
+        std::size_t begin = faceOffsets.at(i);
+        std::size_t end = faceOffsets.at(i + 1);
+        if(end < begin || end - begin < 3) {
+            throw std::invalid_argument("Face must have at least 3 distinct edges.");
+        }
+        for(std::size_t j = begin; j < end; ++j) {
+            std::size_t next = j + 1 < end ? j + 1 : begin;
+            if(faceIndices[j] >= numVerts) {
+                throw std::invalid_argument("Face index out of range.");
+            }
+            if(faceIndices[j] == faceIndices[next]) {
+                throw std::invalid_argument("Self-loop edges are not allowed");
+            }
+        }
+    }
+
+    // a face which repeats the verts of an earlier face in the same cyclic order, in either orientation, would be a
+    // double face
+    std::unordered_set<CanonicalCycle<std::size_t>, CanonicalCycle<std::size_t>::Hasher> cycles =
+        std::unordered_set<CanonicalCycle<std::size_t>, CanonicalCycle<std::size_t>::Hasher>();
+    cycles.reserve(numFaces);
+    for(std::size_t i = 0; i < numFaces; ++i) {
+        std::size_t begin = faceOffsets[i];
+        if(!cycles.insert(CanonicalCycle<std::size_t>(faceIndices.data() + begin, faceOffsets[i + 1] - begin)).second) {
+            throw std::invalid_argument("Face repeats the verts of an earlier face.");
+        }
+    }
+
+    if(edgeIndices.size() % 2 != 0) {
+        throw std::invalid_argument("Number of edge indices must be divisible by two.");
+    }
+    for(std::size_t i = 0; i < edgeIndices.size(); i += 2) {
+        if(edgeIndices[i] >= numVerts || edgeIndices[i + 1] >= numVerts) {
+            throw std::invalid_argument("Edge index out of range.");
+        }
+        if(edgeIndices[i] == edgeIndices[i + 1]) {
+            throw std::invalid_argument("Self-loop edges are not allowed");
+        }
+    }
+
+    // a closed mesh has one edge per two face corners, open meshes grow the storage as needed
+    Reserve(numVerts, faceIndices.size() / 2 + edgeIndices.size() / 2, numFaces, faceIndices.size());
+
+    // new elements are appended behind the last element of every list, nothing else is changed
+    if(journal != nullptr) {
+        RecordChange(verts);
+        RecordChange(verts != nullptr ? verts->mPrev : nullptr);
+        RecordChange(edges);
+        RecordChange(edges != nullptr ? edges->mPrev : nullptr);
+        RecordChange(faces);
+        RecordChange(faces != nullptr ? faces->mPrev : nullptr);
+    }
+
+    // create verts, append them to the end of the vert list
+    std::vector<Vert*> newVerts = std::vector<Vert*>();
+    newVerts.reserve(numVerts);
+    for(std::size_t i = 0; i < numVerts; ++i) {
+        Vert* newv = NewVert();
+        RecordCreated(newv);
+        newv->Co() = Math::Vec3(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
+        newv->e = nullptr;
+        if(verts == nullptr) {
+            verts = newv;
+            newv->mNext = newv;
+            newv->mPrev = newv;
+        } else {
+            newv->mPrev = verts->mPrev;
+            newv->mNext = verts;
+            verts->mPrev->mNext = newv;
+            verts->mPrev = newv;
+        }
+        newVerts.push_back(newv);
+    }
+    vertCount += numVerts;
+
+    // add edge to the disk cycle around v, in front of v->e
+    auto linkDisk = [](Vert* v, Edge* e) {
+        Link<Edge>& next = e->v1 == v ? e->v1Next : e->v2Next;
+        Link<Edge>& prev = e->v1 == v ? e->v1Prev : e->v2Prev;
+        if(v->e == nullptr) {
+            v->e = e;
+            next = e;
+            prev = e;
+            return;
+        }
+        Edge* current = v->e;
+        Edge* previous = current->Prev(v);
+        next = current;
+        prev = previous;
+        if(current->v1 == v) {
+            current->v1Prev = e;
+        } else {
+            current->v2Prev = e;
+        }
+        if(previous->v1 == v) {
+            previous->v1Next = e;
+        } else {
+            previous->v2Next = e;
+        }
+    };
+
+    // edges are keyed by their sorted pair of vert indices
+    std::unordered_map<std::uint64_t, Edge*> edgeTable = std::unordered_map<std::uint64_t, Edge*>();
+    edgeTable.reserve(faceIndices.size() + edgeIndices.size() / 2);
+
+    // find or create the edge between the verts a and b
+    auto findEdge = [&](std::size_t a, std::size_t b) -> Edge* {
+        std::uint64_t key = a < b ? std::uint64_t(a) * numVerts + b : std::uint64_t(b) * numVerts + a;
+        Edge*& edge = edgeTable[key];
+        if(edge == nullptr) {
+            edge = NewEdge();
+            RecordCreated(edge);
+            edge->v1 = newVerts[a];
+            edge->v2 = newVerts[b];
+            edge->l = nullptr;
+            if(edges == nullptr) {
+                edges = edge;
+                edge->mNext = edge;
+                edge->mPrev = edge;
+            } else {
+                edge->mPrev = edges->mPrev;
+                edge->mNext = edges;
+                edges->mPrev->mNext = edge;
+                edges->mPrev = edge;
+            }
+            edgeCount++;
+            linkDisk(edge->v1, edge);
+            linkDisk(edge->v2, edge);
+            IndexEdge(edge);
+        }
+        return edge;
+    };
+
+    for(std::size_t i = 0; i < numFaces; ++i) {
+        std::size_t begin = faceOffsets[i];
+        std::size_t end = faceOffsets[i + 1];
+
+        Face* newf = NewFace();
+        RecordCreated(newf);
+
+        Loop* first = nullptr;
+        Loop* last = nullptr;
+        for(std::size_t j = begin; j < end; ++j) {
+            std::size_t a = faceIndices[j];
+            std::size_t b = faceIndices[j + 1 < end ? j + 1 : begin];
+
+            Edge* edge = findEdge(a, b);
+
+            // create the loop and add it to the radial cycle of the edge
+            Loop* newl = NewLoop();
+            RecordCreated(newl);
+            newl->v = newVerts[a];
+            newl->e = edge;
+            newl->f = newf;
+            if(edge->l == nullptr) {
+                edge->l = newl;
+                newl->eNext = newl;
+                newl->ePrev = newl;
+            } else {
+                newl->eNext = edge->l;
+                newl->ePrev = edge->l->ePrev;
+                edge->l->ePrev->eNext = newl;
+                edge->l->ePrev = newl;
+            }
+
+            // link the loop to the previous loop of the face
+            if(first == nullptr) {
+                first = newl;
+            } else {
+                last->fNext = newl;
+                newl->fPrev = last;
+            }
+            last = newl;
+        }
+        last->fNext = first;
+        first->fPrev = last;
+        newf->l = first;
+
+        // append face to the end of the face list
+        if(faces == nullptr) {
+            faces = newf;
+            newf->mNext = newf;
+            newf->mPrev = newf;
+        } else {
+            newf->mPrev = faces->mPrev;
+            newf->mNext = faces;
+            faces->mPrev->mNext = newf;
+            faces->mPrev = newf;
+        }
+        faceCount++;
+    }
+
+    // wire edges, edges which are already part of a face are not created twice
+    for(std::size_t i = 0; i < edgeIndices.size(); i += 2) {
+        findEdge(edgeIndices[i], edgeIndices[i + 1]);
+    }
+}
+
+void Mesh::EnableCoordArrays(bool enable) {
+    if(enable == coordArraysEnabled) {
+        return;
+    }
+
+    // verts kept alive by the journal move along with the verts of the mesh
+    std::vector<Vert*> moved = Verts();
+    if(journal != nullptr) {
+        for(const JournalStep& step : journal->steps) {
+            for(const JournalRecord<Vert>& record : step.verts) {
+                moved.push_back(record.element);
+            }
+        }
+        for(const JournalRecord<Vert>& record : journal->open.verts) {
+            moved.push_back(record.element);
+        }
+    }
+
+    if(enable) {
+        coordArraysEnabled = true;
+        for(Vert* vert : moved) {
+            coordArray.Attach(vert->slot >> SlotDirectory<Vert>::BITS);
+            vert->Co() = vert->co;
+            vert->No() = vert->no;
+        }
+        return;
+    }
+    for(Vert* vert : moved) {
+        vert->co = vert->Co();
+        vert->no = vert->No();
+    }
+    coordArray.Release();
+    coordArraysEnabled = false;
+}
+
+bool Mesh::IsCoordArraysEnabled() const {
+    return coordArraysEnabled;
+}
+
+const CoordArray& Mesh::CoordArrays() const {
+    return coordArray;
+}
+
+void Mesh::IndexEdge(Edge* e) {
+    if(!edgeIndexEnabled) {
+        return;
+    }
+    const Vert* v1 = e->v1 < e->v2 ? e->v1 : e->v2;
+    const Vert* v2 = e->v1 < e->v2 ? e->v2 : e->v1;
+    edgeIndex[std::make_pair(v1, v2)] = e;
+}
+
+void Mesh::UnindexEdge(Edge* e) {
+    if(!edgeIndexEnabled) {
+        return;
+    }
+    const Vert* v1 = e->v1 < e->v2 ? e->v1 : e->v2;
+    const Vert* v2 = e->v1 < e->v2 ? e->v2 : e->v1;
+    auto found = edgeIndex.find(std::make_pair(v1, v2));
+    if(found != edgeIndex.end() && found->second == e) {
+        edgeIndex.erase(found);
+    }
+}
+
+void Mesh::EnableEdgeIndex(bool enable) {
+    if(!enable) {
+        // swap with an empty table, clear() would keep the buckets allocated
+        edgeIndexEnabled = false;
+        std::unordered_map<std::pair<const Vert*, const Vert*>, Edge*, VertPairHash>().swap(edgeIndex);
+        return;
+    }
+    if(edgeIndexEnabled) {
+        return;
+    }
+    edgeIndexEnabled = true;
+    edgeIndex.reserve(edgeCount);
+    for(Edge* edge : EdgeRange()) {
+        IndexEdge(edge);
+    }
+}
+
+bool Mesh::IsEdgeIndexEnabled() const {
+    return edgeIndexEnabled;
+}
+
+Edge* Mesh::FindEdge(const Vert* v1, const Vert* v2) const {
+    if(edgeIndexEnabled) {
+        auto found = edgeIndex.find(v1 < v2 ? std::make_pair(v1, v2) : std::make_pair(v2, v1));
+        return found == edgeIndex.end() ? nullptr : found->second;
+    }
+    for(Edge* edge : v1->EdgeRange()) {
+        if(edge->Other(v1) == v2) {
+            return edge;
+        }
+    }
+    return nullptr;
+}
+
+void Mesh::Unclassify(Vert* v) {
+    v->classBits = 0;
+}
+
+void Mesh::Unclassify(Edge* e) {
+    e->classBits = 0;
+    e->v1->classBits = 0;
+    e->v2->classBits = 0;
+}
+
+void Mesh::Unclassify(Face* f) {
+    // bits are all zero while the cache is disabled, no need to walk the face
+    if(!classificationEnabled) {
+        return;
+    }
+    for(Edge* edge : f->EdgeRange()) {
+        Unclassify(edge);
+    }
+}
+
+void Mesh::EnableClassificationCache(bool enable) {
+    if(enable) {
+        ClassifyAll();
+        return;
+    }
+    classificationEnabled = false;
+    for(Vert* vert : VertRange()) {
+        vert->classBits = 0;
+    }
+    for(Edge* edge : EdgeRange()) {
+        edge->classBits = 0;
+    }
+}
+
+bool Mesh::IsClassificationCacheEnabled() const {
+    return classificationEnabled;
+}
+
+void Mesh::ClassifyAll() {
+    const std::size_t GRAIN_SIZE = 4096;
+
+    std::vector<Vert*> allVerts = std::vector<Vert*>();
+    allVerts.reserve(vertCount);
+    for(Vert* vert : VertRange()) {
+        allVerts.push_back(vert);
+    }
+    std::vector<Edge*> allEdges = std::vector<Edge*>();
+    allEdges.reserve(edgeCount);
+    for(Edge* edge : EdgeRange()) {
+        allEdges.push_back(edge);
+    }
+    classificationEnabled = true;
+
+    // every element is written by exactly one chunk. edges only read loops, verts read the finished edge bits
+    ParallelFor(allEdges.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Edge* edge = allEdges[i];
+            edge->classBits = 0;
+            uint8_t bits = Edge::CLASS_VALID;
+            if(edge->IsContigous()) {
+                bits |= Edge::CLASS_CONTIGOUS;
+            }
+            if(edge->IsManifold()) {
+                bits |= Edge::CLASS_MANIFOLD;
+            }
+            edge->classBits = bits;
+        }
+    });
+    ParallelFor(allVerts.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Vert* vert = allVerts[i];
+            vert->classBits = 0;
+            uint8_t bits = Vert::CLASS_VALID;
+            if(vert->IsBoundary()) {
+                bits |= Vert::CLASS_BOUNDARY;
+            }
+            if(vert->IsManifold()) {
+                bits |= Vert::CLASS_MANIFOLD;
+            }
+            if(vert->IsWire()) {
+                bits |= Vert::CLASS_WIRE;
+            }
+            vert->classBits = bits;
+        }
+    });
+}
+
+VertHandle Mesh::GetHandle(const Vert* v) const {
+    return vertPool.HandleOf(v);
+}
+
+EdgeHandle Mesh::GetHandle(const Edge* e) const {
+    return edgePool.HandleOf(e);
+}
+
+FaceHandle Mesh::GetHandle(const Face* f) const {
+    return facePool.HandleOf(f);
+}
+
+LoopHandle Mesh::GetHandle(const Loop* l) const {
+    return loopPool.HandleOf(l);
+}
+
+Vert* Mesh::Resolve(const VertHandle& handle) const {
+    return vertPool.Resolve(handle);
+}
+
+Edge* Mesh::Resolve(const EdgeHandle& handle) const {
+    return edgePool.Resolve(handle);
+}
+
+Face* Mesh::Resolve(const FaceHandle& handle) const {
+    return facePool.Resolve(handle);
+}
+
+Loop* Mesh::Resolve(const LoopHandle& handle) const {
+    return loopPool.Resolve(handle);
+}
+
+template<typename T>
+JournalRecord<T>& Mesh::RecordElement(T* element, bool alive) {
+    if(journal->open.IsEmpty()) {
+        // a new step begins, steps which were undone can no longer be redone
+        DiscardRedo();
+        journal->open.meshVerts = verts;
+        journal->open.meshEdges = edges;
+        journal->open.meshFaces = faces;
+        journal->open.meshVertCount = vertCount;
+        journal->open.meshEdgeCount = edgeCount;
+        journal->open.meshFaceCount = faceCount;
+    }
+    return journal->Record(element, alive);
+}
+
+JournalRecord<Vert>& Mesh::RecordElement(Vert* v, bool alive) {
+    std::size_t recorded = journal->open.verts.size();
+    JournalRecord<Vert>& record = RecordElement<Vert>(v, alive);
+    if(journal->open.verts.size() != recorded) {
+        record.image.co = v->Co();
+        record.image.no = v->No();
+    }
+    return record;
+}
+
+void Mesh::RecordCreatedElement(Vert* v) {
+    if(journal != nullptr) {
+        RecordElement(v, false).aliveAfter = true;
+    }
+    if(changes != nullptr) {
+        changes->Created(v);
+    }
+}
+
+void Mesh::RecordCreatedElement(Edge* e) {
+    if(journal != nullptr) {
+        RecordElement(e, false).aliveAfter = true;
+    }
+    if(changes != nullptr) {
+        changes->Created(e);
+    }
+}
+
+void Mesh::RecordCreatedElement(Face* f) {
+    if(journal != nullptr) {
+        RecordElement(f, false).aliveAfter = true;
+    }
+    if(changes != nullptr) {
+        changes->Created(f);
+    }
+}
+
+void Mesh::RecordCreatedElement(Loop* l) {
+    if(journal != nullptr) {
+        RecordElement(l, false).aliveAfter = true;
+    }
+}
+
+void Mesh::Dispose(Vert* v) {
+    if(changes != nullptr) {
+        changes->Killed(v);
+    }
+    if(journal == nullptr) {
+        vertPool.Free(v);
+        return;
+    }
+    RecordElement(v, true).aliveAfter = false;
+    vertPool.Retire(v);
+}
+
+void Mesh::Dispose(Edge* e) {
+    if(changes != nullptr) {
+        changes->Killed(e);
+    }
+    if(journal == nullptr) {
+        edgePool.Free(e);
+        return;
+    }
+    RecordElement(e, true).aliveAfter = false;
+    edgePool.Retire(e);
+}
+
+void Mesh::Dispose(Face* f) {
+    if(changes != nullptr) {
+        changes->Killed(f);
+    }
+    if(journal == nullptr) {
+        facePool.Free(f);
+        return;
+    }
+    RecordElement(f, true).aliveAfter = false;
+    facePool.Retire(f);
+}
+
+void Mesh::Dispose(Loop* l) {
+    if(journal == nullptr) {
+        loopPool.Free(l);
+        return;
+    }
+    RecordElement(l, true).aliveAfter = false;
+    loopPool.Retire(l);
 }
 
-bool Mesh::IsValid() const {
-    // validate verts
-    Vert* currentVert = verts;
-    if(verts != nullptr) {
-        do {
-            // check that mesh pointer is correct
-            if(currentVert->m != this) {
-                return false;
-            }
-            if(currentVert->e != nullptr) {
-                // check that first edge in list points to vert
-                if(currentVert->e->v1 != currentVert && currentVert->e->v2 != currentVert) {
-                    return false;
-                }
-                // check that first edge in list points to mesh
-                if(currentVert->e->m != this) {
-                    return false;
-                }
-            }
-            // check that mNext, mPrev point to a vert in mesh
-            if(currentVert->mPrev->mNext != currentVert || currentVert->mNext->mPrev != currentVert) {
-                return false;
+void Mesh::SetCo(Vert* v, const Math::Vec3& co) {
+    RecordChange(v);
+    v->Co() = co;
+}
+
+void Mesh::SetNo(Vert* v, const Math::Vec3& no) {
+    RecordChange(v);
+    v->No() = no;
+}
+
+void Mesh::SetNo(Face* f, const Math::Vec3& no) {
+    RecordChange(f);
+    f->no = no;
+}
+
+void Mesh::NormalUpdate(Face* f) {
+    RecordChange(f);
+    f->NormalUpdate();
+}
+
+void Mesh::RecordChangedElement(Vert* v) {
+    if(v == nullptr) {
+        return;
+    }
+    if(journal != nullptr) {
+        RecordElement(v, true);
+    }
+    if(changes != nullptr) {
+        changes->Modified(v);
+    }
+}
+
+void Mesh::RecordChangedElement(Edge* e) {
+    if(e == nullptr) {
+        return;
+    }
+    if(journal != nullptr) {
+        RecordElement(e, true);
+    }
+    if(changes != nullptr) {
+        changes->Modified(e);
+    }
+}
+
+void Mesh::RecordChangedElement(Face* f) {
+    if(f == nullptr) {
+        return;
+    }
+    if(journal != nullptr) {
+        RecordElement(f, true);
+    }
+    if(changes != nullptr) {
+        changes->Modified(f);
+    }
+}
+
+void Mesh::RecordChangedElement(Loop* l) {
+    if(l == nullptr) {
+        return;
+    }
+    if(journal != nullptr) {
+        RecordElement(l, true);
+    }
+    // loops are not tracked themselves, they are part of their face. Loops without a face are about to get one
+    if(changes != nullptr && l->f != nullptr) {
+        changes->Modified(l->f);
+    }
+}
+
+void Mesh::FreeStep(JournalStep& step, bool after) {
+    FreeRecords(step.verts, vertPool, after);
+    FreeRecords(step.edges, edgePool, after);
+    FreeRecords(step.faces, facePool, after);
+    FreeRecords(step.loops, loopPool, after);
+}
+
+void Mesh::UnclassifyStep(JournalStep& step, bool after) {
+    for(JournalRecord<Vert>& record : step.verts) {
+        if(after ? record.aliveAfter : record.aliveBefore) {
+            Unclassify(record.element);
+        }
+    }
+    for(JournalRecord<Edge>& record : step.edges) {
+        if(after ? record.aliveAfter : record.aliveBefore) {
+            Unclassify(record.element);
+        }
+    }
+    for(JournalRecord<Loop>& record : step.loops) {
+        if(after ? record.aliveAfter : record.aliveBefore) {
+            Unclassify(record.element->e);
+        }
+    }
+    for(JournalRecord<Face>& record : step.faces) {
+        if(after ? record.aliveAfter : record.aliveBefore) {
+            Unclassify(record.element);
+        }
+    }
+}
+
+void Mesh::ApplyStep(JournalStep& step, bool undo) {
+    // undo moves the mesh from the side after the step to the side before it, redo the other way around
+    UnclassifyStep(step, undo);
+    for(JournalRecord<Edge>& record : step.edges) {
+        if(undo ? record.aliveAfter : record.aliveBefore) {
+            UnindexEdge(record.element);
+        }
+    }
+
+    SwapRecords(step.verts);
+    SwapRecords(step.edges);
+    SwapRecords(step.faces);
+    SwapRecords(step.loops);
+    std::swap(verts, step.meshVerts);
+    std::swap(edges, step.meshEdges);
+    std::swap(faces, step.meshFaces);
+    std::swap(vertCount, step.meshVertCount);
+    std::swap(edgeCount, step.meshEdgeCount);
+    std::swap(faceCount, step.meshFaceCount);
+
+    // images keep the coordinates inside themselves, move them into the coordinate arrays where those are used
+    for(JournalRecord<Vert>& record : step.verts) {
+        Math::Vec3& co = record.element->Co();
+        Math::Vec3& no = record.element->No();
+        if(&co != &record.element->co) {
+            record.image.co = co;
+            record.image.no = no;
+            co = record.element->co;
+            no = record.element->no;
+        }
+    }
+    for(JournalRecord<Edge>& record : step.edges) {
+        if(undo ? record.aliveBefore : record.aliveAfter) {
+            IndexEdge(record.element);
+        }
+    }
+    UnclassifyStep(step, !undo);
+    RetireRecords(step.verts, vertPool, undo);
+    RetireRecords(step.edges, edgePool, undo);
+    RetireRecords(step.faces, facePool, undo);
+    RetireRecords(step.loops, loopPool, undo);
+    if(changes != nullptr) {
+        TrackStep(step, undo);
+    }
+}
+
+template<typename T>
+void Mesh::TrackRecords(std::vector<JournalRecord<T>>& records, bool undo) {
+    for(JournalRecord<T>& record : records) {
+        bool aliveNow = undo ? record.aliveBefore : record.aliveAfter;
+        bool aliveThen = undo ? record.aliveAfter : record.aliveBefore;
+        if(aliveNow && !aliveThen) {
+            changes->Created(record.element);
+        } else if(!aliveNow && aliveThen) {
+            changes->Killed(record.element);
+        } else if(aliveNow) {
+            changes->Modified(record.element);
+        }
+    }
+}
+
+void Mesh::TrackStep(JournalStep& step, bool undo) {
+    TrackRecords(step.verts, undo);
+    TrackRecords(step.edges, undo);
+    TrackRecords(step.faces, undo);
+    for(JournalRecord<Loop>& record : step.loops) {
+        if((undo ? record.aliveBefore : record.aliveAfter) && record.element->f != nullptr) {
+            changes->Modified(record.element->f);
+        }
+    }
+}
+
+void Mesh::DiscardRedo() {
+    while(journal->steps.size() > journal->applied) {
+        FreeStep(journal->steps.back(), false);
+        journal->memory -= journal->steps.back().MemoryUsage();
+        journal->steps.pop_back();
+    }
+}
+
+void Mesh::TrimJournal() {
+    std::size_t drop = 0;
+    while(journal->memory > journalLimit && journal->applied - drop > 1) {
+        FreeStep(journal->steps[drop], true);
+        journal->memory -= journal->steps[drop].MemoryUsage();
+        ++drop;
+    }
+    journal->steps.erase(journal->steps.begin(), journal->steps.begin() + drop);
+    journal->applied -= drop;
+}
+
+void Mesh::ResetJournal() {
+    FreeStep(journal->open, true);
+    for(std::size_t i = 0; i < journal->steps.size(); ++i) {
+        FreeStep(journal->steps[i], i < journal->applied);
+    }
+    journal->steps.clear();
+    journal->open = JournalStep();
+    journal->seen.clear();
+    journal->applied = 0;
+    journal->memory = 0;
+}
+
+void Mesh::EnableJournal(bool enable) {
+    if(enable) {
+        if(journal == nullptr) {
+            journal = new MeshJournal();
+        }
+        return;
+    }
+    if(journal != nullptr) {
+        ResetJournal();
+        delete journal;
+        journal = nullptr;
+    }
+}
+
+bool Mesh::IsJournalEnabled() const {
+    return journal != nullptr;
+}
+
+void Mesh::SetJournalLimit(std::size_t bytes) {
+    journalLimit = bytes;
+    if(journal != nullptr) {
+        TrimJournal();
+    }
+}
+
+void Mesh::Checkpoint() {
+    if(journal == nullptr || journal->open.IsEmpty()) {
+        return;
+    }
+
+    // elements created and killed within the step are not part of the mesh on either side of it
+    JournalStep& step = journal->open;
+    DropTransient(step.verts, vertPool);
+    DropTransient(step.edges, edgePool);
+    DropTransient(step.faces, facePool);
+    DropTransient(step.loops, loopPool);
+    journal->seen.clear();
+
+    if(!step.IsEmpty()) {
+        journal->memory += step.MemoryUsage();
+        journal->steps.push_back(std::move(step));
+        journal->applied++;
+    }
+    journal->open = JournalStep();
+    TrimJournal();
+}
+
+bool Mesh::Undo() {
+    if(journal == nullptr) {
+        return false;
+    }
+    Checkpoint();
+    if(journal->applied == 0) {
+        return false;
+    }
+    journal->applied--;
+    ApplyStep(journal->steps[journal->applied], true);
+    return true;
+}
+
+bool Mesh::Redo() {
+    if(journal == nullptr) {
+        return false;
+    }
+    Checkpoint();
+    if(journal->applied == journal->steps.size()) {
+        return false;
+    }
+    ApplyStep(journal->steps[journal->applied], false);
+    journal->applied++;
+    return true;
+}
+
+std::size_t Mesh::UndoCount() const {
+    if(journal == nullptr) {
+        return 0;
+    }
+    return journal->applied + (journal->open.IsEmpty() ? 0 : 1);
+}
+
+std::size_t Mesh::RedoCount() const {
+    if(journal == nullptr || !journal->open.IsEmpty()) {
+        return 0;
+    }
+    return journal->steps.size() - journal->applied;
+}
+
+void Mesh::EnableChangeTracking(bool enable) {
+    if(enable) {
+        if(changes == nullptr) {
+            changes = new MeshChanges();
+        }
+        return;
+    }
+    delete changes;
+    changes = nullptr;
+}
+
+bool Mesh::IsChangeTrackingEnabled() const {
+    return changes != nullptr;
+}
+
+const MeshChanges& Mesh::Changes() const {
+    if(changes == nullptr) {
+        throw std::invalid_argument("Change tracking is not enabled");
+    }
+    return *changes;
+}
+
+MeshChanges Mesh::TakeChanges() {
+    if(changes == nullptr) {
+        throw std::invalid_argument("Change tracking is not enabled");
+    }
+    MeshChanges result = std::move(*changes);
+    changes->Clear();
+    return result;
+}
+
+MeshMemoryUsage Mesh::MemoryUsage() const {
+    MeshMemoryUsage usage = MeshMemoryUsage();
+    usage.vertSize = sizeof(Vert);
+    usage.edgeSize = sizeof(Edge);
+    usage.faceSize = sizeof(Face);
+    usage.loopSize = sizeof(Loop);
+
+    usage.verts = vertPool.MemoryUsage();
+    usage.edges = edgePool.MemoryUsage();
+    usage.faces = facePool.MemoryUsage();
+    usage.loops = loopPool.MemoryUsage();
+    usage.coords = coordArray.MemoryUsage();
+
+    // every entry is a separately allocated node holding the key, the value, the hash and a pointer to the next node
+    typedef std::pair<const std::pair<const Vert*, const Vert*>, Edge*> EdgeIndexEntry;
+    usage.edgeIndex = edgeIndex.bucket_count() * sizeof(void*)
+                      + edgeIndex.size() * (sizeof(EdgeIndexEntry) + sizeof(void*) + sizeof(std::size_t));
+
+    usage.journal = 0;
+    if(journal != nullptr) {
+        usage.journal = sizeof(MeshJournal) + journal->memory + journal->open.MemoryUsage()
+                        + journal->seen.bucket_count() * sizeof(void*)
+                        + journal->seen.size() * (sizeof(std::pair<const void*, std::size_t>) + 2 * sizeof(void*));
+    }
+
+    usage.changes = 0;
+    if(changes != nullptr) {
+        usage.changes = changes->MemoryUsage();
+    }
+
+    usage.total = usage.verts + usage.edges + usage.faces + usage.loops + usage.coords + usage.edgeIndex + usage.journal
+                  + usage.changes;
+    return usage;
+}
+
+uint32_t Mesh::NewGeneration() {
+    if(generation == UINT32_MAX) {
+        // generations ran out, reset all markers so that counting can start over
+        for(Vert* vert : VertRange()) {
+            vert->visited = 0;
+        }
+        for(Edge* edge : EdgeRange()) {
+            edge->visited = 0;
+        }
+        for(Face* face : FaceRange()) {
+            face->visited = 0;
+            for(Loop* loop : face->LoopRange()) {
+                loop->visited = 0;
             }
+        }
+        generation = 0;
+    }
+    return ++generation;
+}
 
-            currentVert = currentVert->mNext;
+MeshValidationIssue::MeshValidationIssue(MeshValidationError error)
+    : error(error), vert(nullptr), edge(nullptr), face(nullptr), loop(nullptr) {
+}
 
-        } while(verts != currentVert);
+MeshValidationIssue::MeshValidationIssue(MeshValidationError error, const Vert* v)
+    : error(error), vert(v), edge(nullptr), face(nullptr), loop(nullptr) {
+}
+
+MeshValidationIssue::MeshValidationIssue(MeshValidationError error, const Edge* e)
+    : error(error), vert(nullptr), edge(e), face(nullptr), loop(nullptr) {
+}
+
+MeshValidationIssue::MeshValidationIssue(MeshValidationError error, const Face* f)
+    : error(error), vert(nullptr), edge(nullptr), face(f), loop(nullptr) {
+}
+
+MeshValidationIssue::MeshValidationIssue(MeshValidationError error, const Loop* l)
+    : error(error), vert(nullptr), edge(nullptr), face(nullptr), loop(l) {
+}
+
+template<typename T>
+void Mesh::CollectList(T* head, std::size_t count, std::unordered_set<const T*>& set, std::vector<T*>& list,
+    MeshValidationReport& report) {
+    set.reserve(count);
+    list.reserve(count);
+    if(head != nullptr) {
+        T* current = head;
+        do {
+            if(!set.insert(current).second) {
+                report.issues.push_back(MeshValidationIssue(MeshValidationError::BrokenMeshList, current));
+                break;
+            }
+            list.push_back(current);
+            current = current->mNext;
+        } while(current != nullptr && current != head);
+    }
+    if(list.size() != count) {
+        report.issues.push_back(MeshValidationIssue(MeshValidationError::CountMismatch));
     }
+}
 
-    // validate edges
-    Edge* currentEdge = edges;
-    if(currentEdge != nullptr) {
+bool Mesh::CollectFaceVerts(const Face* f, std::size_t maxLoops, std::vector<const Vert*>& result) {
+    if(f->l == nullptr) {
+        return false;
+    }
+    const Loop* current = f->l;
+    do {
+        if(current->fNext == nullptr || current->fNext->fPrev != current || result.size() >= maxLoops) {
+            return false;
+        }
+        result.push_back(current->v);
+        current = current->fNext;
+    } while(current != f->l);
+    return true;
+}
+
+bool Mesh::IsValid() const {
+    return Validate().IsValid();
+}
+
+MeshValidationReport Mesh::Validate() const {
+    MeshValidationReport report = MeshValidationReport();
+
+    // collect the lists. an element which is reached twice breaks the list, the walk stops there
+    std::unordered_set<const Vert*> vertSet = std::unordered_set<const Vert*>();
+    std::unordered_set<const Edge*> edgeSet = std::unordered_set<const Edge*>();
+    std::unordered_set<const Face*> faceSet = std::unordered_set<const Face*>();
+    std::vector<Vert*> vertList = std::vector<Vert*>();
+    std::vector<Edge*> edgeList = std::vector<Edge*>();
+    std::vector<Face*> faceList = std::vector<Face*>();
+    CollectList(verts, vertCount, vertSet, vertList, report);
+    CollectList(edges, edgeCount, edgeSet, edgeList, report);
+    CollectList(faces, faceCount, faceSet, faceList, report);
+
+    // longest valid cycles, walks which take more steps are broken
+    const std::size_t maxDisk = edgeList.size();
+    const std::size_t maxRadial = 2 * faceList.size();
+    const std::size_t maxFace = 2 * edgeList.size();
+
+    // the sets are only read from here on
+    auto checkVert = [&](const Vert* v, std::vector<MeshValidationIssue>& out) {
+        if(v->ParentMesh() != this) {
+            out.push_back(MeshValidationIssue(MeshValidationError::WrongMesh, v));
+        }
+        if(v->mNext == nullptr || v->mPrev == nullptr || v->mNext->mPrev != v || v->mPrev->mNext != v) {
+            out.push_back(MeshValidationIssue(MeshValidationError::BrokenMeshList, v));
+        }
+        if(v->e == nullptr) {
+            return;
+        }
+
+        // walk the edges around v, remembering the vert on the other side of each edge
+        std::vector<std::pair<const Vert*, const Edge*>> neighbours =
+            std::vector<std::pair<const Vert*, const Edge*>>();
+        const Edge* current = v->e;
         do {
-            // check for self loops
-            if(currentEdge->v1 == currentEdge->v2) {
-                return false;
+            if(edgeSet.count(current) == 0) {
+                out.push_back(MeshValidationIssue(MeshValidationError::NotInMesh, v));
+                return;
+            }
+            const Edge* next = current->v1 == v ? current->v1Next : current->v2Next;
+            if((current->v1 != v && current->v2 != v) || next == nullptr || (next->v1 != v && next->v2 != v)
+                || (next->v1 == v ? next->v1Prev : next->v2Prev) != current || neighbours.size() >= maxDisk) {
+                out.push_back(MeshValidationIssue(MeshValidationError::BrokenDiskCycle, v));
+                return;
             }
-            // TODO: check for double edges
-            // Can do this in O(n) if using flags, if not, it's worse.
+            neighbours.push_back(std::make_pair(current->v1 == v ? current->v2 : current->v1, current));
+            current = next;
+        } while(current != v->e);
 
-            if(currentEdge->l != nullptr) {
-                Loop* currentLoop = currentEdge->l;
-                // check that loop points to mesh
-                if(currentLoop->m != this) {
-                    return false;
-                }
-                // check ordering around verts, vNext/vPrev
-                do {
-                    if(currentLoop->e != currentEdge) {
-                        return false;
-                    }
-                    if(currentLoop->ePrev->eNext != currentLoop || currentLoop->eNext->ePrev != currentLoop) {
-                        return false;
-                    }
-                    currentLoop = currentLoop->eNext;
-                } while(currentLoop != currentEdge->l);
+        // edges to the same vert are next to each other once sorted. each pair is reported by its lower vert only
+        std::sort(neighbours.begin(), neighbours.end(),
+            [](const std::pair<const Vert*, const Edge*>& lhs, const std::pair<const Vert*, const Edge*>& rhs) {
+                return std::less<const Vert*>()(lhs.first, rhs.first);
+            });
+        for(std::size_t i = 1; i < neighbours.size(); ++i) {
+            const Vert* other = neighbours[i].first;
+            if(other == neighbours[i - 1].first && other != v && std::less<const Vert*>()(v, other)) {
+                out.push_back(MeshValidationIssue(MeshValidationError::DoubleEdge, neighbours[i].second));
             }
+        }
+    };
 
-            // check that v1, v2 point to mesh
-            if(currentEdge->v1->m != this || currentEdge->v2->m != this) {
-                return false;
+    auto checkEdge = [&](const Edge* e, std::vector<MeshValidationIssue>& out) {
+        if(e->ParentMesh() != this) {
+            out.push_back(MeshValidationIssue(MeshValidationError::WrongMesh, e));
+        }
+        if(e->mNext == nullptr || e->mPrev == nullptr || e->mNext->mPrev != e || e->mPrev->mNext != e) {
+            out.push_back(MeshValidationIssue(MeshValidationError::BrokenMeshList, e));
+        }
+        if(vertSet.count(e->v1) == 0 || vertSet.count(e->v2) == 0) {
+            out.push_back(MeshValidationIssue(MeshValidationError::NotInMesh, e));
+            return;
+        }
+        if(e->v1 == e->v2) {
+            out.push_back(MeshValidationIssue(MeshValidationError::SelfLoop, e));
+            return;
+        }
+
+        // neighbours in both disk cycles must link back to this edge
+        for(const Vert* v : {e->v1, e->v2}) {
+            const Edge* next = e->v1 == v ? e->v1Next : e->v2Next;
+            const Edge* prev = e->v1 == v ? e->v1Prev : e->v2Prev;
+            if(next == nullptr || prev == nullptr || (next->v1 != v && next->v2 != v)
+                || (prev->v1 != v && prev->v2 != v) || (next->v1 == v ? next->v1Prev : next->v2Prev) != e
+                || (prev->v1 == v ? prev->v1Next : prev->v2Next) != e) {
+                out.push_back(MeshValidationIssue(MeshValidationError::BrokenDiskCycle, e));
+                break;
             }
+        }
 
-            // check that mesh pointer is correct
-            if(currentEdge->m != this) {
-                return false;
+        if(e->l == nullptr) {
+            return;
+        }
+        const Loop* current = e->l;
+        std::size_t steps = 0;
+        do {
+            if(current->e != e || current->eNext == nullptr || current->ePrev == nullptr
+                || current->eNext->ePrev != current || current->ePrev->eNext != current || ++steps > maxRadial) {
+                out.push_back(MeshValidationIssue(MeshValidationError::BrokenRadialCycle, e));
+                return;
             }
-            // check that mNext, mPrev point to an edge in mesh
-            if(currentEdge->mPrev->mNext != currentEdge || currentEdge->mNext->mPrev != currentEdge) {
-                return false;
+            if(current->ParentMesh() != this) {
+                out.push_back(MeshValidationIssue(MeshValidationError::WrongMesh, current));
+            }
+            if(current->v != e->v1 && current->v != e->v2) {
+                out.push_back(MeshValidationIssue(MeshValidationError::LoopMismatch, current));
             }
+            if(faceSet.count(current->f) == 0) {
+                out.push_back(MeshValidationIssue(MeshValidationError::NotInMesh, current));
+            }
+            current = current->eNext;
+        } while(current != e->l);
+    };
 
-            currentEdge = currentEdge->mNext;
-        } while(edges != currentEdge);
-    }
+    auto checkFace = [&](const Face* f, std::vector<MeshValidationIssue>& out) {
+        if(f->ParentMesh() != this) {
+            out.push_back(MeshValidationIssue(MeshValidationError::WrongMesh, f));
+        }
+        if(f->mNext == nullptr || f->mPrev == nullptr || f->mNext->mPrev != f || f->mPrev->mNext != f) {
+            out.push_back(MeshValidationIssue(MeshValidationError::BrokenMeshList, f));
+        }
+
+        std::vector<const Vert*> faceVerts = std::vector<const Vert*>();
+        if(!CollectFaceVerts(f, maxFace, faceVerts)) {
+            out.push_back(MeshValidationIssue(MeshValidationError::BrokenFaceCycle, f));
+            return;
+        }
+        if(faceVerts.size() < 3) {
+            out.push_back(MeshValidationIssue(MeshValidationError::TooFewLoops, f));
+        }
 
-    // validate face and face loops
-    if(faces != nullptr) {
-        Face* currentFace = faces;
+        const Loop* current = f->l;
         do {
-            // check that mesh pointer is correct
-            if(currentFace->m != this) {
-                return false;
+            if(current->ParentMesh() != this) {
+                out.push_back(MeshValidationIssue(MeshValidationError::WrongMesh, current));
             }
-            // validate face loops
-            Loop* currentLoop = currentFace->l;
-            do {
-                // check that loop edge, vert point to proper mesh
-                if(currentLoop->e->m != this) {
-                    return false;
-                }
-                if(currentLoop->v->m != this) {
-                    return false;
-                }
-                // check that loop fNext, fPrev are correct
-                if(currentLoop->fPrev->fNext != currentLoop || currentLoop->fNext->fPrev != currentLoop) {
-                    return false;
-                }
-                // check that loop mesh pointer is correct
-                if(currentLoop->m != this) {
-                    return false;
-                }
+            if(vertSet.count(current->v) == 0 || edgeSet.count(current->e) == 0) {
+                out.push_back(MeshValidationIssue(MeshValidationError::NotInMesh, current));
+            } else if(current->f != f || (current->e->v1 != current->v && current->e->v2 != current->v)
+                || current->e->Other(current->v) != current->fNext->v) {
+                out.push_back(MeshValidationIssue(MeshValidationError::LoopMismatch, current));
+            } else if(current->eNext == nullptr || current->eNext->ePrev != current
+                || current->eNext->e != current->e) {
+                out.push_back(MeshValidationIssue(MeshValidationError::BrokenRadialCycle, current));
+            }
+            current = current->fNext;
+        } while(current != f->l);
+    };
 
-                currentLoop = currentLoop->fNext;
-            } while(currentLoop->fNext != currentFace->l);
+    std::vector<MeshValidationIssue> vertIssues = ValidateBlocks(vertList, checkVert);
+    std::vector<MeshValidationIssue> edgeIssues = ValidateBlocks(edgeList, checkEdge);
+    std::vector<MeshValidationIssue> faceIssues = ValidateBlocks(faceList, checkFace);
+    report.issues.insert(report.issues.end(), vertIssues.begin(), vertIssues.end());
+    report.issues.insert(report.issues.end(), edgeIssues.begin(), edgeIssues.end());
+    report.issues.insert(report.issues.end(), faceIssues.begin(), faceIssues.end());
 
-            // check that mNext, mPrev point to a face in mesh
-            if(currentFace->m != this) {
-                return false;
+    // a double face repeats the loop cycle of another face, in either orientation. the cycles are hashed on multiple
+    // threads, then only faces with the same hash are compared. each group is reported except for its first face
+    std::vector<std::size_t> cycleHashes = std::vector<std::size_t>(faceList.size());
+    std::vector<char> hasCycle = std::vector<char>(faceList.size());
+    ParallelFor(faceList.size(), 1024, [&](std::size_t begin, std::size_t end) {
+        std::vector<const Vert*> faceVerts = std::vector<const Vert*>();
+        for(std::size_t i = begin; i < end; ++i) {
+            faceVerts.clear();
+            hasCycle[i] = CollectFaceVerts(faceList[i], maxFace, faceVerts) && faceVerts.size() >= 3;
+            if(hasCycle[i]) {
+                cycleHashes[i] = CanonicalCycle<const Vert*>(faceVerts.data(), faceVerts.size()).Hash();
             }
-            // TODO: check for double faces.
-
-            currentFace = currentFace->mNext;
-        } while(faces != currentFace);
+        }
+    });
+    std::unordered_multimap<std::size_t, std::size_t> cycleFaces = std::unordered_multimap<std::size_t, std::size_t>();
+    cycleFaces.reserve(faceList.size());
+    std::vector<const Vert*> faceVerts = std::vector<const Vert*>();
+    std::vector<const Vert*> otherVerts = std::vector<const Vert*>();
+    for(std::size_t i = 0; i < faceList.size(); ++i) {
+        if(!hasCycle[i]) {
+            continue;
+        }
+        auto candidates = cycleFaces.equal_range(cycleHashes[i]);
+        if(candidates.first != candidates.second) {
+            faceVerts.clear();
+            CollectFaceVerts(faceList[i], maxFace, faceVerts);
+            CanonicalCycle<const Vert*> cycle = CanonicalCycle<const Vert*>(faceVerts.data(), faceVerts.size());
+            bool repeated = false;
+            for(auto it = candidates.first; it != candidates.second && !repeated; ++it) {
+                otherVerts.clear();
+                CollectFaceVerts(faceList[it->second], maxFace, otherVerts);
+                repeated = cycle == CanonicalCycle<const Vert*>(otherVerts.data(), otherVerts.size());
+            }
+            if(repeated) {
+                report.issues.push_back(MeshValidationIssue(MeshValidationError::DoubleFace, faceList[i]));
+                continue;
+            }
+        }
+        cycleFaces.insert(std::make_pair(cycleHashes[i], i));
     }
-
-    // TODO: verify that each vert/edge/face appears exactly once in the vert/edge/face lists
-    // this is very expensive without flags.
-
-    return true;
+    return report;
 }
 
 void Mesh::Transform(Math::Mat4 mat) {
-    if(verts != nullptr) {
-        Math::Mat3 transformMatrix = Math::Mat3();
-        for(int i = 0; i < 3; i++) {
-            for(int j = 0; j < 3; j++) {
-                transformMatrix(i, j) = mat(i, j);
+    Math::Mat3 transformMatrix = Math::Mat3();
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            transformMatrix(i, j) = mat(i, j);
+        }
+    }
+
+    if(journal != nullptr || changes != nullptr) {
+        for(Vert* vert : VertRange()) {
+            RecordChange(vert);
+        }
+    }
+
+    if(coordArraysEnabled) {
+        // unused slots are transformed as well, which avoids branching inside the loop
+        for(std::size_t chunk = 0; chunk < coordArray.ChunkCount(); ++chunk) {
+            Math::Vec3* co = coordArray.CoChunk(chunk);
+            std::size_t size = coordArray.ChunkSize(chunk);
+            for(std::size_t i = 0; i < size; ++i) {
+                co[i] = transformMatrix * co[i];
+                co[i].x += mat(0, 3);
+                co[i].y += mat(1, 3);
+                co[i].z += mat(2, 3);
             }
         }
+        return;
+    }
 
+    if(verts != nullptr) {
         Vert* currentVert = verts;
         do {
-            currentVert->co = transformMatrix * currentVert->co;
-            currentVert->co.x += mat(0, 3);
-            currentVert->co.y += mat(1, 3);
-            currentVert->co.z += mat(2, 3);
+            currentVert->Co() = transformMatrix * currentVert->Co();
+            currentVert->Co().x += mat(0, 3);
+            currentVert->Co().y += mat(1, 3);
+            currentVert->Co().z += mat(2, 3);
             currentVert = currentVert->mNext;
         } while(verts != currentVert);
     }
@@ -196,49 +1929,16 @@ const std::vector<Face*> Mesh::Faces() const {
     return result;
 }
 
-const std::vector<Vert*> Mesh::Verts(std::function<bool(const Vert* const)> func) const {
-    std::vector<Vert*> result = std::vector<Vert*>();
-    if(verts == nullptr) {
-        return result;
-    }
-    Vert* currentVert = verts;
-    do {
-        if(func(currentVert)) {
-            result.push_back(currentVert);
-        }
-        currentVert = currentVert->mNext;
-    } while(verts != currentVert);
-    return result;
+MeshVertRange Mesh::VertRange() const {
+    return MeshVertRange(MeshVertIterator(verts), MeshVertIterator());
 }
 
-const std::vector<Edge*> Mesh::Edges(std::function<bool(const Edge* const)> func) const {
-    std::vector<Edge*> result = std::vector<Edge*>();
-    if(edges == nullptr) {
-        return result;
-    }
-    Edge* currentEdge = edges;
-    do {
-        if(func(currentEdge)) {
-            result.push_back(currentEdge);
-        }
-        currentEdge = currentEdge->mNext;
-    } while(edges != currentEdge);
-    return result;
+MeshEdgeRange Mesh::EdgeRange() const {
+    return MeshEdgeRange(MeshEdgeIterator(edges), MeshEdgeIterator());
 }
 
-const std::vector<Face*> Mesh::Faces(std::function<bool(const Face* const)> func) const {
-    std::vector<Face*> result = std::vector<Face*>();
-    if(faces == nullptr) {
-        return result;
-    }
-    Face* currentFace = faces;
-    do {
-        if(func(currentFace)) {
-            result.push_back(currentFace);
-        }
-        currentFace = currentFace->mNext;
-    } while(faces != currentFace);
-    return result;
+MeshFaceRange Mesh::FaceRange() const {
+    return MeshFaceRange(MeshFaceIterator(faces), MeshFaceIterator());
 }
 
 } // namespace Core
@@ -0,0 +1,355 @@
+#include "AobaAPI/Core/Mesh/Mesh.hpp"
+
+#include "AobaAPI/Core/Mesh/Edge.hpp"
+#include "AobaAPI/Core/Mesh/Face.hpp"
+#include "AobaAPI/Core/Mesh/Loop.hpp"
+#include "AobaAPI/Core/Mesh/MeshArrays.hpp"
+#include "AobaAPI/Core/Mesh/Vert.hpp"
+#include "AobaAPI/Core/Parallel.hpp"
+
+#include <stdexcept>
+
+namespace Aoba {
+namespace Core {
+
+namespace {
+
+const std::size_t GRAIN_SIZE = 16384;
+
+// index of the vert of edge e at which the disk cycle entry of e continues, 0 for v1 and 1 for v2
+std::size_t DiskSide(const MeshArrays& a, std::size_t e, uint32_t v) {
+    return a.edgeVerts[2 * e] == v ? 0 : 1;
+}
+
+// check that every link of the arrays refers to an element which exists and fits, so that linking the elements can
+// not produce dangling or null pointers
+void CheckArrays(const MeshArrays& a) {
+    const uint32_t NO_INDEX = MeshArrays::NO_INDEX;
+    std::size_t numVerts = a.vertFlags.size();
+    std::size_t numEdges = a.edgeFlags.size();
+    std::size_t numFaces = a.faceFlags.size();
+    std::size_t numLoops = a.loopFlags.size();
+    if(numVerts >= NO_INDEX || numEdges >= NO_INDEX || numFaces >= NO_INDEX || numLoops >= NO_INDEX) {
+        throw std::invalid_argument("Too many elements.");
+    }
+    if(a.vertCo.size() != 3 * numVerts || a.vertNo.size() != 3 * numVerts || a.vertEdge.size() != numVerts
+        || a.edgeVerts.size() != 2 * numEdges || a.edgeDisk.size() != 2 * numEdges || a.edgeLoop.size() != numEdges
+        || a.faceLoops.size() != numFaces + 1 || a.faceNo.size() != 3 * numFaces || a.faceMaterial.size() != numFaces
+        || a.loopVert.size() != numLoops || a.loopEdge.size() != numLoops || a.loopRadial.size() != numLoops) {
+        throw std::invalid_argument("Mesh arrays have inconsistent sizes.");
+    }
+    const std::invalid_argument invalidLink = std::invalid_argument("Mesh arrays contain an invalid link.");
+
+    // every disk cycle entry and every loop must be reached by exactly one predecessor
+    std::vector<uint8_t> vertUsed = std::vector<uint8_t>(numVerts, 0);
+    std::vector<uint8_t> diskReached = std::vector<uint8_t>(2 * numEdges, 0);
+    for(std::size_t e = 0; e < numEdges; ++e) {
+        uint32_t v1 = a.edgeVerts[2 * e];
+        uint32_t v2 = a.edgeVerts[2 * e + 1];
+        if(v1 >= numVerts || v2 >= numVerts || v1 == v2) {
+            throw invalidLink;
+        }
+        vertUsed[v1] = 1;
+        vertUsed[v2] = 1;
+        for(std::size_t side = 0; side < 2; ++side) {
+            uint32_t vert = a.edgeVerts[2 * e + side];
+            uint32_t next = a.edgeDisk[2 * e + side];
+            if(next >= numEdges || (a.edgeVerts[2 * next] != vert && a.edgeVerts[2 * next + 1] != vert)) {
+                throw invalidLink;
+            }
+            uint8_t& reached = diskReached[2 * next + DiskSide(a, next, vert)];
+            if(reached != 0) {
+                throw invalidLink;
+            }
+            reached = 1;
+        }
+    }
+    for(std::size_t v = 0; v < numVerts; ++v) {
+        uint32_t e = a.vertEdge[v];
+        bool valid = e == NO_INDEX ? vertUsed[v] == 0
+                                   : e < numEdges && (a.edgeVerts[2 * e] == v || a.edgeVerts[2 * e + 1] == v);
+        if(!valid) {
+            throw invalidLink;
+        }
+    }
+
+    if(a.faceLoops.front() != 0 || a.faceLoops.back() != numLoops) {
+        throw invalidLink;
+    }
+    std::vector<uint8_t> edgeUsed = std::vector<uint8_t>(numEdges, 0);
+    std::vector<uint8_t> radialReached = std::vector<uint8_t>(numLoops, 0);
+    for(std::size_t f = 0; f < numFaces; ++f) {
+        std::size_t begin = a.faceLoops[f];
+        std::size_t end = a.faceLoops[f + 1];
+        if(end <= begin || end > numLoops) {
+            throw invalidLink;
+        }
+        for(std::size_t l = begin; l < end; ++l) {
+            // the loop runs along its edge, towards the vert of the next loop of the face
+            uint32_t v = a.loopVert[l];
+            uint32_t e = a.loopEdge[l];
+            if(v >= numVerts || e >= numEdges) {
+                throw invalidLink;
+            }
+            if(a.edgeVerts[2 * e] != v && a.edgeVerts[2 * e + 1] != v) {
+                throw invalidLink;
+            }
+            uint32_t other = a.edgeVerts[2 * e] == v ? a.edgeVerts[2 * e + 1] : a.edgeVerts[2 * e];
+            if(a.loopVert[l + 1 < end ? l + 1 : begin] != other) {
+                throw invalidLink;
+            }
+            edgeUsed[e] = 1;
+            uint32_t radial = a.loopRadial[l];
+            if(radial >= numLoops || a.loopEdge[radial] != e || radialReached[radial] != 0) {
+                throw invalidLink;
+            }
+            radialReached[radial] = 1;
+        }
+    }
+    for(std::size_t e = 0; e < numEdges; ++e) {
+        uint32_t l = a.edgeLoop[e];
+        bool valid = l == NO_INDEX ? edgeUsed[e] == 0 : l < numLoops && a.loopEdge[l] == e;
+        if(!valid) {
+            throw invalidLink;
+        }
+    }
+}
+
+} // namespace
+
+template<typename T>
+void Mesh::AppendToList(T*& head, const std::vector<T*>& elements) {
+    if(elements.empty()) {
+        return;
+    }
+    if(head == nullptr) {
+        head = elements.front();
+        elements.front()->mPrev = elements.back();
+        elements.back()->mNext = elements.front();
+        return;
+    }
+    T* tail = head->mPrev;
+    tail->mNext = elements.front();
+    elements.front()->mPrev = tail;
+    elements.back()->mNext = head;
+    head->mPrev = elements.back();
+}
+
+void Mesh::ToArrays(MeshArrays& arrays) const {
+    const uint32_t NO_INDEX = MeshArrays::NO_INDEX;
+
+    // number all elements, so that pointers can be stored using the index
+    std::vector<Vert*> srcVerts = std::vector<Vert*>();
+    srcVerts.reserve(vertCount);
+    for(Vert* vert : VertRange()) {
+        vert->index = srcVerts.size();
+        srcVerts.push_back(vert);
+    }
+    std::vector<Edge*> srcEdges = std::vector<Edge*>();
+    srcEdges.reserve(edgeCount);
+    for(Edge* edge : EdgeRange()) {
+        edge->index = srcEdges.size();
+        srcEdges.push_back(edge);
+    }
+    std::vector<Face*> srcFaces = std::vector<Face*>();
+    srcFaces.reserve(faceCount);
+    std::vector<Loop*> srcLoops = std::vector<Loop*>();
+    arrays.faceLoops = std::vector<uint32_t>();
+    arrays.faceLoops.reserve(faceCount + 1);
+    for(Face* face : FaceRange()) {
+        face->index = srcFaces.size();
+        srcFaces.push_back(face);
+        arrays.faceLoops.push_back(static_cast<uint32_t>(srcLoops.size()));
+        for(Loop* loop : face->LoopRange()) {
+            loop->index = srcLoops.size();
+            srcLoops.push_back(loop);
+        }
+    }
+    arrays.faceLoops.push_back(static_cast<uint32_t>(srcLoops.size()));
+    if(srcVerts.size() >= NO_INDEX || srcEdges.size() >= NO_INDEX || srcFaces.size() >= NO_INDEX
+        || srcLoops.size() >= NO_INDEX) {
+        throw std::invalid_argument("Too many elements.");
+    }
+
+    // every array entry is written by exactly one chunk
+    arrays.vertCo.resize(3 * srcVerts.size());
+    arrays.vertNo.resize(3 * srcVerts.size());
+    arrays.vertFlags.resize(srcVerts.size());
+    arrays.vertEdge.resize(srcVerts.size());
+    ParallelFor(srcVerts.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const Vert* vert = srcVerts[i];
+            arrays.vertCo[3 * i] = vert->Co().x;
+            arrays.vertCo[3 * i + 1] = vert->Co().y;
+            arrays.vertCo[3 * i + 2] = vert->Co().z;
+            arrays.vertNo[3 * i] = vert->No().x;
+            arrays.vertNo[3 * i + 1] = vert->No().y;
+            arrays.vertNo[3 * i + 2] = vert->No().z;
+            arrays.vertFlags[i] = vert->flags;
+            arrays.vertEdge[i] = vert->e == nullptr ? NO_INDEX : static_cast<uint32_t>(vert->e->index);
+        }
+    });
+
+    arrays.edgeVerts.resize(2 * srcEdges.size());
+    arrays.edgeDisk.resize(2 * srcEdges.size());
+    arrays.edgeLoop.resize(srcEdges.size());
+    arrays.edgeFlags.resize(srcEdges.size());
+    ParallelFor(srcEdges.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const Edge* edge = srcEdges[i];
+            arrays.edgeVerts[2 * i] = static_cast<uint32_t>(edge->v1->index);
+            arrays.edgeVerts[2 * i + 1] = static_cast<uint32_t>(edge->v2->index);
+            arrays.edgeDisk[2 * i] = static_cast<uint32_t>(edge->v1Next->index);
+            arrays.edgeDisk[2 * i + 1] = static_cast<uint32_t>(edge->v2Next->index);
+            arrays.edgeLoop[i] = edge->l == nullptr ? NO_INDEX : static_cast<uint32_t>(edge->l->index);
+            arrays.edgeFlags[i] = edge->flags;
+        }
+    });
+
+    arrays.faceNo.resize(3 * srcFaces.size());
+    arrays.faceMaterial.resize(srcFaces.size());
+    arrays.faceFlags.resize(srcFaces.size());
+    ParallelFor(srcFaces.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const Face* face = srcFaces[i];
+            arrays.faceNo[3 * i] = face->no.x;
+            arrays.faceNo[3 * i + 1] = face->no.y;
+            arrays.faceNo[3 * i + 2] = face->no.z;
+            arrays.faceMaterial[i] = face->materialIdx;
+            arrays.faceFlags[i] = face->flags;
+        }
+    });
+
+    arrays.loopVert.resize(srcLoops.size());
+    arrays.loopEdge.resize(srcLoops.size());
+    arrays.loopRadial.resize(srcLoops.size());
+    arrays.loopFlags.resize(srcLoops.size());
+    ParallelFor(srcLoops.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const Loop* loop = srcLoops[i];
+            arrays.loopVert[i] = static_cast<uint32_t>(loop->v->index);
+            arrays.loopEdge[i] = static_cast<uint32_t>(loop->e->index);
+            arrays.loopRadial[i] = static_cast<uint32_t>(loop->eNext->index);
+            arrays.loopFlags[i] = loop->flags;
+        }
+    });
+}
+
+void Mesh::FromArrays(const MeshArrays& arrays, std::size_t threadCount) {
+    const uint32_t NO_INDEX = MeshArrays::NO_INDEX;
+
+    // validate all links first, so that the mesh is left untouched on failure
+    CheckArrays(arrays);
+    std::size_t numVerts = arrays.vertFlags.size();
+    std::size_t numEdges = arrays.edgeFlags.size();
+    std::size_t numFaces = arrays.faceFlags.size();
+    std::size_t numLoops = arrays.loopFlags.size();
+
+    // new elements are appended behind the last element of every list, nothing else is changed
+    if(journal != nullptr) {
+        RecordChange(verts);
+        RecordChange(verts != nullptr ? verts->mPrev : nullptr);
+        RecordChange(edges);
+        RecordChange(edges != nullptr ? edges->mPrev : nullptr);
+        RecordChange(faces);
+        RecordChange(faces != nullptr ? faces->mPrev : nullptr);
+    }
+
+    // allocation is not thread safe, create all elements up front
+    Reserve(numVerts, numEdges, numFaces, numLoops);
+    std::vector<Vert*> newVerts = std::vector<Vert*>(numVerts);
+    for(std::size_t i = 0; i < numVerts; ++i) {
+        newVerts[i] = NewVert();
+        RecordCreated(newVerts[i]);
+    }
+    std::vector<Edge*> newEdges = std::vector<Edge*>(numEdges);
+    for(std::size_t i = 0; i < numEdges; ++i) {
+        newEdges[i] = NewEdge();
+        RecordCreated(newEdges[i]);
+    }
+    std::vector<Face*> newFaces = std::vector<Face*>(numFaces);
+    for(std::size_t i = 0; i < numFaces; ++i) {
+        newFaces[i] = NewFace();
+        RecordCreated(newFaces[i]);
+    }
+    std::vector<Loop*> newLoops = std::vector<Loop*>(numLoops);
+    for(std::size_t i = 0; i < numLoops; ++i) {
+        newLoops[i] = NewLoop();
+        RecordCreated(newLoops[i]);
+    }
+
+    // link the elements. every field is written by exactly one chunk: the previous entries of the disk and radial
+    // cycles are written by the element in front, all other fields by the element itself
+    ParallelFor(numVerts, GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Vert* vert = newVerts[i];
+            vert->Co() = Math::Vec3(arrays.vertCo[3 * i], arrays.vertCo[3 * i + 1], arrays.vertCo[3 * i + 2]);
+            vert->No() = Math::Vec3(arrays.vertNo[3 * i], arrays.vertNo[3 * i + 1], arrays.vertNo[3 * i + 2]);
+            vert->flags = arrays.vertFlags[i];
+            vert->e = arrays.vertEdge[i] == NO_INDEX ? nullptr : newEdges[arrays.vertEdge[i]];
+            vert->mNext = i + 1 < numVerts ? newVerts[i + 1] : nullptr;
+            vert->mPrev = i > 0 ? newVerts[i - 1] : nullptr;
+        }
+    });
+
+    ParallelFor(numEdges, GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Edge* edge = newEdges[i];
+            edge->v1 = newVerts[arrays.edgeVerts[2 * i]];
+            edge->v2 = newVerts[arrays.edgeVerts[2 * i + 1]];
+            edge->v1Next = newEdges[arrays.edgeDisk[2 * i]];
+            edge->v2Next = newEdges[arrays.edgeDisk[2 * i + 1]];
+            for(std::size_t side = 0; side < 2; ++side) {
+                std::size_t next = arrays.edgeDisk[2 * i + side];
+                if(DiskSide(arrays, next, arrays.edgeVerts[2 * i + side]) == 0) {
+                    newEdges[next]->v1Prev = edge;
+                } else {
+                    newEdges[next]->v2Prev = edge;
+                }
+            }
+            edge->l = arrays.edgeLoop[i] == NO_INDEX ? nullptr : newLoops[arrays.edgeLoop[i]];
+            edge->flags = arrays.edgeFlags[i];
+            edge->mNext = i + 1 < numEdges ? newEdges[i + 1] : nullptr;
+            edge->mPrev = i > 0 ? newEdges[i - 1] : nullptr;
+        }
+    });
+
+    ParallelFor(numFaces, GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Face* face = newFaces[i];
+            std::size_t first = arrays.faceLoops[i];
+            std::size_t last = arrays.faceLoops[i + 1] - 1;
+            face->l = newLoops[first];
+            face->no = Math::Vec3(arrays.faceNo[3 * i], arrays.faceNo[3 * i + 1], arrays.faceNo[3 * i + 2]);
+            face->materialIdx = arrays.faceMaterial[i];
+            face->flags = arrays.faceFlags[i];
+            face->mNext = i + 1 < numFaces ? newFaces[i + 1] : nullptr;
+            face->mPrev = i > 0 ? newFaces[i - 1] : nullptr;
+
+            for(std::size_t j = first; j <= last; ++j) {
+                Loop* loop = newLoops[j];
+                loop->v = newVerts[arrays.loopVert[j]];
+                loop->e = newEdges[arrays.loopEdge[j]];
+                loop->f = face;
+                loop->fNext = newLoops[j < last ? j + 1 : first];
+                loop->fPrev = newLoops[j > first ? j - 1 : last];
+                loop->eNext = newLoops[arrays.loopRadial[j]];
+                loop->eNext->ePrev = loop;
+                loop->flags = arrays.loopFlags[j];
+            }
+        }
+    });
+
+    AppendToList(verts, newVerts);
+    AppendToList(edges, newEdges);
+    AppendToList(faces, newFaces);
+    vertCount += numVerts;
+    edgeCount += numEdges;
+    faceCount += numFaces;
+    for(Edge* edge : newEdges) {
+        IndexEdge(edge);
+    }
+}
+
+} // namespace Core
+} // namespace Aoba
@@ -1,6 +1,7 @@
 #include "AobaAPI/Core/Mesh/Vert.hpp"
 
 #include "AobaAPI/Core/Mesh/Edge.hpp"
+#include "AobaAPI/Core/Mesh/Face.hpp"
 #include "AobaAPI/Core/Mesh/Loop.hpp"
 
 #include <algorithm>
@@ -13,13 +14,18 @@ Vert::Vert() {
     index = 0;
     flags = 0;
     flagsIntern = 0;
+    visited = 0;
     e = nullptr;
-    m = nullptr;
     mNext = nullptr;
     mPrev = nullptr;
+    slot = SlotDirectory<Vert>::NULL_SLOT;
+    classBits = 0;
 }
 
 bool Vert::IsBoundary() const {
+    if(classBits & CLASS_VALID) {
+        return (classBits & CLASS_BOUNDARY) != 0;
+    }
     if(this->e == nullptr) {
         return false; // Isolated vert
     }
@@ -35,6 +41,9 @@ bool Vert::IsBoundary() const {
 }
 
 bool Vert::IsManifold() const {
+    if(classBits & CLASS_VALID) {
+        return (classBits & CLASS_MANIFOLD) != 0;
+    }
     if(this->e == nullptr) {
         return false; // Isolated vert
     }
@@ -104,6 +113,9 @@ bool Vert::IsManifold() const {
 }
 
 bool Vert::IsWire() const {
+    if(classBits & CLASS_VALID) {
+        return (classBits & CLASS_WIRE) != 0;
+    }
     if(this->e == nullptr) {
         return false; // Isolated vert
     }
@@ -156,90 +168,23 @@ const std::vector<Face*> Vert::Faces() const {
 }
 
 const std::vector<Loop*> Vert::Loops() const {
-    // fetch loops using edges
     std::vector<Loop*> result = std::vector<Loop*>();
-    if(this->e == nullptr) {
-        return result; // no adjecent edges, therefore no adjecent loops
-    }
-    Edge* currentEdge = this->e;
-    while(this->e != currentEdge->Next(this)) {
-        Loop* currentLoop = currentEdge->l;
-        do {
-            if(currentLoop->v == this) {
-                result.push_back(currentLoop);
-            }
-            currentLoop = currentLoop->eNext;
-        } while(currentLoop != currentEdge->l);
-        currentEdge = currentEdge->Next(this);
+    for(Loop* loop : LoopRange()) {
+        result.push_back(loop);
     }
     return result;
 }
 
-const std::vector<Edge*> Vert::Edges(std::function<bool(const Edge* const)> func) const {
-    std::vector<Edge*> result = std::vector<Edge*>();
-    if(this->e == nullptr) {
-        return result; // no adjecent edges.
-    }
-    Edge* currentEdge = this->e;
-    if(func(currentEdge)) {
-        result.push_back(currentEdge);
-    }
-    while(this->e != currentEdge->Next(this)) {
-        currentEdge = currentEdge->Next(this);
-        if(func(currentEdge)) {
-            result.push_back(currentEdge);
-        }
-    }
-    return result;
+VertEdgeRange Vert::EdgeRange() const {
+    return VertEdgeRange(VertEdgeIterator(this, e), VertEdgeIterator());
 }
 
-
-const std::vector<Face*> Vert::Faces(std::function<bool(const Face* const)> func) const {
-    std::vector<Face*> result = std::vector<Face*>();
-    if(this->e == nullptr) {
-        return result;
-    }
-    // loop over all edges of this vert
-    Edge* currentEdge = this->e;
-    do {
-        // loop over all loops of the current edge
-        if(currentEdge->l != nullptr) {
-            Loop* currentLoop = currentEdge->l;
-            do {
-                if(func(currentLoop->f)) {
-                    // if the loop's face not already in the list, add it to the list
-                    if(std::find(result.begin(), result.end(), currentLoop->f) == result.end()) {
-                        result.push_back(currentLoop->f);
-                    }
-                }
-                currentLoop = currentLoop->eNext;
-            } while(currentEdge->l != currentLoop);
-        }
-        currentEdge = currentEdge->Next(this);
-    } while(this->e != currentEdge);
-    return result;
+VertFaceRange Vert::FaceRange() const {
+    return VertFaceRange(VertFaceIterator(this, e), VertFaceIterator());
 }
 
-const std::vector<Loop*> Vert::Loops(std::function<bool(const Loop* const)> func) const {
-    // fetch loops using edges
-    std::vector<Loop*> result = std::vector<Loop*>();
-    if(this->e == nullptr) {
-        return result; // no adjecent edges, therefore no adjecent loops
-    }
-    Edge* currentEdge = this->e;
-    while(this->e != currentEdge->Next(this)) {
-        Loop* currentLoop = currentEdge->l;
-        do {
-            if(currentLoop->v == this) {
-                if(func(currentLoop)) {
-                    result.push_back(currentLoop);
-                }
-            }
-            currentLoop = currentLoop->eNext;
-        } while(currentLoop != currentEdge->l);
-        currentEdge = currentEdge->Next(this);
-    }
-    return result;
+VertLoopRange Vert::LoopRange() const {
+    return VertLoopRange(VertLoopIterator(this, e), VertLoopIterator());
 }
 
 } // namespace Core
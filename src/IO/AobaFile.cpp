@@ -0,0 +1,249 @@
+#include "AobaAPI/IO/AobaFile.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Aoba {
+namespace IO {
+
+namespace {
+
+// layout of an aoba file:
+//   header         64 bytes, see FileHeader
+//   section table  one SectionEntry per section
+//   sections       every section starts at a multiple of ALIGNMENT, padded with zeros
+const char MAGIC[8] = {'A', 'O', 'B', 'A', 'M', 'E', 'S', 'H'};
+const uint32_t VERSION = 1;
+const uint32_t BYTE_ORDER_TAG = 0x01020304; // reads differently on machines with another byte order
+const std::size_t ALIGNMENT = 64;            // sections start at multiples of this
+const uint32_t MAX_SECTIONS = 1024;
+
+class FileHeader {
+  public:
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t sectionCount;
+    uint32_t reserved;
+    uint64_t vertCount;
+    uint64_t edgeCount;
+    uint64_t faceCount;
+    uint64_t loopCount;
+    uint64_t padding;
+};
+
+class SectionEntry {
+  public:
+    uint32_t id;          // identifies the array stored in the section
+    uint32_t elementSize; // size of a single number in bytes
+    uint64_t offset;      // position of the section in the file
+    uint64_t count;       // number of numbers in the section
+};
+
+static_assert(sizeof(FileHeader) == 64, "Header must not contain padding");
+static_assert(sizeof(SectionEntry) == 24, "Section entries must not contain padding");
+
+// call visit(id, array) for every array of MeshArrays. ids must never be reused, new arrays get new ids
+template<typename Visitor>
+void VisitSections(Core::MeshArrays& a, Visitor& visit) {
+    visit(1, a.vertCo);
+    visit(2, a.vertNo);
+    visit(3, a.vertFlags);
+    visit(4, a.vertEdge);
+    visit(5, a.edgeVerts);
+    visit(6, a.edgeDisk);
+    visit(7, a.edgeLoop);
+    visit(8, a.edgeFlags);
+    visit(9, a.faceLoops);
+    visit(10, a.faceNo);
+    visit(11, a.faceMaterial);
+    visit(12, a.faceFlags);
+    visit(13, a.loopVert);
+    visit(14, a.loopEdge);
+    visit(15, a.loopRadial);
+    visit(16, a.loopFlags);
+}
+
+std::size_t Align(std::size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+// collects the table entries and data of all sections, laid out behind the header and table
+class SectionWriter {
+  public:
+    std::vector<SectionEntry> table;
+    std::vector<const char*> data;
+    std::size_t end = 0; // end of the last section, including its padding
+
+    template<typename T>
+    void operator()(uint32_t id, const std::vector<T>& array) {
+        SectionEntry entry = SectionEntry();
+        entry.id = id;
+        entry.elementSize = sizeof(T);
+        entry.offset = 0;
+        entry.count = array.size();
+        table.push_back(entry);
+        data.push_back(reinterpret_cast<const char*>(array.data()));
+    }
+
+    void Layout() {
+        end = Align(sizeof(FileHeader) + sizeof(SectionEntry) * table.size());
+        for(SectionEntry& entry : table) {
+            entry.offset = end;
+            end = Align(end + entry.elementSize * entry.count);
+        }
+    }
+};
+
+// reads every section into its array using read(offset, data, size). arrays are sized by the table, after checking
+// that the section lies within the file
+template<typename Read>
+class SectionReader {
+  public:
+    const std::vector<SectionEntry>& table;
+    std::size_t fileSize;
+    Read& read;
+
+    SectionReader(const std::vector<SectionEntry>& table, std::size_t fileSize, Read& read) :
+        table(table), fileSize(fileSize), read(read) {
+    }
+
+    template<typename T>
+    void operator()(uint32_t id, std::vector<T>& array) {
+        const SectionEntry* found = nullptr;
+        for(const SectionEntry& entry : table) {
+            if(entry.id == id) {
+                found = &entry;
+            }
+        }
+        if(found == nullptr || found->elementSize != sizeof(T) || found->offset > fileSize
+            || found->count > (fileSize - found->offset) / sizeof(T)) {
+            throw std::invalid_argument("Aoba file is malformed.");
+        }
+        array.resize(static_cast<std::size_t>(found->count));
+        std::size_t size = sizeof(T) * array.size();
+        if(size > 0 && !read(static_cast<std::size_t>(found->offset), reinterpret_cast<char*>(array.data()), size)) {
+            throw std::invalid_argument("Aoba file is malformed.");
+        }
+    }
+};
+
+// write the file using write(data, size)
+template<typename Write>
+void WriteAoba(Core::Mesh* mesh, Write write) {
+    Core::MeshArrays arrays = Core::MeshArrays();
+    mesh->ToArrays(arrays);
+    SectionWriter sections = SectionWriter();
+    VisitSections(arrays, sections);
+    sections.Layout();
+
+    FileHeader header = FileHeader();
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_TAG;
+    header.sectionCount = static_cast<uint32_t>(sections.table.size());
+    header.vertCount = arrays.vertFlags.size();
+    header.edgeCount = arrays.edgeFlags.size();
+    header.faceCount = arrays.faceFlags.size();
+    header.loopCount = arrays.loopFlags.size();
+
+    const char zeros[ALIGNMENT] = {};
+    write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    write(reinterpret_cast<const char*>(sections.table.data()), sizeof(SectionEntry) * sections.table.size());
+    std::size_t position = sizeof(FileHeader) + sizeof(SectionEntry) * sections.table.size();
+    for(std::size_t i = 0; i < sections.table.size(); ++i) {
+        const SectionEntry& entry = sections.table[i];
+        write(zeros, entry.offset - position);
+        write(sections.data[i], entry.elementSize * entry.count);
+        position = entry.offset + entry.elementSize * entry.count;
+    }
+    write(zeros, sections.end - position);
+}
+
+// read a file of the given size using read(offset, data, size), which returns false if the range can not be read
+template<typename Read>
+void ReadAoba(std::size_t fileSize, Read read, Core::Mesh* mesh, std::size_t threadCount) {
+    FileHeader header = FileHeader();
+    if(fileSize < sizeof(FileHeader) || !read(0, reinterpret_cast<char*>(&header), sizeof(FileHeader))
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::invalid_argument("Not an aoba file.");
+    }
+    if(header.byteOrder != BYTE_ORDER_TAG) {
+        throw std::invalid_argument("Aoba file was saved using a different byte order.");
+    }
+    if(header.version > VERSION) {
+        throw std::invalid_argument("Aoba file was saved using a newer version.");
+    }
+    if(header.version == 0 || header.sectionCount > MAX_SECTIONS) {
+        throw std::invalid_argument("Aoba file is malformed.");
+    }
+
+    std::vector<SectionEntry> table = std::vector<SectionEntry>(header.sectionCount);
+    std::size_t tableSize = sizeof(SectionEntry) * table.size();
+    if(fileSize - sizeof(FileHeader) < tableSize
+        || (tableSize > 0 && !read(sizeof(FileHeader), reinterpret_cast<char*>(table.data()), tableSize))) {
+        throw std::invalid_argument("Aoba file is malformed.");
+    }
+
+    // sections of unknown ids are skipped
+    Core::MeshArrays arrays = Core::MeshArrays();
+    SectionReader<Read> sections = SectionReader<Read>(table, fileSize, read);
+    VisitSections(arrays, sections);
+    if(arrays.vertFlags.size() != header.vertCount || arrays.edgeFlags.size() != header.edgeCount
+        || arrays.faceFlags.size() != header.faceCount || arrays.loopFlags.size() != header.loopCount) {
+        throw std::invalid_argument("Aoba file is malformed.");
+    }
+
+    mesh->FromArrays(arrays, threadCount);
+}
+
+} // namespace
+
+void SaveAoba(std::string path, Core::Mesh* mesh) {
+    std::ofstream outFile(path, std::ios::out | std::ios::binary);
+    if(!outFile) {
+        throw std::invalid_argument("Could not open file " + path);
+    }
+    WriteAoba(mesh, [&](const char* data, std::size_t size) {
+        outFile.write(data, static_cast<std::streamsize>(size));
+    });
+    outFile.close();
+    if(!outFile) {
+        throw std::invalid_argument("Could not write file " + path);
+    }
+}
+
+void SaveAoba(std::vector<char>& buffer, Core::Mesh* mesh) {
+    buffer.clear();
+    WriteAoba(mesh, [&](const char* data, std::size_t size) {
+        buffer.insert(buffer.end(), data, data + size);
+    });
+}
+
+void LoadAoba(std::string path, Core::Mesh* mesh) {
+    LoadAoba(path, mesh, 0);
+}
+
+void LoadAoba(std::string path, Core::Mesh* mesh, std::size_t threadCount) {
+    std::ifstream inFile(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if(!inFile) {
+        throw std::invalid_argument("Could not open file " + path);
+    }
+    std::size_t fileSize = static_cast<std::size_t>(inFile.tellg());
+    ReadAoba(fileSize, [&](std::size_t offset, char* data, std::size_t size) {
+        inFile.seekg(static_cast<std::streamoff>(offset));
+        return static_cast<bool>(inFile.read(data, static_cast<std::streamsize>(size)));
+    }, mesh, threadCount);
+}
+
+void LoadAoba(const std::vector<char>& buffer, Core::Mesh* mesh, std::size_t threadCount) {
+    ReadAoba(buffer.size(), [&](std::size_t offset, char* data, std::size_t size) {
+        std::memcpy(data, buffer.data() + offset, size);
+        return true;
+    }, mesh, threadCount);
+}
+
+} // namespace IO
+} // namespace Aoba
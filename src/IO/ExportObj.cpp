@@ -1,11 +1,102 @@
 #include "AobaAPI/IO/ExportObj.hpp"
 
+#include "AobaAPI/IO/Text.hpp"
+
 #include <fstream>
+#include <unordered_map>
 
 namespace Aoba {
 namespace IO {
 
+namespace {
+
+const std::size_t CHUNK_SIZE = 16384;    // number of verts, faces or edges formatted by a single task
+const std::size_t CHUNKS_PER_BATCH = 64; // number of chunks formatted before they are written to the file
+
+// obj numbers of verts, looked up using the storage slot of the vert so that the mesh is not written to
+class VertNumbers {
+  private:
+    const Core::Mesh* mesh;
+    std::vector<std::size_t> bySlot;                             // number of the vert in every slot, 0 if unused
+    std::unordered_map<const Core::Vert*, std::size_t> unpooled; // verts which were not created using NewVert
+
+  public:
+    VertNumbers(const Core::Mesh* m, const std::vector<Core::Vert*>& verts, std::size_t threadCount) {
+        mesh = m;
+        std::vector<Core::VertHandle> handles = std::vector<Core::VertHandle>(verts.size());
+        Core::ParallelFor(verts.size(), CHUNK_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i) {
+                handles[i] = m->GetHandle(verts[i]);
+            }
+        });
+
+        std::size_t slotCount = 0;
+        for(const Core::VertHandle& handle : handles) {
+            if(!handle.IsNull() && handle.slot >= slotCount) {
+                slotCount = handle.slot + 1;
+            }
+        }
+        bySlot = std::vector<std::size_t>(slotCount, 0);
+        for(std::size_t i = 0; i < verts.size(); ++i) {
+            if(handles[i].IsNull()) {
+                unpooled[verts[i]] = i + 1;
+            } else {
+                bySlot[handles[i].slot] = i + 1;
+            }
+        }
+    }
+
+    std::size_t Get(const Core::Vert* v) const {
+        Core::VertHandle handle = mesh->GetHandle(v);
+        if(handle.IsNull()) {
+            return unpooled.at(v);
+        }
+        return bySlot[handle.slot];
+    }
+};
+
+// append "<prefix> <index> <index> ... \n"
+template<typename Range>
+void AppendIndices(std::string& out, const char* prefix, const Range& verts, const VertNumbers& numbers) {
+    char text[FORMAT_INDEX_MAX];
+    out += prefix;
+    for(const Core::Vert* v : verts) {
+        out.append(text, FormatIndex(numbers.Get(v), text));
+        out += ' ';
+    }
+    out += '\n';
+}
+
+// format count items in chunks on multiple threads, writing the chunks to the file in order
+template<typename Func>
+void WriteChunked(std::ofstream& outFile, std::size_t count, std::size_t threadCount, Func format) {
+    std::size_t chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<std::string> chunks = std::vector<std::string>(CHUNKS_PER_BATCH);
+    for(std::size_t batch = 0; batch < chunkCount; batch += CHUNKS_PER_BATCH) {
+        std::size_t batchSize = chunkCount - batch < CHUNKS_PER_BATCH ? chunkCount - batch : CHUNKS_PER_BATCH;
+        Core::ParallelFor(batchSize, 1, threadCount, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t c = begin; c < end; ++c) {
+                std::size_t first = (batch + c) * CHUNK_SIZE;
+                std::size_t last = first + CHUNK_SIZE < count ? first + CHUNK_SIZE : count;
+                chunks[c].clear();
+                for(std::size_t i = first; i < last; ++i) {
+                    format(chunks[c], i);
+                }
+            }
+        });
+        for(std::size_t c = 0; c < batchSize; ++c) {
+            outFile.write(chunks[c].data(), static_cast<std::streamsize>(chunks[c].size()));
+        }
+    }
+}
+
+} // namespace
+
 void ExportObj(std::string path, Core::Mesh* mesh) {
+    ExportObj(path, mesh, 0);
+}
+
+void ExportObj(std::string path, Core::Mesh* mesh, std::size_t threadCount) {
     std::ofstream outFile(path);
 
     outFile << "# AobaAPI test file \n";
@@ -14,40 +105,36 @@ void ExportObj(std::string path, Core::Mesh* mesh) {
     std::vector<Core::Vert*> verts = mesh->Verts();
     std::vector<Core::Face*> faces = mesh->Faces();
     std::vector<Core::Edge*> edges = mesh->Edges();
+    VertNumbers numbers = VertNumbers(mesh, verts, threadCount);
 
-    for(std::size_t i = 0; i < verts.size(); ++i) {
-        outFile << "v " << verts.at(i)->co.x << " " << verts.at(i)->co.y << " " << verts.at(i)->co.z << " \n";
-        verts.at(i)->index = i + 1;
-    }
+    WriteChunked(outFile, verts.size(), threadCount, [&](std::string& out, std::size_t i) {
+        char text[FORMAT_FLOAT_MAX];
+        const Math::Vec3& co = verts[i]->Co();
+        out += "v ";
+        out.append(text, FormatFloat(co.x, text));
+        out += ' ';
+        out.append(text, FormatFloat(co.y, text));
+        out += ' ';
+        out.append(text, FormatFloat(co.z, text));
+        out += " \n";
+    });
 
     outFile << "s off \n";
 
-    for(std::size_t i = 0; i < faces.size(); ++i) {
-        outFile << "f ";
+    // basic obj export, only do the single/first loop
+    WriteChunked(outFile, faces.size(), threadCount, [&](std::string& out, std::size_t i) {
+        AppendIndices(out, "f ", faces[i]->VertRange(), numbers);
+    });
 
-        // basic obj export, only do the single/first loop
-        std::vector<Core::Loop*> loops = faces.at(i)->Loops();
-
-        for(std::size_t j = 0; j < loops.size(); ++j) {
-            outFile << loops.at(j)->LoopVert()->index << " ";
-        }
-
-        outFile << "\n";
-    }
-
-    for(std::size_t i = 0; i < edges.size(); ++i) {
-        if(edges.at(i)->IsWire()) {
-            outFile << "l ";
-            for(std::size_t j = 0; j < 2; ++j) {
-                outFile << edges.at(i)->Verts().at(j)->index << " ";
-            }
-
-            outFile << "\n";
+    WriteChunked(outFile, edges.size(), threadCount, [&](std::string& out, std::size_t i) {
+        if(edges[i]->IsWire()) {
+            const Core::Vert* edgeVerts[] = {edges[i]->V1(), edges[i]->V2()};
+            AppendIndices(out, "l ", edgeVerts, numbers);
         }
-    }
+    });
 
     outFile.close();
 }
 
 } // namespace IO
-} // namespace Aoba
\ No newline at end of file
+} // namespace Aoba
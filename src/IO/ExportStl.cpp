@@ -1,67 +1,89 @@
 #include "AobaAPI/IO/ExportStl.hpp"
 
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 
 namespace Aoba {
 namespace IO {
 
-void ExportStl(std::string path, Core::Mesh* mesh) {
-    std::ofstream outFile(path, std::ios::out | std::ios::binary);
+namespace {
 
-    unsigned int triangleCount = 0;
+const std::size_t HEADER_SIZE = 84;   // empty 80 byte header, followed by the triangle count (uint32)
+const std::size_t TRIANGLE_SIZE = 50; // normal and 3 vertex coordinates (fp32), followed by the attribute (uint16)
+const std::size_t GRAIN_SIZE = 4096;  // minimal number of faces handled by a single thread
 
-    // write header, empty (80 bytes)
-    for(int i = 0; i < 80; ++i) {
-        outFile.put(0);
-    }
+// write a vector as 3 x fp32, returns the position behind it
+char* WriteVec3(char* out, const Math::Vec3& vec) {
+    std::memcpy(out, &vec.x, sizeof(float));
+    std::memcpy(out + 4, &vec.y, sizeof(float));
+    std::memcpy(out + 8, &vec.z, sizeof(float));
+    return out + 12;
+}
 
-    // write triangle count, populate later (4 bytes, uint32)
-    std::streampos triangleCountPos = outFile.tellp();
-    outFile.write(reinterpret_cast<const char*>(&triangleCount), sizeof(unsigned int));
+} // namespace
 
-    // using simple triangle fan triangulation
-    float zero = 0.0f;
-    std::vector<Core::Face*> faces = mesh->Faces();
-    for(Core::Face* f : faces) {
-        std::vector<Core::Loop*> fLoops = f->Loops();
-        std::size_t idx = 1;
-        while(idx + 1 < fLoops.size()) {
-            // increment triangle count
-            triangleCount++;
-
-            // write face normal (12 bytes, fp32)
-            outFile.write(reinterpret_cast<const char*>(&zero), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&zero), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&zero), sizeof(float));
-
-            // write vertex coordinates (3 x 12 bytesm fp32)
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(0)->LoopVert()->co.x), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(0)->LoopVert()->co.y), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(0)->LoopVert()->co.z), sizeof(float));
-
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(idx)->LoopVert()->co.x), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(idx)->LoopVert()->co.y), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(idx)->LoopVert()->co.z), sizeof(float));
-
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(idx + 1)->LoopVert()->co.x), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(idx + 1)->LoopVert()->co.y), sizeof(float));
-            outFile.write(reinterpret_cast<const char*>(&fLoops.at(idx + 1)->LoopVert()->co.z), sizeof(float));
-
-            // write attribute byte (2 bytes, uint16)
-            outFile.put(0);
-            outFile.put(0);
-
-            // increment loop idx
-            ++idx;
-        }
-    }
+void ExportStl(std::string path, Core::Mesh* mesh) {
+    ExportStl(path, mesh, 0);
+}
 
-    // go back, populate triangle count
-    outFile.seekp(triangleCountPos);
-    outFile.write(reinterpret_cast<const char*>(&triangleCount), sizeof(unsigned int));
+void ExportStl(std::string path, Core::Mesh* mesh, std::size_t threadCount) {
+    std::vector<char> buffer = std::vector<char>();
+    ExportStl(buffer, mesh, threadCount);
 
+    std::ofstream outFile(path, std::ios::out | std::ios::binary);
+    outFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
     outFile.close();
 }
 
+void ExportStl(std::vector<char>& buffer, Core::Mesh* mesh, std::size_t threadCount) {
+    std::vector<Core::Face*> faces = mesh->Faces();
+
+    // every face is triangulated into a fan, the triangles of a face are stored behind those of the previous faces
+    std::vector<std::size_t> offsets = std::vector<std::size_t>(faces.size() + 1, 0);
+    Core::ParallelFor(faces.size(), GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            offsets[i + 1] = faces[i]->LoopRange().Size() - 2;
+        }
+    });
+    for(std::size_t i = 0; i < faces.size(); ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    uint32_t triangleCount = static_cast<uint32_t>(offsets.back());
+
+    // header and attributes stay empty
+    buffer.assign(HEADER_SIZE + TRIANGLE_SIZE * offsets.back(), 0);
+    std::memcpy(buffer.data() + 80, &triangleCount, sizeof(uint32_t));
+
+    Core::ParallelFor(faces.size(), GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            char* out = buffer.data() + HEADER_SIZE + TRIANGLE_SIZE * offsets[i];
+
+            Core::FaceVertRange fVerts = faces[i]->VertRange();
+            Core::FaceVertIterator it = fVerts.begin();
+            const Math::Vec3& first = (*it)->Co();
+            ++it;
+            const Math::Vec3* prev = &(*it)->Co();
+            ++it;
+            for(; it != fVerts.end(); ++it) {
+                const Math::Vec3& current = (*it)->Co();
+
+                // normal of the fan triangle, zero for degenerate triangles
+                Math::Vec3 no = (*prev - first).Cross(current - first);
+                float length = no.Length();
+                no = length > 0.0f ? no / length : Math::Vec3(0, 0, 0);
+
+                out = WriteVec3(out, no);
+                out = WriteVec3(out, first);
+                out = WriteVec3(out, *prev);
+                out = WriteVec3(out, current);
+                out += 2;
+
+                prev = &current;
+            }
+        }
+    });
+}
+
 } // namespace IO
-} // namespace Aoba
\ No newline at end of file
+} // namespace Aoba
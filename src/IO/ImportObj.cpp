@@ -0,0 +1,374 @@
+#include "AobaAPI/IO/ImportObj.hpp"
+
+#include "AobaAPI/IO/Text.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace Aoba {
+namespace IO {
+
+namespace {
+
+const std::size_t CHUNK_SIZE = 262144; // minimal number of characters parsed by a single task
+const std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max(); // position of an index which does not exist
+
+// records of a range of lines. indices are resolved to 0 based vert indices, negative indices are resolved relative
+// to the first vert of the chunk, their positions are listed so that the offset of the chunk can be added later
+class ObjChunk {
+  public:
+    std::vector<float> positions;
+    std::vector<std::size_t> faceSizes;
+    std::vector<int64_t> faceIndices;
+    std::vector<std::size_t> relativeFaceIndices;
+    std::vector<int64_t> edgeIndices;
+    std::vector<std::size_t> relativeEdgeIndices;
+    std::size_t lines = 0;       // number of lines parsed
+    const char* error = nullptr; // description of the first malformed line, which is the last line parsed
+    std::size_t badFaceIndex = NO_INDEX; // position of the first face index which refers to a vert which does not exist
+    std::size_t badEdgeIndex = NO_INDEX; // position of the first line index which refers to a vert which does not exist
+};
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void SkipSpace(const char*& p, const char* end) {
+    while(p < end && IsSpace(*p)) {
+        ++p;
+    }
+}
+
+// read a face or line index like "7", "-2" or "7/1/3", only the vert index is used
+bool ParseIndex(const char*& p, const char* end, ObjChunk& chunk, std::vector<int64_t>& indices,
+    std::vector<std::size_t>& relative) {
+    bool negative = false;
+    if(p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        ++p;
+    }
+    int64_t value = 0;
+    int digits = 0;
+    for(; p < end && *p >= '0' && *p <= '9'; ++p) {
+        if(digits < 18) {
+            value = value * 10 + (*p - '0');
+        }
+        digits++;
+    }
+    if(digits == 0 || digits > 18 || value == 0) {
+        return false;
+    }
+    while(p < end && !IsSpace(*p)) {
+        if(*p != '/') {
+            return false;
+        }
+        for(++p; p < end && ((*p >= '0' && *p <= '9') || *p == '-'); ++p) {
+        }
+    }
+
+    if(negative) {
+        relative.push_back(indices.size());
+        indices.push_back(static_cast<int64_t>(chunk.positions.size() / 3) - value);
+    } else {
+        indices.push_back(value - 1);
+    }
+    return true;
+}
+
+void ParseLine(const char* p, const char* end, ObjChunk& chunk) {
+    // everything behind a '#' is a comment, on any kind of line
+    const char* comment = static_cast<const char*>(std::memchr(p, '#', static_cast<std::size_t>(end - p)));
+    if(comment != nullptr) {
+        end = comment;
+    }
+    SkipSpace(p, end);
+    const char* keyword = p;
+    while(p < end && !IsSpace(*p)) {
+        ++p;
+    }
+    std::size_t keywordLength = static_cast<std::size_t>(p - keyword);
+    if(keywordLength != 1) {
+        return;
+    }
+
+    if(*keyword == 'v') {
+        // an optional fourth coordinate is ignored
+        for(int i = 0; i < 3; ++i) {
+            SkipSpace(p, end);
+            float value = 0.0f;
+            std::size_t length = ParseFloat(p, static_cast<std::size_t>(end - p), value);
+            if(length == 0 || (p + length < end && !IsSpace(p[length]))) {
+                chunk.error = "Vert must have three coordinates";
+                return;
+            }
+            chunk.positions.push_back(value);
+            p += length;
+        }
+    } else if(*keyword == 'f') {
+        std::size_t count = 0;
+        for(SkipSpace(p, end); p < end; SkipSpace(p, end)) {
+            if(!ParseIndex(p, end, chunk, chunk.faceIndices, chunk.relativeFaceIndices)) {
+                chunk.error = "Invalid face index";
+                return;
+            }
+            count++;
+        }
+        if(count < 3) {
+            chunk.error = "Face must have at least three verts";
+            return;
+        }
+        chunk.faceSizes.push_back(count);
+    } else if(*keyword == 'l') {
+        // a line through several verts is split into one edge per segment
+        std::size_t count = 0;
+        for(SkipSpace(p, end); p < end; SkipSpace(p, end)) {
+            if(count >= 2) {
+                chunk.edgeIndices.push_back(chunk.edgeIndices.back());
+                if(!chunk.relativeEdgeIndices.empty()
+                    && chunk.relativeEdgeIndices.back() == chunk.edgeIndices.size() - 2) {
+                    chunk.relativeEdgeIndices.push_back(chunk.edgeIndices.size() - 1);
+                }
+            }
+            if(!ParseIndex(p, end, chunk, chunk.edgeIndices, chunk.relativeEdgeIndices)) {
+                chunk.error = "Invalid line index";
+                return;
+            }
+            count++;
+        }
+        if(count < 2) {
+            chunk.error = "Line must have at least two verts";
+            return;
+        }
+    }
+}
+
+void ParseChunk(const char* p, const char* end, ObjChunk& chunk) {
+    while(p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if(lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        chunk.lines++;
+        ParseLine(p, lineEnd, chunk);
+        if(chunk.error != nullptr) {
+            return;
+        }
+        p = lineEnd < end ? lineEnd + 1 : end;
+    }
+}
+
+// add the offset of the chunk to relative indices, and copy the indices if all of them refer to existing verts.
+// otherwise the position of the first index which does not is stored in bad
+void ResolveIndices(std::vector<int64_t>& indices, const std::vector<std::size_t>& relative, int64_t vertOffset,
+    int64_t vertCount, std::size_t* out, std::size_t& bad) {
+    for(std::size_t i : relative) {
+        indices[i] += vertOffset;
+    }
+    for(std::size_t i = 0; i < indices.size(); ++i) {
+        if(indices[i] < 0 || indices[i] >= vertCount) {
+            bad = i;
+            return;
+        }
+        out[i] = static_cast<std::size_t>(indices[i]);
+    }
+}
+
+// parse the lines of a chunk again until the face or line index at the given position is reached, errors are rare
+// enough that the lines of the indices are not kept while parsing
+std::size_t LineOfIndex(const char* p, const char* end, std::size_t faceIndex, std::size_t edgeIndex) {
+    ObjChunk chunk = ObjChunk();
+    while(p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if(lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        chunk.lines++;
+        ParseLine(p, lineEnd, chunk);
+        if(chunk.faceIndices.size() > faceIndex || chunk.edgeIndices.size() > edgeIndex) {
+            break;
+        }
+        p = lineEnd < end ? lineEnd + 1 : end;
+    }
+    return chunk.lines;
+}
+
+// the verts of a face, walked from its smallest vert index towards the smaller of its neighbors, so that all
+// rotations and both orientations of the same polygon are walked in the same order
+class FaceCycle {
+  public:
+    FaceCycle(const std::size_t* indices, std::size_t size) : indices(indices), size(size), start(0), forward(true) {
+        for(std::size_t i = 1; i < size; ++i) {
+            if(indices[i] < indices[start]) {
+                start = i;
+            }
+        }
+        forward = indices[(start + 1) % size] < indices[(start + size - 1) % size];
+    }
+
+    std::size_t operator[](std::size_t i) const {
+        return forward ? indices[(start + i) % size] : indices[(start + size - i) % size];
+    }
+
+    bool operator==(const FaceCycle& other) const {
+        if(size != other.size) {
+            return false;
+        }
+        for(std::size_t i = 0; i < size; ++i) {
+            if((*this)[i] != other[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct Hasher {
+        std::size_t operator()(const FaceCycle& cycle) const {
+            std::size_t result = cycle.size;
+            for(std::size_t i = 0; i < cycle.size; ++i) {
+                result = result * 0x9e3779b97f4a7c15ULL + cycle[i];
+            }
+            return result;
+        }
+    };
+
+  private:
+    const std::size_t* indices;
+    std::size_t size;
+    std::size_t start;
+    bool forward;
+};
+
+// remove faces which repeat the verts of an earlier face in the same cyclic order, in either orientation
+void DropRepeatedFaces(std::vector<std::size_t>& faceStarts, std::vector<std::size_t>& faceIndices) {
+    std::size_t faceCount = faceStarts.size() - 1;
+    std::unordered_set<FaceCycle, FaceCycle::Hasher> cycles = std::unordered_set<FaceCycle, FaceCycle::Hasher>();
+    cycles.reserve(faceCount);
+    std::vector<bool> repeated = std::vector<bool>(faceCount, false);
+    std::size_t repeatedCount = 0;
+    for(std::size_t i = 0; i < faceCount; ++i) {
+        FaceCycle cycle = FaceCycle(faceIndices.data() + faceStarts[i], faceStarts[i + 1] - faceStarts[i]);
+        if(!cycles.insert(cycle).second) {
+            repeated[i] = true;
+            repeatedCount++;
+        }
+    }
+    if(repeatedCount == 0) {
+        return;
+    }
+
+    // the cycles refer to the indices, so the kept faces are copied
+    std::vector<std::size_t> keptStarts = std::vector<std::size_t>(1, 0);
+    std::vector<std::size_t> keptIndices = std::vector<std::size_t>();
+    keptStarts.reserve(faceCount - repeatedCount + 1);
+    keptIndices.reserve(faceIndices.size());
+    for(std::size_t i = 0; i < faceCount; ++i) {
+        if(!repeated[i]) {
+            keptIndices.insert(keptIndices.end(), faceIndices.begin() + faceStarts[i],
+                faceIndices.begin() + faceStarts[i + 1]);
+            keptStarts.push_back(keptIndices.size());
+        }
+    }
+    faceStarts.swap(keptStarts);
+    faceIndices.swap(keptIndices);
+}
+
+} // namespace
+
+void ImportObj(std::string path, Core::Mesh* mesh) {
+    ImportObj(path, mesh, 0);
+}
+
+void ImportObj(std::string path, Core::Mesh* mesh, std::size_t threadCount) {
+    std::ifstream inFile(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if(!inFile) {
+        throw std::invalid_argument("Could not open file " + path);
+    }
+    std::vector<char> buffer = std::vector<char>(static_cast<std::size_t>(inFile.tellg()));
+    inFile.seekg(0);
+    if(!inFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+        throw std::invalid_argument("Could not read file " + path);
+    }
+    inFile.close();
+
+    ImportObj(buffer, mesh, threadCount);
+}
+
+void ImportObj(const std::vector<char>& buffer, Core::Mesh* mesh, std::size_t threadCount) {
+    // split the text into chunks which end behind a line break
+    const char* data = buffer.data();
+    std::vector<std::size_t> bounds = std::vector<std::size_t>(1, 0);
+    while(bounds.back() < buffer.size()) {
+        std::size_t end = buffer.size() - bounds.back() > CHUNK_SIZE ? bounds.back() + CHUNK_SIZE : buffer.size();
+        while(end < buffer.size() && data[end - 1] != '\n') {
+            ++end;
+        }
+        bounds.push_back(end);
+    }
+
+    std::vector<ObjChunk> chunks = std::vector<ObjChunk>(bounds.size() - 1);
+    Core::ParallelFor(chunks.size(), 1, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t c = begin; c < end; ++c) {
+            ParseChunk(data + bounds[c], data + bounds[c + 1], chunks[c]);
+        }
+    });
+
+    // position of every chunk in the combined arrays
+    std::vector<std::size_t> vertOffsets = std::vector<std::size_t>(chunks.size() + 1, 0);
+    std::vector<std::size_t> faceOffsets = std::vector<std::size_t>(chunks.size() + 1, 0);
+    std::vector<std::size_t> faceIndexOffsets = std::vector<std::size_t>(chunks.size() + 1, 0);
+    std::vector<std::size_t> edgeIndexOffsets = std::vector<std::size_t>(chunks.size() + 1, 0);
+    std::size_t line = 0;
+    for(std::size_t c = 0; c < chunks.size(); ++c) {
+        line += chunks[c].lines;
+        if(chunks[c].error != nullptr) {
+            throw std::invalid_argument(std::string(chunks[c].error) + " in line " + std::to_string(line));
+        }
+        vertOffsets[c + 1] = vertOffsets[c] + chunks[c].positions.size() / 3;
+        faceOffsets[c + 1] = faceOffsets[c] + chunks[c].faceSizes.size();
+        faceIndexOffsets[c + 1] = faceIndexOffsets[c] + chunks[c].faceIndices.size();
+        edgeIndexOffsets[c + 1] = edgeIndexOffsets[c] + chunks[c].edgeIndices.size();
+    }
+
+    std::vector<float> positions = std::vector<float>(vertOffsets.back() * 3);
+    std::vector<std::size_t> faceStarts = std::vector<std::size_t>(faceOffsets.back() + 1, faceIndexOffsets.back());
+    std::vector<std::size_t> faceIndices = std::vector<std::size_t>(faceIndexOffsets.back());
+    std::vector<std::size_t> edgeIndices = std::vector<std::size_t>(edgeIndexOffsets.back());
+    Core::ParallelFor(chunks.size(), 1, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t c = begin; c < end; ++c) {
+            ObjChunk& chunk = chunks[c];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + vertOffsets[c] * 3);
+
+            std::size_t start = faceIndexOffsets[c];
+            for(std::size_t i = 0; i < chunk.faceSizes.size(); ++i) {
+                faceStarts[faceOffsets[c] + i] = start;
+                start += chunk.faceSizes[i];
+            }
+
+            int64_t vertOffset = static_cast<int64_t>(vertOffsets[c]);
+            int64_t vertCount = static_cast<int64_t>(vertOffsets.back());
+            ResolveIndices(chunk.faceIndices, chunk.relativeFaceIndices, vertOffset, vertCount,
+                faceIndices.data() + faceIndexOffsets[c], chunk.badFaceIndex);
+            ResolveIndices(chunk.edgeIndices, chunk.relativeEdgeIndices, vertOffset, vertCount,
+                edgeIndices.data() + edgeIndexOffsets[c], chunk.badEdgeIndex);
+        }
+    });
+    line = 0;
+    for(std::size_t c = 0; c < chunks.size(); ++c) {
+        if(chunks[c].badFaceIndex != NO_INDEX || chunks[c].badEdgeIndex != NO_INDEX) {
+            line += LineOfIndex(data + bounds[c], data + bounds[c + 1], chunks[c].badFaceIndex, chunks[c].badEdgeIndex);
+            throw std::invalid_argument("Vert index out of range in line " + std::to_string(line));
+        }
+        line += chunks[c].lines;
+    }
+
+    DropRepeatedFaces(faceStarts, faceIndices);
+    mesh->FromIndexed(positions, faceStarts, faceIndices, edgeIndices);
+}
+
+} // namespace IO
+} // namespace Aoba
@@ -0,0 +1,502 @@
+#include "AobaAPI/IO/ImportStl.hpp"
+
+#include "AobaAPI/IO/Text.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace Aoba {
+namespace IO {
+
+namespace {
+
+const std::size_t HEADER_SIZE = 84;    // 80 byte header, followed by the triangle count (uint32)
+const std::size_t TRIANGLE_SIZE = 50;  // normal and 3 corner coordinates (fp32), followed by the attribute (uint16)
+const std::size_t CHUNK_SIZE = 262144; // minimal number of characters parsed by a single task
+const std::size_t GRAIN_SIZE = 4096;   // minimal number of corners handled by a single thread
+const std::size_t SHARD_COUNT = 64;    // number of independent hash tables, filled in parallel
+const double MAX_CELL = 4.0e18;        // cell coordinates beyond this do not fit into 64 bits
+
+uint64_t Mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// corners of a triangle in ascending order, so that triangles using the same points in any order are equal
+class TriangleKey {
+  public:
+    TriangleKey(std::size_t a, std::size_t b, std::size_t c) {
+        if(a > b) {
+            std::swap(a, b);
+        }
+        if(b > c) {
+            std::swap(b, c);
+        }
+        if(a > b) {
+            std::swap(a, b);
+        }
+        corners[0] = a;
+        corners[1] = b;
+        corners[2] = c;
+    }
+
+    bool operator==(const TriangleKey& other) const {
+        return corners[0] == other.corners[0] && corners[1] == other.corners[1] && corners[2] == other.corners[2];
+    }
+
+    struct Hasher {
+        std::size_t operator()(const TriangleKey& key) const {
+            return static_cast<std::size_t>(Mix(Mix(Mix(key.corners[0]) + key.corners[1]) + key.corners[2]));
+        }
+    };
+
+  private:
+    std::size_t corners[3];
+};
+
+// exact coordinates of a corner, -0 and 0 are the same
+class CornerKey {
+  public:
+    uint32_t x, y, z;
+
+    CornerKey(const Math::Vec3& co) {
+        float values[] = {co.x == 0.0f ? 0.0f : co.x, co.y == 0.0f ? 0.0f : co.y, co.z == 0.0f ? 0.0f : co.z};
+        std::memcpy(&x, &values[0], sizeof(uint32_t));
+        std::memcpy(&y, &values[1], sizeof(uint32_t));
+        std::memcpy(&z, &values[2], sizeof(uint32_t));
+    }
+
+    bool operator==(const CornerKey& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+// grid cell of the spatial hash, the edge length of a cell is half of epsilon
+class CellKey {
+  public:
+    int64_t x, y, z;
+
+    bool operator==(const CellKey& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+class KeyHash {
+  public:
+    std::size_t operator()(const CornerKey& key) const {
+        return static_cast<std::size_t>(Mix((uint64_t(key.x) << 32 | key.y) ^ Mix(key.z)));
+    }
+
+    std::size_t operator()(const CellKey& key) const {
+        return static_cast<std::size_t>(Mix(uint64_t(key.x) ^ Mix(uint64_t(key.y) ^ Mix(uint64_t(key.z)))));
+    }
+};
+
+// shard of a key, independent of the bucket used by the hash table of the shard
+template<typename Key>
+std::size_t ShardOf(const Key& key) {
+    return Mix(KeyHash()(key) + 1) % SHARD_COUNT;
+}
+
+// sort the items [0, count) by shard, keeping their order within each shard. items of shard s are stored in
+// order[offsets[s]] up to order[offsets[s + 1]]
+void SplitShards(const std::vector<std::size_t>& shards, std::vector<std::size_t>& order,
+    std::vector<std::size_t>& offsets) {
+    offsets = std::vector<std::size_t>(SHARD_COUNT + 1, 0);
+    for(std::size_t shard : shards) {
+        offsets[shard + 1]++;
+    }
+    for(std::size_t s = 0; s < SHARD_COUNT; ++s) {
+        offsets[s + 1] += offsets[s];
+    }
+    std::vector<std::size_t> next = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+    order = std::vector<std::size_t>(shards.size());
+    for(std::size_t i = 0; i < shards.size(); ++i) {
+        order[next[shards[i]]++] = i;
+    }
+}
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// collect the coordinates of all vertex lines of an ascii file
+class AsciiChunk {
+  public:
+    std::vector<Math::Vec3> corners;
+    std::size_t lines = 0; // number of lines parsed
+    bool error = false;    // wether the last line parsed is a malformed vertex line
+};
+
+void ParseAsciiChunk(const char* p, const char* end, AsciiChunk& chunk) {
+    while(p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if(lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        chunk.lines++;
+
+        while(p < lineEnd && IsSpace(*p)) {
+            ++p;
+        }
+        if(lineEnd - p > 6 && std::memcmp(p, "vertex", 6) == 0 && IsSpace(p[6])) {
+            p += 6;
+            float co[3];
+            for(int i = 0; i < 3; ++i) {
+                while(p < lineEnd && IsSpace(*p)) {
+                    ++p;
+                }
+                std::size_t length = ParseFloat(p, static_cast<std::size_t>(lineEnd - p), co[i]);
+                if(length == 0 || (p + length < lineEnd && !IsSpace(p[length]))) {
+                    chunk.error = true;
+                    return;
+                }
+                p += length;
+            }
+            chunk.corners.push_back(Math::Vec3(co[0], co[1], co[2]));
+        }
+        p = lineEnd < end ? lineEnd + 1 : end;
+    }
+}
+
+void ParseAscii(const std::vector<char>& buffer, std::size_t threadCount, std::vector<Math::Vec3>& corners) {
+    // split the text into chunks which end behind a line break
+    const char* data = buffer.data();
+    std::vector<std::size_t> bounds = std::vector<std::size_t>(1, 0);
+    while(bounds.back() < buffer.size()) {
+        std::size_t end = buffer.size() - bounds.back() > CHUNK_SIZE ? bounds.back() + CHUNK_SIZE : buffer.size();
+        while(end < buffer.size() && data[end - 1] != '\n') {
+            ++end;
+        }
+        bounds.push_back(end);
+    }
+
+    std::vector<AsciiChunk> chunks = std::vector<AsciiChunk>(bounds.size() - 1);
+    Core::ParallelFor(chunks.size(), 1, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t c = begin; c < end; ++c) {
+            ParseAsciiChunk(data + bounds[c], data + bounds[c + 1], chunks[c]);
+        }
+    });
+
+    std::size_t line = 0;
+    std::size_t count = 0;
+    for(const AsciiChunk& chunk : chunks) {
+        line += chunk.lines;
+        if(chunk.error) {
+            throw std::invalid_argument("Vertex must have three coordinates in line " + std::to_string(line));
+        }
+        count += chunk.corners.size();
+    }
+    if(count % 3 != 0) {
+        throw std::invalid_argument("Facet must have three verts");
+    }
+    corners.reserve(count);
+    for(const AsciiChunk& chunk : chunks) {
+        corners.insert(corners.end(), chunk.corners.begin(), chunk.corners.end());
+    }
+}
+
+void ParseBinary(const std::vector<char>& buffer, std::size_t triangleCount, std::size_t threadCount,
+    std::vector<Math::Vec3>& corners) {
+    corners = std::vector<Math::Vec3>(triangleCount * 3);
+    Core::ParallelFor(triangleCount, GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t t = begin; t < end; ++t) {
+            // skip the normal
+            const char* in = buffer.data() + HEADER_SIZE + TRIANGLE_SIZE * t + 12;
+            for(std::size_t k = 0; k < 3; ++k) {
+                float co[3];
+                std::memcpy(co, in + 12 * k, sizeof(co));
+                corners[3 * t + k] = Math::Vec3(co[0], co[1], co[2]);
+            }
+        }
+    });
+}
+
+// for every corner, the first corner with the same coordinates
+void FindDuplicates(const std::vector<Math::Vec3>& corners, std::size_t threadCount, std::vector<std::size_t>& first) {
+    std::vector<std::size_t> shards = std::vector<std::size_t>(corners.size());
+    Core::ParallelFor(corners.size(), GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            shards[i] = ShardOf(CornerKey(corners[i]));
+        }
+    });
+    std::vector<std::size_t> order = std::vector<std::size_t>();
+    std::vector<std::size_t> offsets = std::vector<std::size_t>();
+    SplitShards(shards, order, offsets);
+
+    first = std::vector<std::size_t>(corners.size());
+    Core::ParallelFor(SHARD_COUNT, 1, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t s = begin; s < end; ++s) {
+            std::unordered_map<CornerKey, std::size_t, KeyHash> table =
+                std::unordered_map<CornerKey, std::size_t, KeyHash>();
+            table.reserve(offsets[s + 1] - offsets[s]);
+            for(std::size_t j = offsets[s]; j < offsets[s + 1]; ++j) {
+                std::size_t i = order[j];
+                first[i] = table.emplace(CornerKey(corners[i]), i).first->second;
+            }
+        }
+    });
+}
+
+std::size_t FindRoot(std::vector<std::size_t>& parents, std::size_t i) {
+    while(parents[i] != i) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+// for every point, the first point which is connected to it through a chain of points closer than epsilon
+void FindClusters(const std::vector<Math::Vec3>& points, float epsilon, std::size_t threadCount,
+    std::vector<std::size_t>& roots) {
+    // the points of a cell are closer than epsilon to each other, close points are at most two cells apart.
+    // points with coordinates too large for the grid are not welded
+    const double cellSize = static_cast<double>(epsilon) / 2;
+    std::vector<CellKey> cells = std::vector<CellKey>(points.size());
+    std::vector<bool> inGrid = std::vector<bool>(points.size());
+    std::vector<std::size_t> shards = std::vector<std::size_t>(points.size());
+    Core::ParallelFor(points.size(), GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            double x = std::floor(points[i].x / cellSize);
+            double y = std::floor(points[i].y / cellSize);
+            double z = std::floor(points[i].z / cellSize);
+            if(!(std::fabs(x) < MAX_CELL && std::fabs(y) < MAX_CELL && std::fabs(z) < MAX_CELL)) {
+                shards[i] = SHARD_COUNT;
+                continue;
+            }
+            cells[i].x = static_cast<int64_t>(x);
+            cells[i].y = static_cast<int64_t>(y);
+            cells[i].z = static_cast<int64_t>(z);
+            shards[i] = ShardOf(cells[i]);
+        }
+    });
+    // vector<bool> can not be written by multiple threads
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        inGrid[i] = shards[i] != SHARD_COUNT;
+        if(!inGrid[i]) {
+            shards[i] = 0;
+        }
+    }
+    std::vector<std::size_t> order = std::vector<std::size_t>();
+    std::vector<std::size_t> offsets = std::vector<std::size_t>();
+    SplitShards(shards, order, offsets);
+
+    // every cell stores its first point, the points of a cell are linked in order
+    const std::size_t NONE = points.size();
+    std::vector<std::unordered_map<CellKey, std::size_t, KeyHash>> tables =
+        std::vector<std::unordered_map<CellKey, std::size_t, KeyHash>>(SHARD_COUNT);
+    std::vector<std::size_t> nextInCell = std::vector<std::size_t>(points.size(), NONE);
+    Core::ParallelFor(SHARD_COUNT, 1, threadCount, [&](std::size_t begin, std::size_t end) {
+        std::unordered_map<CellKey, std::size_t, KeyHash> lasts = std::unordered_map<CellKey, std::size_t, KeyHash>();
+        for(std::size_t s = begin; s < end; ++s) {
+            lasts.clear();
+            tables[s].reserve(offsets[s + 1] - offsets[s]);
+            for(std::size_t j = offsets[s]; j < offsets[s + 1]; ++j) {
+                std::size_t i = order[j];
+                if(!inGrid[i]) {
+                    continue;
+                }
+                std::pair<std::unordered_map<CellKey, std::size_t, KeyHash>::iterator, bool> last =
+                    lasts.emplace(cells[i], i);
+                if(last.second) {
+                    tables[s].emplace(cells[i], i);
+                } else {
+                    nextInCell[last.first->second] = i;
+                    last.first->second = i;
+                }
+            }
+        }
+    });
+
+    // pairs of close points, collected per block of points. the tables are only read.
+    // the points of a cell are connected anyway, so every point is paired with at most one earlier point per cell
+    const std::size_t BLOCK_SIZE = 4096;
+    const double epsilonSquared = static_cast<double>(epsilon) * epsilon;
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> pairs =
+        std::vector<std::vector<std::pair<std::size_t, std::size_t>>>((points.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    Core::ParallelFor(pairs.size(), 1, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t b = begin; b < end; ++b) {
+            std::size_t last = (b + 1) * BLOCK_SIZE < points.size() ? (b + 1) * BLOCK_SIZE : points.size();
+            for(std::size_t i = b * BLOCK_SIZE; i < last; ++i) {
+                if(!inGrid[i]) {
+                    continue;
+                }
+                for(int64_t dx = -2; dx <= 2; ++dx) {
+                    for(int64_t dy = -2; dy <= 2; ++dy) {
+                        for(int64_t dz = -2; dz <= 2; ++dz) {
+                            CellKey cell = {cells[i].x + dx, cells[i].y + dy, cells[i].z + dz};
+                            const std::unordered_map<CellKey, std::size_t, KeyHash>& table = tables[ShardOf(cell)];
+                            std::unordered_map<CellKey, std::size_t, KeyHash>::const_iterator it = table.find(cell);
+                            if(it == table.end()) {
+                                continue;
+                            }
+                            // only earlier points, so that every pair of cells is handled once
+                            for(std::size_t j = it->second; j < i; j = nextInCell[j]) {
+                                double x = static_cast<double>(points[i].x) - points[j].x;
+                                double y = static_cast<double>(points[i].y) - points[j].y;
+                                double z = static_cast<double>(points[i].z) - points[j].z;
+                                if((dx == 0 && dy == 0 && dz == 0) || x * x + y * y + z * z <= epsilonSquared) {
+                                    pairs[b].push_back(std::make_pair(j, i));
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    // union find, the root of every cluster is its first point
+    roots = std::vector<std::size_t>(points.size());
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        roots[i] = i;
+    }
+    for(const std::vector<std::pair<std::size_t, std::size_t>>& blockPairs : pairs) {
+        for(const std::pair<std::size_t, std::size_t>& pair : blockPairs) {
+            std::size_t a = FindRoot(roots, pair.first);
+            std::size_t b = FindRoot(roots, pair.second);
+            if(a < b) {
+                roots[b] = a;
+            } else if(b < a) {
+                roots[a] = b;
+            }
+        }
+    }
+    for(std::size_t i = 0; i < points.size(); ++i) {
+        roots[i] = roots[roots[i]];
+    }
+}
+
+} // namespace
+
+const ImportStlResult ImportStl(std::string path, Core::Mesh* mesh) {
+    return ImportStl(path, mesh, 0.0f, 0);
+}
+
+const ImportStlResult ImportStl(std::string path, Core::Mesh* mesh, float epsilon, std::size_t threadCount) {
+    std::ifstream inFile(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if(!inFile) {
+        throw std::invalid_argument("Could not open file " + path);
+    }
+    std::vector<char> buffer = std::vector<char>(static_cast<std::size_t>(inFile.tellg()));
+    inFile.seekg(0);
+    if(!inFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+        throw std::invalid_argument("Could not read file " + path);
+    }
+    inFile.close();
+
+    return ImportStl(buffer, mesh, epsilon, threadCount);
+}
+
+const ImportStlResult ImportStl(const std::vector<char>& buffer, Core::Mesh* mesh, float epsilon,
+    std::size_t threadCount) {
+    if(!(epsilon >= 0.0f)) {
+        throw std::invalid_argument("Epsilon must not be negative.");
+    }
+
+    // binary files may also start with "solid", the size of a binary file follows from its triangle count
+    std::vector<Math::Vec3> corners = std::vector<Math::Vec3>();
+    uint32_t triangleCount = 0;
+    if(buffer.size() >= HEADER_SIZE) {
+        std::memcpy(&triangleCount, buffer.data() + 80, sizeof(uint32_t));
+    }
+    if(buffer.size() >= HEADER_SIZE && buffer.size() == HEADER_SIZE + TRIANGLE_SIZE * triangleCount) {
+        ParseBinary(buffer, triangleCount, threadCount, corners);
+    } else {
+        std::size_t start = 0;
+        while(start < buffer.size() && (IsSpace(buffer[start]) || buffer[start] == '\n')) {
+            ++start;
+        }
+        if(buffer.size() - start < 5 || std::memcmp(buffer.data() + start, "solid", 5) != 0) {
+            throw std::invalid_argument("Not a binary or ascii stl file.");
+        }
+        ParseAscii(buffer, threadCount, corners);
+    }
+
+    // weld corners with the same coordinates, then clusters of close points
+    std::vector<std::size_t> first = std::vector<std::size_t>();
+    FindDuplicates(corners, threadCount, first);
+
+    std::vector<std::size_t> pointOf = std::vector<std::size_t>(corners.size());
+    std::vector<Math::Vec3> points = std::vector<Math::Vec3>();
+    for(std::size_t i = 0; i < corners.size(); ++i) {
+        if(first[i] == i) {
+            pointOf[i] = points.size();
+            points.push_back(corners[i]);
+        } else {
+            pointOf[i] = pointOf[first[i]];
+        }
+    }
+
+    std::vector<std::size_t> roots = std::vector<std::size_t>();
+    if(epsilon > 0.0f) {
+        FindClusters(points, epsilon, threadCount, roots);
+    } else {
+        roots = std::vector<std::size_t>(points.size());
+        for(std::size_t i = 0; i < points.size(); ++i) {
+            roots[i] = i;
+        }
+    }
+
+    // drop triangles which collapsed, and triangles which repeat the points of an earlier triangle since they would
+    // be double faces. verts are only created for points used by the remaining triangles
+    const std::size_t NONE = points.size();
+    std::vector<std::size_t> vertOf = std::vector<std::size_t>(points.size(), NONE);
+    std::vector<float> positions = std::vector<float>();
+    std::vector<std::size_t> faceIndices = std::vector<std::size_t>();
+    faceIndices.reserve(corners.size());
+    std::unordered_set<TriangleKey, TriangleKey::Hasher> triangles =
+        std::unordered_set<TriangleKey, TriangleKey::Hasher>();
+    triangles.reserve(corners.size() / 3);
+    std::size_t degenerate = 0;
+    std::size_t duplicate = 0;
+    for(std::size_t t = 0; t < corners.size(); t += 3) {
+        std::size_t a = roots[pointOf[t]];
+        std::size_t b = roots[pointOf[t + 1]];
+        std::size_t c = roots[pointOf[t + 2]];
+        if(a == b || b == c || c == a) {
+            degenerate++;
+            continue;
+        }
+        if(!triangles.insert(TriangleKey(a, b, c)).second) {
+            duplicate++;
+            continue;
+        }
+        for(std::size_t point : {a, b, c}) {
+            if(vertOf[point] == NONE) {
+                vertOf[point] = positions.size() / 3;
+                positions.push_back(points[point].x);
+                positions.push_back(points[point].y);
+                positions.push_back(points[point].z);
+            }
+            faceIndices.push_back(vertOf[point]);
+        }
+    }
+    std::vector<std::size_t> faceOffsets = std::vector<std::size_t>(faceIndices.size() / 3 + 1);
+    for(std::size_t i = 0; i < faceOffsets.size(); ++i) {
+        faceOffsets[i] = 3 * i;
+    }
+
+    mesh->FromIndexed(positions, faceOffsets, faceIndices);
+
+    ImportStlResult result = ImportStlResult();
+    result.triangles = corners.size() / 3;
+    result.degenerate = degenerate;
+    result.duplicate = duplicate;
+    result.verts = positions.size() / 3;
+    return result;
+}
+
+} // namespace IO
+} // namespace Aoba
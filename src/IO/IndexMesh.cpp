@@ -1,9 +1,25 @@
 #include "AobaAPI/IO/IndexMesh.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace Aoba {
 namespace IO {
 
+IndexMesh::IndexMesh() {
+    tracked = nullptr;
+}
+
 void IndexMesh::FromMesh(Core::Mesh* m) {
+    // the arrays no longer follow the slots used by Update
+    tracked = nullptr;
+    vertSlots.clear();
+    freeVertSlots.clear();
+    edgeSlots.clear();
+    edgeOwners.clear();
+    faceTriangles.clear();
+    triangleOwners.clear();
+
     std::vector<Core::Vert*> mVerts = m->Verts();
     std::vector<Core::Edge*> mEdges = m->Edges();
     std::vector<Core::Face*> mFaces = m->Faces();
@@ -17,13 +33,30 @@ void IndexMesh::FromMesh(Core::Mesh* m) {
     triangles.reserve(mFaces.size() * 2); // expecting mostly quads
 
     // populate all vertex coordinates, set vertex index.
-    std::size_t vertIdx = 0;
-    for(Core::Vert* v : mVerts) {
-        vertexCoords.push_back(v->co.x);
-        vertexCoords.push_back(v->co.y);
-        vertexCoords.push_back(v->co.z);
-        v->index = vertIdx;
-        vertIdx++;
+    const Core::CoordArray& coords = m->CoordArrays();
+    if(m->IsCoordArraysEnabled() && coords.Size() == mVerts.size()) {
+        // every slot of the coordinate arrays holds a vert, copy the chunks as they are and use slots as indices
+        for(std::size_t chunk = 0; chunk < coords.ChunkCount(); ++chunk) {
+            const Math::Vec3* co = coords.CoChunk(chunk);
+            std::size_t size = coords.ChunkSize(chunk);
+            for(std::size_t i = 0; i < size; ++i) {
+                vertexCoords.push_back(co[i].x);
+                vertexCoords.push_back(co[i].y);
+                vertexCoords.push_back(co[i].z);
+            }
+        }
+        for(Core::Vert* v : mVerts) {
+            v->index = coords.SlotOf(&v->Co());
+        }
+    } else {
+        std::size_t vertIdx = 0;
+        for(Core::Vert* v : mVerts) {
+            vertexCoords.push_back(v->Co().x);
+            vertexCoords.push_back(v->Co().y);
+            vertexCoords.push_back(v->Co().z);
+            v->index = vertIdx;
+            vertIdx++;
+        }
     }
 
     // populate edges. this will include both wire and non-wire edges together
@@ -35,13 +68,17 @@ void IndexMesh::FromMesh(Core::Mesh* m) {
     // populate faces
     // use simple triangle-fan triangulation for non-triangular faces.
     for(Core::Face* f : mFaces) {
-        std::vector<Core::Loop*> fLoops = f->Loops();
-        std::size_t idx = 1;
-        while(idx + 1 < fLoops.size()) {
-            triangles.push_back(fLoops.at(0)->LoopVert()->index);
-            triangles.push_back(fLoops.at(idx)->LoopVert()->index);
-            triangles.push_back(fLoops.at(idx + 1)->LoopVert()->index);
-            ++idx;
+        Core::FaceVertRange fVerts = f->VertRange();
+        Core::FaceVertIterator it = fVerts.begin();
+        Core::Vert* first = *it;
+        ++it;
+        Core::Vert* prev = *it;
+        ++it;
+        for(; it != fVerts.end(); ++it) {
+            triangles.push_back(first->index);
+            triangles.push_back(prev->index);
+            triangles.push_back((*it)->index);
+            prev = *it;
         }
     }
 
@@ -51,5 +88,195 @@ void IndexMesh::FromMesh(Core::Mesh* m) {
     }
 }
 
+void IndexMesh::Update(Core::Mesh* m) {
+    if(!m->IsChangeTrackingEnabled()) {
+        m->EnableChangeTracking(true);
+        tracked = nullptr;
+    }
+    Core::MeshChanges changes = m->TakeChanges();
+    if(tracked != m || changes.rebuilt) {
+        Rebuild(m);
+        return;
+    }
+
+    // remove killed elements first, so that their slots are reused.
+    // triangles and edges only refer to vert slots, so verts are updated before them
+    for(const Core::Face* f : changes.killedFaces) {
+        RemoveFace(f);
+    }
+    for(const Core::Edge* e : changes.killedEdges) {
+        RemoveEdge(e);
+    }
+    for(const Core::Vert* v : changes.killedVerts) {
+        auto it = vertSlots.find(v);
+        freeVertSlots.push_back(it->second);
+        vertSlots.erase(it);
+    }
+
+    for(Core::Vert* v : changes.createdVerts) {
+        AddVert(v);
+    }
+    for(Core::Vert* v : changes.modifiedVerts) {
+        std::size_t slot = vertSlots.at(v);
+        vertexCoords[slot * 3] = v->Co().x;
+        vertexCoords[slot * 3 + 1] = v->Co().y;
+        vertexCoords[slot * 3 + 2] = v->Co().z;
+    }
+
+    // modified edges may have moved to other verts
+    for(Core::Edge* e : changes.createdEdges) {
+        WriteEdge(e);
+    }
+    for(Core::Edge* e : changes.modifiedEdges) {
+        WriteEdge(e);
+    }
+
+    for(Core::Face* f : changes.createdFaces) {
+        WriteFace(f);
+    }
+    for(Core::Face* f : changes.modifiedFaces) {
+        WriteFace(f);
+    }
+}
+
+void IndexMesh::Rebuild(Core::Mesh* m) {
+    tracked = m;
+    vertexCoords = std::vector<float>();
+    edges = std::vector<std::size_t>();
+    triangles = std::vector<std::size_t>();
+    vertSlots.clear();
+    freeVertSlots.clear();
+    edgeSlots.clear();
+    edgeOwners.clear();
+    faceTriangles.clear();
+    triangleOwners.clear();
+
+    vertexCoords.reserve(m->VertCount() * 3);
+    edges.reserve(m->EdgeCount() * 2);
+    triangles.reserve(m->FaceCount() * 6); // expecting mostly quads
+    vertSlots.reserve(m->VertCount());
+    edgeSlots.reserve(m->EdgeCount());
+    edgeOwners.reserve(m->EdgeCount());
+    faceTriangles.reserve(m->FaceCount());
+    triangleOwners.reserve(m->FaceCount() * 2);
+
+    for(Core::Vert* v : m->VertRange()) {
+        AddVert(v);
+    }
+    for(Core::Edge* e : m->EdgeRange()) {
+        WriteEdge(e);
+    }
+    for(Core::Face* f : m->FaceRange()) {
+        WriteFace(f);
+    }
+}
+
+void IndexMesh::AddVert(const Core::Vert* v) {
+    std::size_t slot = vertexCoords.size() / 3;
+    if(!freeVertSlots.empty()) {
+        slot = freeVertSlots.back();
+        freeVertSlots.pop_back();
+    } else {
+        vertexCoords.resize(vertexCoords.size() + 3);
+    }
+    vertSlots[v] = slot;
+    vertexCoords[slot * 3] = v->Co().x;
+    vertexCoords[slot * 3 + 1] = v->Co().y;
+    vertexCoords[slot * 3 + 2] = v->Co().z;
+}
+
+void IndexMesh::WriteEdge(const Core::Edge* e) {
+    auto inserted = edgeSlots.insert(std::make_pair(e, edgeOwners.size()));
+    std::size_t slot = inserted.first->second;
+    if(inserted.second) {
+        edgeOwners.push_back(e);
+        edges.resize(edges.size() + 2);
+    }
+    edges[slot * 2] = vertSlots.at(e->V1());
+    edges[slot * 2 + 1] = vertSlots.at(e->V2());
+}
+
+void IndexMesh::RemoveEdge(const Core::Edge* e) {
+    auto it = edgeSlots.find(e);
+    std::size_t slot = it->second;
+    edgeSlots.erase(it);
+
+    std::size_t last = edgeOwners.size() - 1;
+    if(slot != last) {
+        edges[slot * 2] = edges[last * 2];
+        edges[slot * 2 + 1] = edges[last * 2 + 1];
+        edgeOwners[slot] = edgeOwners[last];
+        edgeSlots[edgeOwners[slot]] = slot;
+    }
+    edgeOwners.pop_back();
+    edges.resize(last * 2);
+}
+
+void IndexMesh::WriteFace(const Core::Face* f) {
+    std::vector<std::size_t>& slots = faceTriangles[f];
+
+    // use simple triangle-fan triangulation for non-triangular faces.
+    std::size_t count = 0;
+    Core::FaceVertRange fVerts = f->VertRange();
+    Core::FaceVertIterator it = fVerts.begin();
+    std::size_t first = vertSlots.at(*it);
+    ++it;
+    std::size_t prev = vertSlots.at(*it);
+    ++it;
+    for(; it != fVerts.end(); ++it) {
+        std::size_t current = vertSlots.at(*it);
+        if(count == slots.size()) {
+            slots.push_back(triangleOwners.size());
+            triangleOwners.push_back(f);
+            triangles.resize(triangles.size() + 3);
+        }
+        std::size_t slot = slots[count];
+        triangles[slot * 3] = first;
+        triangles[slot * 3 + 1] = prev;
+        triangles[slot * 3 + 2] = current;
+        prev = current;
+        count++;
+    }
+
+    // the face lost verts, drop the triangles it no longer needs
+    while(slots.size() > count) {
+        std::size_t slot = slots.back();
+        slots.pop_back();
+        RemoveTriangle(slot);
+    }
+}
+
+void IndexMesh::RemoveFace(const Core::Face* f) {
+    auto it = faceTriangles.find(f);
+    std::vector<std::size_t> slots = std::move(it->second);
+    faceTriangles.erase(it);
+    for(std::size_t slot : slots) {
+        triangleOwners[slot] = nullptr;
+    }
+
+    // slots of the face may be filled by other triangles of the face being removed, so go from the back
+    std::sort(slots.begin(), slots.end());
+    for(auto slot = slots.rbegin(); slot != slots.rend(); ++slot) {
+        RemoveTriangle(*slot);
+    }
+}
+
+void IndexMesh::RemoveTriangle(std::size_t slot) {
+    std::size_t last = triangleOwners.size() - 1;
+    if(slot != last) {
+        triangles[slot * 3] = triangles[last * 3];
+        triangles[slot * 3 + 1] = triangles[last * 3 + 1];
+        triangles[slot * 3 + 2] = triangles[last * 3 + 2];
+        const Core::Face* owner = triangleOwners[last];
+        triangleOwners[slot] = owner;
+        if(owner != nullptr) {
+            std::vector<std::size_t>& ownerSlots = faceTriangles[owner];
+            *std::find(ownerSlots.begin(), ownerSlots.end(), last) = slot;
+        }
+    }
+    triangleOwners.pop_back();
+    triangles.resize(last * 3);
+}
+
 } // namespace IO
 } // namespace Aoba
\ No newline at end of file
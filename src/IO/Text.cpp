@@ -0,0 +1,298 @@
+#include "AobaAPI/IO/Text.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace Aoba {
+namespace IO {
+
+namespace {
+
+const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+    1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+const uint64_t POW10_INT[] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull};
+
+// value * 10^exponent. powers up to 1e22 are exact in double precision, so most values are scaled by a single
+// correctly rounded operation
+double Scale(double value, int exponent) {
+    while(exponent > 22) {
+        value *= 1e22;
+        exponent -= 22;
+    }
+    while(exponent < -22) {
+        value /= 1e22;
+        exponent += 22;
+    }
+    return exponent >= 0 ? value * POW10[exponent] : value / POW10[-exponent];
+}
+
+// round a positive value to the given number of significant digits, value ~ digits * 10^(exp10 - precision + 1)
+void RoundDigits(double value, int precision, int& exp10, uint64_t& digits) {
+    digits = static_cast<uint64_t>(std::llround(Scale(value, precision - 1 - exp10)));
+    if(digits >= POW10_INT[precision]) {
+        // the exponent was estimated too small, or the value rounded up to the next power of ten
+        exp10++;
+        digits = static_cast<uint64_t>(std::llround(Scale(value, precision - 1 - exp10)));
+    }
+}
+
+// wether digits * 10^(exp10 - precision + 1) reads back as value
+bool RoundTrips(float value, int precision, int exp10, uint64_t digits) {
+    char text[32];
+    std::size_t length = FormatIndex(static_cast<std::size_t>(digits), text);
+    text[length++] = 'e';
+    int exponent = exp10 - precision + 1;
+    if(exponent < 0) {
+        text[length++] = '-';
+        exponent = -exponent;
+    }
+    length += FormatIndex(static_cast<std::size_t>(exponent), text + length);
+    text[length] = '\0';
+    return std::strtof(text, nullptr) == value;
+}
+
+// wether the text starts with the given lowercase word, ignoring case
+bool StartsWithWord(const char* text, std::size_t length, const char* word) {
+    std::size_t wordLength = std::strlen(word);
+    if(length < wordLength) {
+        return false;
+    }
+    for(std::size_t i = 0; i < wordLength; ++i) {
+        char c = text[i] >= 'A' && text[i] <= 'Z' ? static_cast<char>(text[i] - 'A' + 'a') : text[i];
+        if(c != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// convert digits * 10^exponent to the nearest float, if a single correctly rounded double operation gives the same
+// result as rounding the exact value
+bool FastConvert(uint64_t digits, int exponent, float& value) {
+    if(digits > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    double result = Scale(static_cast<double>(digits), exponent);
+    if(result == 0.0) {
+        value = 0.0f;
+        return true;
+    }
+    if(result < std::numeric_limits<float>::min() || result > std::numeric_limits<float>::max()) {
+        return false;
+    }
+
+    // rounding the double to float only differs from rounding the exact value, if the double lies exactly halfway
+    // between two floats. a float keeps the upper 24 of the 53 significant bits
+    uint64_t bits = 0;
+    std::memcpy(&bits, &result, sizeof(double));
+    if((bits & 0x1FFFFFFFull) == 0x10000000ull) {
+        return false;
+    }
+    value = static_cast<float>(result);
+    return true;
+}
+
+} // namespace
+
+std::size_t FormatFloat(float value, char* buffer) {
+    char* out = buffer;
+    if(std::isnan(value)) {
+        std::memcpy(out, "nan", 3);
+        return 3;
+    }
+    if(std::signbit(value)) {
+        *out++ = '-';
+        value = -value;
+    }
+    if(std::isinf(value)) {
+        std::memcpy(out, "inf", 3);
+        return static_cast<std::size_t>(out - buffer) + 3;
+    }
+    if(value == 0.0f) {
+        *out++ = '0';
+        return static_cast<std::size_t>(out - buffer);
+    }
+
+    // 9 significant digits always read back as the same float. the estimate of the exponent may be off by one
+    double v = value;
+    int exp10 = static_cast<int>(std::floor(std::log10(v)));
+    uint64_t digits = 0;
+    RoundDigits(v, 9, exp10, digits);
+    if(digits < POW10_INT[8]) {
+        exp10--;
+        RoundDigits(v, 9, exp10, digits);
+    }
+    int precision = 9;
+
+    // reading back only gets more exact with more digits, so search for the fewest digits which read back
+    int low = 1;
+    int high = 8;
+    while(low <= high) {
+        int mid = (low + high) / 2;
+        int midExp10 = exp10;
+        uint64_t midDigits = 0;
+        RoundDigits(v, mid, midExp10, midDigits);
+        if(RoundTrips(value, mid, midExp10, midDigits)) {
+            precision = mid;
+            digits = midDigits;
+            exp10 = midExp10;
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+    while(precision > 1 && digits % 10 == 0) {
+        digits /= 10;
+        precision--;
+    }
+
+    char text[16];
+    std::size_t length = FormatIndex(static_cast<std::size_t>(digits), text);
+    if(exp10 >= -5 && exp10 < 9) {
+        if(exp10 < 0) {
+            // 0.000ddd
+            *out++ = '0';
+            *out++ = '.';
+            for(int i = -1; i > exp10; --i) {
+                *out++ = '0';
+            }
+            std::memcpy(out, text, length);
+            out += length;
+        } else if(static_cast<std::size_t>(exp10) + 1 >= length) {
+            // ddd000
+            std::memcpy(out, text, length);
+            out += length;
+            for(std::size_t i = length; i < static_cast<std::size_t>(exp10) + 1; ++i) {
+                *out++ = '0';
+            }
+        } else {
+            // dd.ddd
+            std::memcpy(out, text, exp10 + 1);
+            out += exp10 + 1;
+            *out++ = '.';
+            std::memcpy(out, text + exp10 + 1, length - exp10 - 1);
+            out += length - exp10 - 1;
+        }
+        return static_cast<std::size_t>(out - buffer);
+    }
+
+    // d.ddde+XX
+    *out++ = text[0];
+    if(length > 1) {
+        *out++ = '.';
+        std::memcpy(out, text + 1, length - 1);
+        out += length - 1;
+    }
+    *out++ = 'e';
+    *out++ = exp10 < 0 ? '-' : '+';
+    int exponent = exp10 < 0 ? -exp10 : exp10;
+    *out++ = static_cast<char>('0' + exponent / 10);
+    *out++ = static_cast<char>('0' + exponent % 10);
+    return static_cast<std::size_t>(out - buffer);
+}
+
+std::size_t FormatIndex(std::size_t value, char* buffer) {
+    char text[FORMAT_INDEX_MAX];
+    std::size_t length = 0;
+    do {
+        text[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while(value != 0);
+    for(std::size_t i = 0; i < length; ++i) {
+        buffer[i] = text[length - 1 - i];
+    }
+    return length;
+}
+
+std::size_t ParseFloat(const char* text, std::size_t length, float& value) {
+    std::size_t pos = 0;
+    bool negative = false;
+    if(pos < length && (text[pos] == '+' || text[pos] == '-')) {
+        negative = text[pos] == '-';
+        pos++;
+    }
+    if(StartsWithWord(text + pos, length - pos, "inf")) {
+        pos += StartsWithWord(text + pos, length - pos, "infinity") ? 8 : 3;
+        value = negative ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity();
+        return pos;
+    }
+    if(StartsWithWord(text + pos, length - pos, "nan")) {
+        value = negative ? -std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::quiet_NaN();
+        return pos + 3;
+    }
+
+    // up to 19 significant digits fit into 64 bits, the value of the others is only needed by strtof
+    uint64_t digits = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool anyDigits = false;
+    bool point = false;
+    for(; pos < length; ++pos) {
+        char c = text[pos];
+        if(c == '.' && !point) {
+            point = true;
+            continue;
+        }
+        if(c < '0' || c > '9') {
+            break;
+        }
+        anyDigits = true;
+        if(significant < 19) {
+            if(digits != 0 || c != '0') {
+                digits = digits * 10 + static_cast<uint64_t>(c - '0');
+                significant++;
+            }
+            if(point) {
+                exponent--;
+            }
+        } else {
+            truncated = truncated || c != '0';
+            if(!point) {
+                exponent++;
+            }
+        }
+    }
+    if(!anyDigits) {
+        return 0;
+    }
+
+    // the exponent is only part of the number if digits follow
+    if(pos < length && (text[pos] == 'e' || text[pos] == 'E')) {
+        std::size_t expPos = pos + 1;
+        bool expNegative = false;
+        if(expPos < length && (text[expPos] == '+' || text[expPos] == '-')) {
+            expNegative = text[expPos] == '-';
+            expPos++;
+        }
+        if(expPos < length && text[expPos] >= '0' && text[expPos] <= '9') {
+            int expValue = 0;
+            for(; expPos < length && text[expPos] >= '0' && text[expPos] <= '9'; ++expPos) {
+                if(expValue < 100000) {
+                    expValue = expValue * 10 + (text[expPos] - '0');
+                }
+            }
+            exponent += expNegative ? -expValue : expValue;
+            pos = expPos;
+        }
+    }
+
+    if(truncated || !FastConvert(digits, exponent, value)) {
+        std::string number = std::string(text, pos);
+        value = std::strtof(number.c_str(), nullptr);
+        return pos;
+    }
+    if(negative) {
+        value = -value;
+    }
+    return pos;
+}
+
+} // namespace IO
+} // namespace Aoba
@@ -7,6 +7,7 @@ namespace Ops {
 
 const CreateCircleResult CreateCircle(Core::Mesh* m, unsigned vertCount, float radius) {
     CreateCircleResult result = CreateCircleResult();
+    m->Reserve(vertCount, vertCount, 0, 0);
     std::vector<Core::Edge*> edges = std::vector<Core::Edge*>();
     edges.reserve(vertCount);
     std::vector<Core::Vert*> verts = std::vector<Core::Vert*>();
@@ -15,21 +16,21 @@ const CreateCircleResult CreateCircle(Core::Mesh* m, unsigned vertCount, float r
     float angle_step = 2 * PI / vertCount;
 
     for(unsigned i = 0; i < vertCount; ++i) {
-        Core::Vert* newv = new Core::Vert();
-        newv->co.x = sinf(i * angle_step) * radius;
-        newv->co.y = cosf(i * angle_step) * radius;
-        newv->co.z = 0;
+        Core::Vert* newv = m->NewVert();
+        newv->Co().x = sinf(i * angle_step) * radius;
+        newv->Co().y = cosf(i * angle_step) * radius;
+        newv->Co().z = 0;
         Core::MakeVert(m, newv);
         verts.push_back(newv);
     }
 
     for(unsigned i = 1; i < vertCount; ++i) {
-        Core::Edge* newe = new Core::Edge();
+        Core::Edge* newe = m->NewEdge();
         Core::MakeEdge(verts.at(i - 1), verts.at(i), newe);
         edges.push_back(newe);
     }
 
-    Core::Edge* newe = new Core::Edge();
+    Core::Edge* newe = m->NewEdge();
     Core::MakeEdge(verts.back(), verts.at(0), newe);
     edges.push_back(newe);
 
@@ -6,6 +6,10 @@ namespace Ops {
 const CreateGridResult CreateGrid(Core::Mesh* m, int divisionsX, int divisionsY, float sizeX, float sizeY) {
     std::size_t divsX = divisionsX;
     std::size_t divsY = divisionsY;
+    std::size_t faceCount = (divsX + 1) * (divsY + 1);
+    m->Reserve(
+        (2 + divsX) * (2 + divsY), (divsX + 1) * (divsY + 2) + (divsY + 1) * (divsX + 2), faceCount, 4 * faceCount);
+
     // Create verts.
     std::vector<Core::Vert*> verts = std::vector<Core::Vert*>();
     verts.reserve((2 + divsX) * (2 + divsY));
@@ -18,9 +22,9 @@ const CreateGridResult CreateGrid(Core::Mesh* m, int divisionsX, int divisionsY,
     float yStep = sizeY / (divsY + 1);
     for(int x = 0; x <= divsX + 1; ++x) {
         for(int y = 0; y <= divsY + 1; ++y) {
-            Core::Vert* newv = new Core::Vert();
+            Core::Vert* newv = m->NewVert();
             Core::MakeVert(m, newv);
-            newv->co = Math::Vec3(-sizeX / 2 + x * xStep, -sizeY / 2 + y * yStep, 0);
+            newv->Co() = Math::Vec3(-sizeX / 2 + x * xStep, -sizeY / 2 + y * yStep, 0);
             verts.push_back(newv);
 
             // push to inner/boundary vert
@@ -43,7 +47,7 @@ const CreateGridResult CreateGrid(Core::Mesh* m, int divisionsX, int divisionsY,
     for(std::size_t y = 0; y <= divsY + 1; ++y) {
         for(std::size_t x = 0; x <= divsX; ++x) {
             std::size_t idx = y * (2 + divsX) + x;
-            Core::Edge* newe = new Core::Edge();
+            Core::Edge* newe = m->NewEdge();
             Core::MakeEdge(verts.at(idx), verts.at(idx + 1), newe);
             xEdges.push_back(newe);
             if(y == 0 || y == divsY + 1) {
@@ -60,7 +64,7 @@ const CreateGridResult CreateGrid(Core::Mesh* m, int divisionsX, int divisionsY,
     for(std::size_t y = 0; y <= divsY; ++y) {
         for(std::size_t x = 0; x <= divsX + 1; ++x) {
             std::size_t idx = y * (2 + divsX) + x;
-            Core::Edge* newe = new Core::Edge();
+            Core::Edge* newe = m->NewEdge();
             Core::MakeEdge(verts.at(idx), verts.at(idx + 2 + divsX), newe);
             yEdges.push_back(newe);
             if(x == 0 || x == divsX + 1) {
@@ -96,9 +100,9 @@ const CreateGridResult CreateGrid(Core::Mesh* m, int divisionsX, int divisionsY,
             std::vector<Core::Edge*> loopEdges = {e0, e1, e2, e3};
             std::vector<Core::Vert*> loopVerts = {v0, v1, v2, v3};
 
-            Core::Loop* newl = new Core::Loop();
+            Core::Loop* newl = m->NewLoop();
             Core::MakeLoop(loopEdges, loopVerts, newl);
-            Core::Face* newf = new Core::Face();
+            Core::Face* newf = m->NewFace();
             Core::MakeFace(newl, newf);
 
             // TODO: push faces, edges to appropriate vectors...
@@ -9,6 +9,10 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
     // todo: check if radius, number of rings and number of segments are valid values
     // must have at least three segments and at least two rings
 
+    // triangle fans at the caps, quads in between
+    m->Reserve(rings * segments + 2, (2 * rings + 1) * segments, (rings + 1) * segments,
+               6 * segments + 4 * (rings - 1) * segments);
+
     float segmentAngleStep = (2 * PI) / segments;
     float ringAngleStep = PI / (rings + 1);
 
@@ -25,20 +29,20 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
             float x = r * cosf(segmentAngle);
             float y = r * sinf(segmentAngle);
 
-            Core::Vert* newv = new Core::Vert();
+            Core::Vert* newv = m->NewVert();
             Core::MakeVert(m, newv);
-            newv->co = Math::Vec3(x, y, z);
+            newv->Co() = Math::Vec3(x, y, z);
             verts.push_back(newv);
         }
     }
 
     // create cap verts
-    Core::Vert* capBottom = new Core::Vert();
+    Core::Vert* capBottom = m->NewVert();
     Core::MakeVert(m, capBottom);
-    capBottom->co = Math::Vec3(0, 0, -radius);
-    Core::Vert* capTop = new Core::Vert();
+    capBottom->Co() = Math::Vec3(0, 0, -radius);
+    Core::Vert* capTop = m->NewVert();
     Core::MakeVert(m, capTop);
-    capTop->co = Math::Vec3(0, 0, radius);
+    capTop->Co() = Math::Vec3(0, 0, radius);
     verts.push_back(capBottom);
     verts.push_back(capTop);
 
@@ -52,7 +56,7 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
     for(std::size_t ring = 0; ring < rings; ++ring) {
         for(int i = 0; i < segments; ++i) {
             std::size_t idx = ring * segments + i;
-            Core::Edge* newe = new Core::Edge();
+            Core::Edge* newe = m->NewEdge();
             if(i < segments - 1) {
                 Core::MakeEdge(verts.at(idx), verts.at(idx + 1), newe);
 
@@ -70,7 +74,7 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
     for(int ring = 0; ring < rings - 1; ++ring) {
         for(int segment = 0; segment < segments; ++segment) {
             std::size_t idx = ring * segments + segment;
-            Core::Edge* newe = new Core::Edge();
+            Core::Edge* newe = m->NewEdge();
             Core::MakeEdge(verts.at(idx), verts.at(idx + segments), newe);
             sEdges.push_back(newe);
             edges.push_back(newe);
@@ -81,7 +85,7 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
     std::vector<Core::Edge*> bottomEdges = std::vector<Core::Edge*>();
     bottomEdges.reserve(segments);
     for(int i = 0; i < segments; ++i) {
-        Core::Edge* newe = new Core::Edge();
+        Core::Edge* newe = m->NewEdge();
         Core::MakeEdge(capBottom, verts.at(i), newe);
         edges.push_back(newe);
         bottomEdges.push_back(newe);
@@ -90,7 +94,7 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
     std::vector<Core::Edge*> topEdges = std::vector<Core::Edge*>();
     topEdges.reserve(segments);
     for(std::size_t i = (rings - 1) * segments; i < rings * segments; ++i) {
-        Core::Edge* newe = new Core::Edge();
+        Core::Edge* newe = m->NewEdge();
         Core::MakeEdge(verts.at(i), capTop, newe);
         edges.push_back(newe);
         topEdges.push_back(newe);
@@ -110,9 +114,9 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
             loopVerts = {verts.at(i), capBottom, verts.at(0)};
             loopEdges = {bottomEdges.at(i), bottomEdges.at(0), rEdges.at(i)};
         }
-        Core::Loop* newl = new Core::Loop();
+        Core::Loop* newl = m->NewLoop();
         Core::MakeLoop(loopEdges, loopVerts, newl);
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
         Core::MakeFace(newl, newf);
         faces.push_back(newf);
     }
@@ -129,9 +133,9 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
             loopVerts = {capTop, verts.at(idx), verts.at((rings - 1) * segments)};
             loopEdges = {topEdges.at(i), rEdges.at(idx), topEdges.at(0)};
         }
-        Core::Loop* newl = new Core::Loop();
+        Core::Loop* newl = m->NewLoop();
         Core::MakeLoop(loopEdges, loopVerts, newl);
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
         Core::MakeFace(newl, newf);
         faces.push_back(newf);
     }
@@ -163,9 +167,9 @@ const CreateUvSphereResult CreateUVSphere(Core::Mesh* m, float radius, std::size
             std::vector<Core::Edge*> loopEdges = {e0, e1, e2, e3};
             std::vector<Core::Vert*> loopVerts = {v0, v1, v2, v3};
 
-            Core::Loop* newl = new Core::Loop();
+            Core::Loop* newl = m->NewLoop();
             Core::MakeLoop(loopEdges, loopVerts, newl);
-            Core::Face* newf = new Core::Face();
+            Core::Face* newf = m->NewFace();
             Core::MakeFace(newl, newf);
 
             faces.push_back(newf);
@@ -6,10 +6,10 @@ namespace Aoba {
 namespace Ops {
 
 Core::Vert* CreateVert(Core::Mesh* m, const Math::Vec3 co) {
-    Core::Vert* newv = new Core::Vert();
+    Core::Vert* newv = m->NewVert();
 
     Core::MakeVert(m, newv);
-    newv->co = co;
+    newv->Co() = co;
 
     return newv;
 }
@@ -7,8 +7,8 @@ namespace Ops {
 
 void Delete(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const std::vector<Core::Edge*>& edges,
     const std::vector<Core::Face*>& faces, DeleteMode mode) {
-    // delete flag
-    const int32_t DELETE = 1 << 0;
+    // visit marker for elements which are going to be deleted
+    const uint32_t DELETE = m->NewGeneration();
 
     // TODO: some cases which might seem intuitive are not handled somewhat gracefully
     // think about wanting to delete two adjecent faces and the (manifold) edge that they share
@@ -24,9 +24,9 @@ void Delete(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const std::vec
     std::vector<Core::Face*> facesToDelete = std::vector<Core::Face*>();
     facesToDelete.reserve(faces.size());
     for(Core::Face* f : faces) {
-        if(f->flagsIntern != DELETE) {
+        if(!Core::IsMarked(f, DELETE)) {
             facesToDelete.push_back(f);
-            f->flagsIntern = DELETE;
+            Core::Mark(f, DELETE);
         }
     }
 
@@ -44,16 +44,16 @@ void Delete(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const std::vec
     for(Core::Face* f : facesToDelete) {
         // if using DeleteMode other than FaceOnly, mark edges(and verts) of this face for deletion
         if(mode != DeleteMode::FacesOnly) {
-            for(Core::Loop* loop : f->Loops()) {
+            for(Core::Loop* loop : f->LoopRange()) {
                 Core::Edge* edge = loop->LoopEdge();
-                if(edge->flagsIntern != DELETE) {
-                    edge->flagsIntern = DELETE;
+                if(!Core::IsMarked(edge, DELETE)) {
+                    Core::Mark(edge, DELETE);
                     edgesToDelete.push_back(edge);
                 }
                 if(mode == DeleteMode::All) {
                     Core::Vert* vert = loop->LoopVert();
-                    if(vert->flagsIntern != DELETE) {
-                        vert->flagsIntern = DELETE;
+                    if(!Core::IsMarked(vert, DELETE)) {
+                        Core::Mark(vert, DELETE);
                         vertsToDelete.push_back(vert);
                     }
                 }
@@ -68,9 +68,9 @@ void Delete(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const std::vec
     }
 
     for(Core::Edge* e : edges) {
-        if(e->flagsIntern != DELETE) {
+        if(!Core::IsMarked(e, DELETE)) {
             edgesToDelete.push_back(e);
-            e->flagsIntern = DELETE;
+            Core::Mark(e, DELETE);
         }
     }
 
@@ -79,9 +79,9 @@ void Delete(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const std::vec
     for(Core::Edge* e : edgesToDelete) {
         // if using DeleteMode All, mark verts of this edge for deletion
         if(mode == DeleteMode::All) {
-            for(Core::Vert* v : e->Verts()) {
-                if(v->flagsIntern != DELETE) {
-                    v->flagsIntern = DELETE;
+            for(Core::Vert* v : {e->V1(), e->V2()}) {
+                if(!Core::IsMarked(v, DELETE)) {
+                    Core::Mark(v, DELETE);
                     vertsToDelete.push_back(v);
                 }
             }
@@ -96,9 +96,9 @@ void Delete(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const std::vec
     }
 
     for(Core::Vert* v : verts) {
-        if(v->flagsIntern != DELETE) {
+        if(!Core::IsMarked(v, DELETE)) {
             vertsToDelete.push_back(v);
-            v->flagsIntern = DELETE;
+            Core::Mark(v, DELETE);
         }
     }
 
@@ -5,7 +5,9 @@ namespace Ops {
 
 const DuplicateResult Duplicate(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     const std::vector<Core::Edge*>& edges, const std::vector<Core::Face*>& faces) {
-    const int32_t COPIED = 1 << 0;
+    const uint32_t COPIED = m->NewGeneration();
+    // at least this many elements are created, verts and edges of the listed faces may add more
+    m->Reserve(verts.size(), edges.size(), faces.size(), 0);
 
     // duplicate verts from the list
     std::vector<Core::Vert*> newVerts = std::vector<Core::Vert*>();
@@ -13,11 +15,11 @@ const DuplicateResult Duplicate(Core::Mesh* m, const std::vector<Core::Vert*>& v
     int vertIdx = 0;
 
     for(int i = 0; i < verts.size(); ++i) {
-        Core::Vert* newv = new Core::Vert();
+        Core::Vert* newv = m->NewVert();
         Core::MakeVert(m, newv);
 
-        newv->co = verts.at(i)->co;
-        verts.at(i)->flagsIntern = COPIED;
+        newv->Co() = verts.at(i)->Co();
+        Core::Mark(verts.at(i), COPIED);
 
         verts.at(i)->index = vertIdx;
         vertIdx++;
@@ -31,39 +33,39 @@ const DuplicateResult Duplicate(Core::Mesh* m, const std::vector<Core::Vert*>& v
     int edgeIdx = 0;
 
     for(int i = 0; i < edges.size(); ++i) {
-        Core::Edge* newe = new Core::Edge();
+        Core::Edge* newe = m->NewEdge();
         Core::Edge* current = edges.at(i);
         current->index = edgeIdx;
-        current->flagsIntern = COPIED;
+        Core::Mark(current, COPIED);
         edgeIdx++;
 
         Core::Vert* v1;
         Core::Vert* v2;
 
-        if(current->Verts().at(0)->flagsIntern & COPIED) {
-            v1 = newVerts.at(current->Verts().at(0)->index);
+        if(Core::IsMarked(current->V1(), COPIED)) {
+            v1 = newVerts.at(current->V1()->index);
         } else {
-            v1 = new Core::Vert();
+            v1 = m->NewVert();
             Core::MakeVert(m, v1);
 
-            v1->co = current->Verts().at(0)->co;
-            current->Verts().at(0)->flagsIntern = COPIED;
+            v1->Co() = current->V1()->Co();
+            Core::Mark(current->V1(), COPIED);
 
-            current->Verts().at(0)->index = vertIdx;
+            current->V1()->index = vertIdx;
             vertIdx++;
             newVerts.push_back(v1);
         }
 
-        if(current->Verts().at(1)->flagsIntern & COPIED) {
-            v2 = newVerts.at(current->Verts().at(1)->index);
+        if(Core::IsMarked(current->V2(), COPIED)) {
+            v2 = newVerts.at(current->V2()->index);
         } else {
-            v2 = new Core::Vert();
+            v2 = m->NewVert();
             Core::MakeVert(m, v2);
 
-            v2->co = current->Verts().at(1)->co;
-            current->Verts().at(1)->flagsIntern = COPIED;
+            v2->Co() = current->V2()->Co();
+            Core::Mark(current->V2(), COPIED);
 
-            current->Verts().at(1)->index = vertIdx;
+            current->V2()->index = vertIdx;
             vertIdx++;
             newVerts.push_back(v2);
         }
@@ -77,67 +79,66 @@ const DuplicateResult Duplicate(Core::Mesh* m, const std::vector<Core::Vert*>& v
     newFaces.reserve(edges.size());
 
     for(int i = 0; i < faces.size(); ++i) {
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
 
         std::vector<Core::Loop*> newFaceLoops = std::vector<Core::Loop*>();
 
-        std::vector<Core::Loop*> loops = faces.at(i)->Loops();
         std::vector<Core::Vert*> loopVerts = std::vector<Core::Vert*>();
         std::vector<Core::Edge*> loopEdges = std::vector<Core::Edge*>();
 
-        for(int k = 0; k < loops.size(); ++k) {
+        for(Core::Loop* loop : faces.at(i)->LoopRange()) {
             // check if loop vert is copied, push to loopverts
-            if(loops.at(k)->LoopVert()->flagsIntern & COPIED) {
-                loopVerts.push_back(newVerts.at(loops.at(k)->LoopVert()->index));
+            if(Core::IsMarked(loop->LoopVert(), COPIED)) {
+                loopVerts.push_back(newVerts.at(loop->LoopVert()->index));
             } else {
-                Core::Vert* newv = new Core::Vert();
+                Core::Vert* newv = m->NewVert();
                 Core::MakeVert(m, newv);
 
-                newv->co = loops.at(k)->LoopVert()->co;
-                loops.at(k)->LoopVert()->flagsIntern = COPIED;
-                loops.at(k)->LoopVert()->index = vertIdx;
+                newv->Co() = loop->LoopVert()->Co();
+                Core::Mark(loop->LoopVert(), COPIED);
+                loop->LoopVert()->index = vertIdx;
                 vertIdx++;
                 newVerts.push_back(newv);
                 loopVerts.push_back(newv);
             }
 
             // check if loop edge is copied, push to loopedges
-            if(loops.at(k)->LoopEdge()->flagsIntern & COPIED) {
-                loopEdges.push_back(newEdges.at(loops.at(k)->LoopEdge()->index));
+            if(Core::IsMarked(loop->LoopEdge(), COPIED)) {
+                loopEdges.push_back(newEdges.at(loop->LoopEdge()->index));
             } else {
-                Core::Edge* newe = new Core::Edge();
-                Core::Edge* current = loops.at(k)->LoopEdge();
+                Core::Edge* newe = m->NewEdge();
+                Core::Edge* current = loop->LoopEdge();
                 current->index = edgeIdx;
-                current->flagsIntern = COPIED;
+                Core::Mark(current, COPIED);
                 edgeIdx++;
 
                 Core::Vert* v1;
                 Core::Vert* v2;
 
-                if(current->Verts().at(0)->flagsIntern & COPIED) {
-                    v1 = newVerts.at(current->Verts().at(0)->index);
+                if(Core::IsMarked(current->V1(), COPIED)) {
+                    v1 = newVerts.at(current->V1()->index);
                 } else {
-                    v1 = new Core::Vert();
+                    v1 = m->NewVert();
                     Core::MakeVert(m, v1);
 
-                    v1->co = current->Verts().at(0)->co;
-                    current->Verts().at(0)->flagsIntern = COPIED;
+                    v1->Co() = current->V1()->Co();
+                    Core::Mark(current->V1(), COPIED);
 
-                    current->Verts().at(0)->index = vertIdx;
+                    current->V1()->index = vertIdx;
                     vertIdx++;
                     newVerts.push_back(v1);
                 }
 
-                if(current->Verts().at(1)->flagsIntern & COPIED) {
-                    v2 = newVerts.at(current->Verts().at(1)->index);
+                if(Core::IsMarked(current->V2(), COPIED)) {
+                    v2 = newVerts.at(current->V2()->index);
                 } else {
-                    v2 = new Core::Vert();
+                    v2 = m->NewVert();
                     Core::MakeVert(m, v2);
 
-                    v2->co = current->Verts().at(1)->co;
-                    current->Verts().at(1)->flagsIntern = COPIED;
+                    v2->Co() = current->V2()->Co();
+                    Core::Mark(current->V2(), COPIED);
 
-                    current->Verts().at(1)->index = vertIdx;
+                    current->V2()->index = vertIdx;
                     vertIdx++;
                     newVerts.push_back(v2);
                 }
@@ -148,7 +149,7 @@ const DuplicateResult Duplicate(Core::Mesh* m, const std::vector<Core::Vert*>& v
             }
         }
 
-        Core::Loop* newl = new Core::Loop();
+        Core::Loop* newl = m->NewLoop();
         Core::MakeLoop(loopEdges, loopVerts, newl);
 
         Core::MakeFace(newl, newf);
@@ -160,43 +161,6 @@ const DuplicateResult Duplicate(Core::Mesh* m, const std::vector<Core::Vert*>& v
     result.faces = newFaces;
     result.edges = newEdges;
 
-    // TODO: perhaps this could be done faster
-    // clear all flags and indexes
-    for(int i = 0; i < verts.size(); ++i) {
-        verts.at(i)->flagsIntern = 0;
-        verts.at(i)->index = 0;
-        vertIdx++;
-    }
-
-    for(int i = 0; i < edges.size(); ++i) {
-        edges.at(i)->flagsIntern = 0;
-        edges.at(i)->index = 0;
-
-        edges.at(i)->Verts().at(0)->index = 0;
-        edges.at(i)->Verts().at(0)->flagsIntern = 0;
-        edges.at(i)->Verts().at(1)->index = 0;
-        edges.at(i)->Verts().at(1)->flagsIntern = 0;
-    }
-
-    for(int i = 0; i < faces.size(); ++i) {
-        std::vector<Core::Loop*> loops = faces.at(i)->Loops();
-
-        for(int k = 0; k < loops.size(); ++k) {
-            loops.at(k)->LoopVert()->flagsIntern = 0;
-            loops.at(k)->LoopVert()->index = 0;
-
-            if(loops.at(k)->LoopEdge()->flagsIntern) {
-                loops.at(k)->LoopEdge()->Verts().at(0)->index = 0;
-                loops.at(k)->LoopEdge()->Verts().at(0)->flagsIntern = 0;
-                loops.at(k)->LoopEdge()->Verts().at(1)->index = 0;
-                loops.at(k)->LoopEdge()->Verts().at(1)->flagsIntern = 0;
-            }
-
-            loops.at(k)->LoopEdge()->flagsIntern = 0;
-            loops.at(k)->LoopEdge()->index = 0;
-        }
-    }
-
     return result;
 }
 
@@ -17,23 +17,23 @@ const ExtrudeEdgesResult ExtrudeEdges(Core::Mesh* m, const std::vector<Core::Edg
     std::vector<Core::Face*> faces = std::vector<Core::Face*>();
     faces.reserve(edges.size());
 
-    const int32_t EXTRUDED_VERT = 1 << 0;
+    const uint32_t EXTRUDED_VERT = m->NewGeneration();
 
     int vertIdx = 0;
     for(int i = 0; i < edges.size(); ++i) {
-        std::vector<Core::Vert*> currentVerts = edges.at(i)->Verts();
+        Core::Vert* currentVerts[2] = {edges.at(i)->V1(), edges.at(i)->V2()};
         // extrude all individual verts into vertical edges ig not already extruded
         for(int j = 0; j < 2; ++j) {
-            if(!(currentVerts.at(j)->flagsIntern & EXTRUDED_VERT)) {
-                Core::Vert* newv = new Core::Vert();
-                Core::Edge* newe = new Core::Edge();
+            if(!Core::IsMarked(currentVerts[j], EXTRUDED_VERT)) {
+                Core::Vert* newv = m->NewVert();
+                Core::Edge* newe = m->NewEdge();
 
-                Core::MakeEdgeVert(currentVerts.at(j), newe, newv);
-                newv->co = currentVerts.at(j)->co;
+                Core::MakeEdgeVert(currentVerts[j], newe, newv);
+                newv->Co() = currentVerts[j]->Co();
 
-                // set flags and index on the vert.
-                currentVerts.at(j)->flagsIntern = EXTRUDED_VERT;
-                currentVerts.at(j)->index = vertIdx;
+                // mark the vert and set its index.
+                Core::Mark(currentVerts[j], EXTRUDED_VERT);
+                currentVerts[j]->index = vertIdx;
                 vertIdx++;
 
                 // push new edge, vert
@@ -43,8 +43,8 @@ const ExtrudeEdgesResult ExtrudeEdges(Core::Mesh* m, const std::vector<Core::Edg
         }
 
         // create the horizontal edge, accessing the new verts by index stored on existing verts of the current edge.
-        Core::Edge* newe = new Core::Edge();
-        Core::MakeEdge(verts.at(currentVerts.at(0)->index), verts.at(currentVerts.at(1)->index), newe);
+        Core::Edge* newe = m->NewEdge();
+        Core::MakeEdge(verts.at(currentVerts[0]->index), verts.at(currentVerts[1]->index), newe);
         horizontalEdges.push_back(newe);
 
         // find edges and verts which form the face boundary, keeping in mind existing loops
@@ -52,9 +52,9 @@ const ExtrudeEdgesResult ExtrudeEdges(Core::Mesh* m, const std::vector<Core::Edg
         std::vector<Core::Edge*> faceEdges = std::vector<Core::Edge*>();
         faceEdges.reserve(4);
         faceEdges.push_back(edges.at(i));
-        Core::Vert* loopVert = currentVerts.at(0);
+        Core::Vert* loopVert = currentVerts[0];
         if(edges.at(i)->IsBoundary()) {
-            loopVert = edges.at(i)->Loops().at(0)->LoopVert();
+            loopVert = (*edges.at(i)->LoopRange().begin())->LoopVert();
         }
         Core::Vert* first = edges.at(i)->Other(loopVert);
         faceEdges.push_back(verticalEdges.at(loopVert->index));
@@ -63,22 +63,13 @@ const ExtrudeEdgesResult ExtrudeEdges(Core::Mesh* m, const std::vector<Core::Edg
         std::vector<Core::Vert*> faceVerts = {first, loopVert, verts.at(loopVert->index), verts.at(first->index)};
         
         // create the new face
-        Core::Face* newf = new Core::Face();
-        Core::Loop* newl = new Core::Loop();
+        Core::Face* newf = m->NewFace();
+        Core::Loop* newl = m->NewLoop();
         Core::MakeLoop(faceEdges, faceVerts, newl);
         Core::MakeFace(newl, newf);
         faces.push_back(newf);
     }
 
-    // clear flags and index from verts
-    for(int i = 0; i < edges.size(); ++i) {
-        std::vector<Core::Vert*> currentVerts = edges.at(i)->Verts();
-        for(int j = 0; j < 2; ++j) {
-            currentVerts.at(j)->index = 0;
-            currentVerts.at(j)->flagsIntern = 0;
-        }
-    }
-
     result.faces = faces;
     result.horizontalEdges = horizontalEdges;
     result.verticalEdges = verticalEdges;
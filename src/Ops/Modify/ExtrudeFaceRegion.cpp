@@ -4,7 +4,8 @@ namespace Aoba {
 namespace Ops {
 
 const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector<Core::Face*>& faces, bool keepOrig) {
-    // flags
+    // flags, valid for the current generation only
+    const uint32_t gen = m->NewGeneration();
     const int32_t DUPLICATED_EDGE = 1 << 0;
     const int32_t INSIDE_EDGE = 1 << 1;
     const int32_t DUPLICATED_VERT = 1 << 0;
@@ -26,15 +27,13 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
         std::vector<Core::Vert*> loopVerts = std::vector<Core::Vert*>();
 
         // iterate over all loops inside this face
-        for(Core::Loop* loop : face->Loops()) {
+        for(Core::Loop* loop : face->LoopRange()) {
             Core::Edge* loopEdge = loop->LoopEdge();
 
             // check if edge had already been duplicated
-            if(loopEdge->flagsIntern & DUPLICATED_EDGE) {
+            if(Core::HasMark(loopEdge, gen, DUPLICATED_EDGE)) {
                 // multiple faces use this edge, therefore it is inside, not on the boundary
-                if(!(loopEdge->flagsIntern & INSIDE_EDGE)) {
-                    loopEdge->flagsIntern += INSIDE_EDGE;
-                }
+                Core::SetMark(loopEdge, gen, INSIDE_EDGE);
                 // use the stored index to add the edge, vertex to loop
                 loopEdges.push_back(horizontalEdges.at(loopEdge->index));
                 loopVerts.push_back(newVerts.at(loop->LoopVert()->index));
@@ -44,33 +43,33 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
                 // edge was not duplicated, but some verts might have been.
                 Core::Vert* v1;
                 Core::Vert* v2;
-                Core::Edge* newe = new Core::Edge();
+                Core::Edge* newe = m->NewEdge();
 
-                if(loopEdge->V1()->flagsIntern & DUPLICATED_VERT) {
+                if(Core::HasMark(loopEdge->V1(), gen, DUPLICATED_VERT)) {
                     // v1 was duplicated
                     v1 = newVerts.at(loopEdge->V1()->index);
                 } else {
                     // v1 was not duplicated, do it now
-                    v1 = new Core::Vert();
+                    v1 = m->NewVert();
                     loopEdge->V1()->index = vertIdx;
-                    loopEdge->V1()->flagsIntern = DUPLICATED_VERT;
+                    Core::SetMark(loopEdge->V1(), gen, DUPLICATED_VERT);
                     ++vertIdx;
-                    v1->co = loopEdge->V1()->co;
+                    v1->Co() = loopEdge->V1()->Co();
                     Core::MakeVert(m, v1);
                     newVerts.push_back(v1);
                     originalVerts.push_back(loopEdge->V1());
                 }
 
-                if(loopEdge->V2()->flagsIntern & DUPLICATED_VERT) {
+                if(Core::HasMark(loopEdge->V2(), gen, DUPLICATED_VERT)) {
                     // v1 was duplicated
                     v2 = newVerts.at(loopEdge->V2()->index);
                 } else {
                     // v1 was not duplicated, do it now
-                    v2 = new Core::Vert();
+                    v2 = m->NewVert();
                     loopEdge->V2()->index = vertIdx;
-                    loopEdge->V2()->flagsIntern = DUPLICATED_VERT;
+                    Core::SetMark(loopEdge->V2(), gen, DUPLICATED_VERT);
                     ++vertIdx;
-                    v2->co = loopEdge->V2()->co;
+                    v2->Co() = loopEdge->V2()->Co();
                     Core::MakeVert(m, v2);
                     newVerts.push_back(v2);
                     originalVerts.push_back(loopEdge->V2());
@@ -79,7 +78,7 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
                 Core::MakeEdge(v1, v2, newe);
                 horizontalEdges.push_back(newe);
                 loopEdge->index = edgeIdx;
-                loopEdge->flagsIntern += DUPLICATED_EDGE;
+                Core::SetMark(loopEdge, gen, DUPLICATED_EDGE);
                 ++edgeIdx;
                 // push edge, vert to loop
                 loopEdges.push_back(newe);
@@ -92,11 +91,11 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
         }
 
         // create a new loop with MakeLoop using the loopverts and loopeedges to create the top face
-        Core::Loop* faceLoop = new Core::Loop();
+        Core::Loop* faceLoop = m->NewLoop();
         Core::MakeLoop(loopEdges, loopVerts, faceLoop);
 
         // create the face using the new loop
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
         Core::MakeFace(faceLoop, newf);
         horizontalFaces.push_back(newf);
     }
@@ -109,7 +108,7 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
     std::vector<Core::Face*> verticalFaces = std::vector<Core::Face*>();
 
     for(Core::Edge* edge : originalEdges) {
-        if(!(edge->flagsIntern & INSIDE_EDGE)) {
+        if(!Core::HasMark(edge, gen, INSIDE_EDGE)) {
             Core::Vert* v0 = edge->V1();
             Core::Vert* v1 = edge->V2();
             Core::Vert* v2 = newVerts.at(v1->index);
@@ -119,25 +118,25 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
             Core::Edge* e3;
             Core::Edge* topEdge = horizontalEdges.at(edge->index);
 
-            if(v0->flagsIntern & EXTRUDED_VERT) {
+            if(Core::HasMark(v0, gen, EXTRUDED_VERT)) {
                 e3 = verticalEdges.at(v0->index);
                 v3 = e3->Other(v0);
             } else {
-                e3 = new Core::Edge();
+                e3 = m->NewEdge();
                 Core::MakeEdge(v0, v3, e3);
                 verticalEdges.push_back(e3);
-                v0->flagsIntern = EXTRUDED_VERT;
+                Core::SetMark(v0, gen, EXTRUDED_VERT);
                 v0->index = verticalEdgeIndex;
                 ++verticalEdgeIndex;
             }
-            if(v1->flagsIntern & EXTRUDED_VERT) {
+            if(Core::HasMark(v1, gen, EXTRUDED_VERT)) {
                 e1 = verticalEdges.at(v1->index);
                 v2 = e1->Other(v1);
             } else {
-                e1 = new Core::Edge();
+                e1 = m->NewEdge();
                 Core::MakeEdge(v1, v2, e1);
                 verticalEdges.push_back(e1);
-                v1->flagsIntern = EXTRUDED_VERT;
+                Core::SetMark(v1, gen, EXTRUDED_VERT);
                 v1->index = verticalEdgeIndex;
                 ++verticalEdgeIndex;
             }
@@ -145,8 +144,7 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
             // determine the orientation by the loop of the top edge (which will only have one loop)
             std::vector<Core::Vert*> loopVerts;
             std::vector<Core::Edge*> loopEdges;
-            std::vector<Core::Loop*> topLoops = topEdge->Loops();
-            Core::Loop* topLoop = topLoops.at(0);
+            Core::Loop* topLoop = *topEdge->LoopRange().begin();
             if(topLoop->LoopVert() == v3) {
                 loopVerts = {v2, v3, v0, v1};
                 loopEdges = {topEdge, e3, edge, e1};
@@ -156,43 +154,34 @@ const ExtrudeFaceRegionResult ExtrudeFaceRegion(Core::Mesh* m, const std::vector
             }
 
             // make loop. face
-            Core::Loop* newl = new Core::Loop();
-            Core::Face* newf = new Core::Face();
+            Core::Loop* newl = m->NewLoop();
+            Core::Face* newf = m->NewFace();
             Core::MakeLoop(loopEdges, loopVerts, newl);
             Core::MakeFace(newl, newf);
             verticalFaces.push_back(newf);
         }
     }
 
-    // delete or clear flags for original faces;
+    // delete original faces
     if(!keepOrig) {
         for(Core::Face* face : faces) {
             Core::KillFace(face);
         }
     }
 
-    // delete or clear flags for original edges
-    for(Core::Edge* edge : originalEdges) {
-        if(keepOrig) {
-            edge->index = 0;
-            edge->flagsIntern = 0;
-        } else {
+    // delete original edges which are no longer used by any face
+    if(!keepOrig) {
+        for(Core::Edge* edge : originalEdges) {
             if(edge->IsWire()) {
                 Core::KillEdge(edge);
-            } else {
-                edge->index = 0;
-                edge->flagsIntern = 0;
             }
         }
     }
 
-    // delete or clear flags from original verts
+    // delete original verts which are no longer used by any edge
     for(Core::Vert* vert : originalVerts) {
-        if(vert->Edges().size() == 0) {
+        if(vert->EdgeRange().Empty()) {
             Core::KillVert(vert);
-        } else {
-            vert->index = 0;
-            vert->flagsIntern = 0;
         }
     }
 
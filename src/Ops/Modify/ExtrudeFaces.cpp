@@ -4,8 +4,8 @@ namespace Aoba {
 namespace Ops {
 
 const ExtrudeFacesResult ExtrudeFaces(Core::Mesh* m, const std::vector<Core::Face*>& faces, bool keepOrig) {
-    // flags
-    const int32_t EXTRUDED = 1 << 0;
+    // visit marker
+    const uint32_t EXTRUDED = m->NewGeneration();
 
     // verts and edges
     std::vector<Core::Vert*> newVerts = std::vector<Core::Vert*>();
@@ -23,7 +23,7 @@ const ExtrudeFacesResult ExtrudeFaces(Core::Mesh* m, const std::vector<Core::Fac
         std::vector<Core::Vert*> loopVerts = std::vector<Core::Vert*>();
 
         // iterate over all loops inside this face
-        for(Core::Loop* loop : face->Loops()) {
+        for(Core::Loop* loop : face->LoopRange()) {
             Core::Edge* topEdge;
             Core::Vert* v2;
             Core::Vert* v3;
@@ -32,7 +32,7 @@ const ExtrudeFacesResult ExtrudeFaces(Core::Mesh* m, const std::vector<Core::Fac
             Core::Vert* v0 = loop->LoopVert();
             Core::Vert* v1 = loopEdge->Other(v0);
             // check if the edge of current loop was already extruded
-            if(loopEdge->flagsIntern & EXTRUDED) {
+            if(Core::IsMarked(loopEdge, EXTRUDED)) {
                 // get verts, edges using indices
                 v2 = newVerts.at(v1->index);
                 v3 = newVerts.at(v0->index);
@@ -41,48 +41,48 @@ const ExtrudeFacesResult ExtrudeFaces(Core::Mesh* m, const std::vector<Core::Fac
                 Core::Edge* leftEdge;
                 Core::Edge* rightEdge;
                 // extrude each vertex of the edge which was not extruded
-                if(v0->flagsIntern & EXTRUDED) {
+                if(Core::IsMarked(v0, EXTRUDED)) {
                     leftEdge = newVerticalEdges.at(v0->index);
                     v3 = newVerts.at(v0->index);
                 } else {
-                    leftEdge = new Core::Edge();
-                    v3 = new Core::Vert();
-                    v3->co = v0->co;
+                    leftEdge = m->NewEdge();
+                    v3 = m->NewVert();
+                    v3->Co() = v0->Co();
                     Core::MakeEdgeVert(v0, leftEdge, v3);
                     v0->index = newVertIdx;
-                    v0->flagsIntern = EXTRUDED;
+                    Core::Mark(v0, EXTRUDED);
                     newVerts.push_back(v3);
                     newVerticalEdges.push_back(leftEdge);
                     newVertIdx++;
                 }
-                if(v1->flagsIntern & EXTRUDED) {
+                if(Core::IsMarked(v1, EXTRUDED)) {
                     rightEdge = newVerticalEdges.at(v1->index);
                     v2 = newVerts.at(v1->index);
                 } else {
-                    rightEdge = new Core::Edge();
-                    v2 = new Core::Vert();
-                    v2->co = v1->co;
+                    rightEdge = m->NewEdge();
+                    v2 = m->NewVert();
+                    v2->Co() = v1->Co();
                     Core::MakeEdgeVert(v1, rightEdge, v2);
                     v1->index = newVertIdx;
-                    v1->flagsIntern = EXTRUDED;
+                    Core::Mark(v1, EXTRUDED);
                     newVerts.push_back(v2);
                     newVerticalEdges.push_back(rightEdge);
                     newVertIdx++;
                 }
                 // make an edge at the top using the new vertices of the extruded edges
-                topEdge = new Core::Edge();
+                topEdge = m->NewEdge();
                 Core::MakeEdge(v3, v2, topEdge);
                 newHorizontalEdges.push_back(topEdge);
                 loopEdge->index = newEdgeIdx;
-                loopEdge->flagsIntern = EXTRUDED;
+                Core::Mark(loopEdge, EXTRUDED);
                 newEdgeIdx++;
 
                 // make the extruded face
                 std::vector<Core::Edge*> loopEdges = {loopEdge, rightEdge, topEdge, leftEdge};
                 std::vector<Core::Vert*> loopVerts = {v0, v1, v2, v3};
 
-                Core::Loop* newl = new Core::Loop();
-                Core::Face* newf = new Core::Face();
+                Core::Loop* newl = m->NewLoop();
+                Core::Face* newf = m->NewFace();
                 Core::MakeLoop(loopEdges, loopVerts, newl);
                 Core::MakeFace(newl, newf);
                 newVerticalFaces.push_back(newf);
@@ -94,32 +94,20 @@ const ExtrudeFacesResult ExtrudeFaces(Core::Mesh* m, const std::vector<Core::Fac
         }
 
         // create a new loop with MakeLoop using the loopverts and loopeedges to create the top face
-        Core::Loop* faceLoop = new Core::Loop();
+        Core::Loop* faceLoop = m->NewLoop();
         Core::MakeLoop(loopEdges, loopVerts, faceLoop);
         // push the new loop to the list of new loops
         faceLoops.push_back(faceLoop);
 
         // create the face using the list of new loops
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
         Core::MakeFace(faceLoop, newf);
         newHorizontalFaces.push_back(newf);
     }
 
-    // loop over all faces again, clear indices and flags
-    for(Core::Face* face : faces) {
-        // iterate over all loops inside this face
-        for(Core::Loop* loop : face->Loops()) {
-            Core::Edge* edge = loop->LoopEdge();
-            edge->flagsIntern = 0;
-            edge->index = 0;
-            edge->V1()->index = 0;
-            edge->V1()->flagsIntern = 0;
-            edge->V2()->index = 0;
-            edge->V2()->flagsIntern = 0;
-        }
-
-        // if specified, kill original face
-        if(!keepOrig) {
+    // if specified, kill original faces
+    if(!keepOrig) {
+        for(Core::Face* face : faces) {
             Core::KillFace(face);
         }
     }
@@ -16,9 +16,9 @@ const ExtrudeVertsResult ExtrudeVerts(Core::Mesh* m, const std::vector<Core::Ver
     newEdges.reserve(verts.size());
 
     for(Core::Vert* v : verts) {
-        Core::Vert* newv = new Core::Vert();
-        newv->co = v->co;
-        Core::Edge* newe = new Core::Edge();
+        Core::Vert* newv = m->NewVert();
+        newv->Co() = v->Co();
+        Core::Edge* newe = m->NewEdge();
         Core::MakeEdgeVert(v, newe, newv);
         newVerts.push_back(newv);
         newEdges.push_back(newe);
@@ -3,13 +3,14 @@
 #include <algorithm>
 
 #include <cmath>
+#include <iterator>
 
 namespace Aoba {
 namespace Ops {
 
 Math::Vec3 CalcEdgeNo(Math::Vec3 faceNo, Core::Loop* loop) {
-    Math::Vec3 coStart = loop->LoopVert()->co;
-    Math::Vec3 coEnd = loop->LoopEdge()->Other(loop->LoopVert())->co;
+    Math::Vec3 coStart = loop->LoopVert()->Co();
+    Math::Vec3 coEnd = loop->LoopEdge()->Other(loop->LoopVert())->Co();
 
     return faceNo.Cross((coEnd - coStart).Normalized());
 }
@@ -39,9 +40,13 @@ const InsetFacesResult InsetFaces(Core::Mesh* m, const std::vector<Core::Face*>&
     std::vector<Core::Face*> centerFaces = std::vector<Core::Face*>();
     std::vector<Core::Face*> boundaryFaces = std::vector<Core::Face*>();
 
+    // original face loops are accessed by index, the buffer is reused for all faces
+    std::vector<Core::Loop*> faceLoops = std::vector<Core::Loop*>();
+
     for(Core::Face* face : faces) {
-        face->NormalUpdate();
-        std::vector<Core::Loop*> faceLoops = face->Loops();
+        m->NormalUpdate(face);
+        faceLoops.clear();
+        face->LoopRange().CopyTo(std::back_inserter(faceLoops));
 
         // vectors for edges and faces, in the same order as original face loops
         std::vector<Core::Vert*> newVerts = std::vector<Core::Vert*>();
@@ -54,11 +59,11 @@ const InsetFacesResult InsetFaces(Core::Mesh* m, const std::vector<Core::Face*>&
         // create inner verts and edges spanning to outer verts
         for(Core::Loop* loop : faceLoops) {
             edgeNoCurrent = CalcEdgeNo(face->no, loop);
-            Core::Vert* newv = new Core::Vert();
-            Core::Edge* newe = new Core::Edge();
+            Core::Vert* newv = m->NewVert();
+            Core::Edge* newe = m->NewEdge();
             Core::MakeEdgeVert(loop->LoopVert(), newe, newv);
 
-            newv->co = loop->LoopVert()->co + CalcVertOffset(edgeNoPrev, edgeNoCurrent) * distance;
+            newv->Co() = loop->LoopVert()->Co() + CalcVertOffset(edgeNoPrev, edgeNoCurrent) * distance;
 
             newVerts.push_back(newv);
             newEdges.push_back(newe);
@@ -71,7 +76,7 @@ const InsetFacesResult InsetFaces(Core::Mesh* m, const std::vector<Core::Face*>&
         // create outer ring faces
         std::vector<Core::Edge*> innerEdges = std::vector<Core::Edge*>();
         for(std::size_t i = 0; i < newVerts.size() - 1; ++i) {
-            Core::Edge* newe = new Core::Edge();
+            Core::Edge* newe = m->NewEdge();
             Core::MakeEdge(newVerts.at(i), newVerts.at(i + 1), newe);
             innerEdges.push_back(newe);
             centerEdges.push_back(newe);
@@ -81,14 +86,14 @@ const InsetFacesResult InsetFaces(Core::Mesh* m, const std::vector<Core::Face*>&
                 faceLoops.at(i)->LoopVert(), faceLoops.at(i + 1)->LoopVert(), newVerts.at(i + 1), newVerts.at(i)};
             std::vector<Core::Edge*> fEdges = {faceLoops.at(i)->LoopEdge(), newEdges.at(i + 1), newe, newEdges.at(i)};
 
-            Core::Loop* newl = new Core::Loop();
+            Core::Loop* newl = m->NewLoop();
             Core::MakeLoop(fEdges, fVerts, newl);
-            Core::Face* newf = new Core::Face();
+            Core::Face* newf = m->NewFace();
             Core::MakeFace(newl, newf);
             boundaryFaces.push_back(newf);
         }
         // final iteration
-        Core::Edge* newe = new Core::Edge();
+        Core::Edge* newe = m->NewEdge();
         Core::MakeEdge(newVerts.back(), newVerts.at(0), newe);
         innerEdges.push_back(newe);
         centerEdges.push_back(newe);
@@ -96,16 +101,16 @@ const InsetFacesResult InsetFaces(Core::Mesh* m, const std::vector<Core::Face*>&
             faceLoops.back()->LoopVert(), faceLoops.at(0)->LoopVert(), newVerts.at(0), newVerts.back()};
         std::vector<Core::Edge*> fEdges = {faceLoops.back()->LoopEdge(), newEdges.at(0), newe, newEdges.back()};
 
-        Core::Loop* newl = new Core::Loop();
+        Core::Loop* newl = m->NewLoop();
         Core::MakeLoop(fEdges, fVerts, newl);
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
         Core::MakeFace(newl, newf);
         boundaryFaces.push_back(newf);
 
         // create inner face
-        newl = new Core::Loop();
+        newl = m->NewLoop();
         Core::MakeLoop(innerEdges, newVerts, newl);
-        newf = new Core::Face();
+        newf = m->NewFace();
         Core::MakeFace(newl, newf);
 
         centerFaces.push_back(newf);
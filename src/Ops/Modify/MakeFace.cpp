@@ -17,7 +17,7 @@ Core::Face* MakeFace(Core::Mesh* m, std::vector<Core::Edge*> edges) {
 
     loopEdges.push_back(edges.at(0));
     if(edges.at(0)->IsBoundary()) {
-        if(edges.at(0)->Loops().at(0)->LoopVert() == edges.at(0)->V1()) {
+        if((*edges.at(0)->LoopRange().begin())->LoopVert() == edges.at(0)->V1()) {
             loopVerts.push_back(edges.at(0)->V2());
             loopVerts.push_back(edges.at(0)->V1());
         } else {
@@ -60,26 +60,23 @@ Core::Face* MakeFace(Core::Mesh* m, std::vector<Core::Edge*> edges) {
     }
     loopVerts.pop_back();
 
-    // use flags to check for duplicates
+    // use visit markers to check for duplicates
     bool duplicate = false;
-    int32_t MARKED = 1 << 0;
+    const uint32_t MARKED = m->NewGeneration();
     for(Core::Vert* v : loopVerts) {
-        if(v->flagsIntern & MARKED) {
+        if(Core::IsMarked(v, MARKED)) {
             duplicate = true;
             break;
         }
-        v->flagsIntern = MARKED;
-    }
-    for(Core::Vert* v : loopVerts) {
-        v->flagsIntern = 0;
+        Core::Mark(v, MARKED);
     }
 
     if(duplicate) {
         throw std::invalid_argument("Duplicate verts found");
     }
 
-    Core::Face* newf = new Core::Face();
-    Core::Loop* newl = new Core::Loop();
+    Core::Face* newf = m->NewFace();
+    Core::Loop* newl = m->NewLoop();
     Core::MakeLoop(loopEdges, loopVerts, newl);
     Core::MakeFace(newl, newf);
     return newf;
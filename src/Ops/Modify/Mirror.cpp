@@ -12,7 +12,7 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     Math::Mat3 mat = Math::Mat3::Scale(axis, -1);
 
     // duplicate all geometry
-    const int32_t COPIED = 1 << 0;
+    const uint32_t COPIED = m->NewGeneration();
 
     std::vector<Core::Vert*> vertsToMerge = std::vector<Core::Vert*>();
 
@@ -22,11 +22,11 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     int vertIdx = 0;
 
     for(int i = 0; i < verts.size(); ++i) {
-        Core::Vert* newv = new Core::Vert();
+        Core::Vert* newv = m->NewVert();
         Core::MakeVert(m, newv);
 
-        newv->co = verts.at(i)->co;
-        verts.at(i)->flagsIntern = COPIED;
+        newv->Co() = verts.at(i)->Co();
+        Core::Mark(verts.at(i), COPIED);
 
         verts.at(i)->index = vertIdx;
         vertIdx++;
@@ -34,12 +34,12 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
         newVerts.push_back(newv);
 
         // transform the new vert.
-        newv->co -= center;
-        newv->co = mat * newv->co;
-        newv->co += center;
+        newv->Co() -= center;
+        newv->Co() = mat * newv->Co();
+        newv->Co() += center;
 
         // if coordinate is within merge dist, mark for merging
-        if(fabsf((verts.at(i)->co - center).Dot(axis)) < mergeDist) {
+        if(fabsf((verts.at(i)->Co() - center).Dot(axis)) < mergeDist) {
             vertsToMerge.push_back(verts.at(i));
         }
     }
@@ -50,60 +50,60 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     int edgeIdx = 0;
 
     for(int i = 0; i < edges.size(); ++i) {
-        Core::Edge* newe = new Core::Edge();
+        Core::Edge* newe = m->NewEdge();
         Core::Edge* current = edges.at(i);
         current->index = edgeIdx;
-        current->flagsIntern = COPIED;
+        Core::Mark(current, COPIED);
         edgeIdx++;
 
         Core::Vert* v1;
         Core::Vert* v2;
 
-        if(current->Verts().at(0)->flagsIntern & COPIED) {
-            v1 = newVerts.at(current->Verts().at(0)->index);
+        if(Core::IsMarked(current->V1(), COPIED)) {
+            v1 = newVerts.at(current->V1()->index);
         } else {
-            v1 = new Core::Vert();
+            v1 = m->NewVert();
             Core::MakeVert(m, v1);
 
-            v1->co = current->Verts().at(0)->co;
-            current->Verts().at(0)->flagsIntern = COPIED;
+            v1->Co() = current->V1()->Co();
+            Core::Mark(current->V1(), COPIED);
 
-            current->Verts().at(0)->index = vertIdx;
+            current->V1()->index = vertIdx;
             vertIdx++;
             newVerts.push_back(v1);
 
             // transform the new vert.
-            v1->co -= center;
-            v1->co = mat * v1->co;
-            v1->co += center;
+            v1->Co() -= center;
+            v1->Co() = mat * v1->Co();
+            v1->Co() += center;
 
             // if coordinate is within merge dist, mark for merging
-            if(fabsf((current->Verts().at(0)->co - center).Dot(axis)) < mergeDist) {
-                vertsToMerge.push_back(current->Verts().at(0));
+            if(fabsf((current->V1()->Co() - center).Dot(axis)) < mergeDist) {
+                vertsToMerge.push_back(current->V1());
             }
         }
 
-        if(current->Verts().at(1)->flagsIntern & COPIED) {
-            v2 = newVerts.at(current->Verts().at(1)->index);
+        if(Core::IsMarked(current->V2(), COPIED)) {
+            v2 = newVerts.at(current->V2()->index);
         } else {
-            v2 = new Core::Vert();
+            v2 = m->NewVert();
             Core::MakeVert(m, v2);
 
-            v2->co = current->Verts().at(1)->co;
-            current->Verts().at(1)->flagsIntern = COPIED;
+            v2->Co() = current->V2()->Co();
+            Core::Mark(current->V2(), COPIED);
 
-            current->Verts().at(1)->index = vertIdx;
+            current->V2()->index = vertIdx;
             vertIdx++;
             newVerts.push_back(v2);
 
             // transform the new vert.
-            v2->co -= center;
-            v2->co = mat * v2->co;
-            v2->co += center;
+            v2->Co() -= center;
+            v2->Co() = mat * v2->Co();
+            v2->Co() += center;
 
             // if coordinate is within merge dist, mark for merging
-            if(fabsf((current->Verts().at(1)->co - center).Dot(axis)) < mergeDist) {
-                vertsToMerge.push_back(current->Verts().at(1));
+            if(fabsf((current->V2()->Co() - center).Dot(axis)) < mergeDist) {
+                vertsToMerge.push_back(current->V2());
             }
         }
 
@@ -116,98 +116,97 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     newFaces.reserve(edges.size());
 
     for(int i = 0; i < faces.size(); ++i) {
-        Core::Face* newf = new Core::Face();
+        Core::Face* newf = m->NewFace();
 
         std::vector<Core::Loop*> newFaceLoops = std::vector<Core::Loop*>();
 
-        std::vector<Core::Loop*> loops = faces.at(i)->Loops();
         std::vector<Core::Vert*> loopVerts = std::vector<Core::Vert*>();
         std::vector<Core::Edge*> loopEdges = std::vector<Core::Edge*>();
 
-        for(int k = 0; k < loops.size(); ++k) {
+        for(Core::Loop* loop : faces.at(i)->LoopRange()) {
             // check if loop vert is copied, push to loopverts
-            if(loops.at(k)->LoopVert()->flagsIntern & COPIED) {
-                loopVerts.push_back(newVerts.at(loops.at(k)->LoopVert()->index));
+            if(Core::IsMarked(loop->LoopVert(), COPIED)) {
+                loopVerts.push_back(newVerts.at(loop->LoopVert()->index));
             } else {
-                Core::Vert* newv = new Core::Vert();
+                Core::Vert* newv = m->NewVert();
                 Core::MakeVert(m, newv);
 
-                newv->co = loops.at(k)->LoopVert()->co;
-                loops.at(k)->LoopVert()->flagsIntern = COPIED;
-                loops.at(k)->LoopVert()->index = vertIdx;
+                newv->Co() = loop->LoopVert()->Co();
+                Core::Mark(loop->LoopVert(), COPIED);
+                loop->LoopVert()->index = vertIdx;
                 vertIdx++;
                 newVerts.push_back(newv);
                 loopVerts.push_back(newv);
 
                 // transform the new vert.
-                newv->co -= center;
-                newv->co = mat * newv->co;
-                newv->co += center;
+                newv->Co() -= center;
+                newv->Co() = mat * newv->Co();
+                newv->Co() += center;
 
                 // if coordinate is within merge dist, mark for merging
-                if(fabsf((loops.at(k)->LoopVert()->co - center).Dot(axis)) < mergeDist) {
-                    vertsToMerge.push_back(loops.at(k)->LoopVert());
+                if(fabsf((loop->LoopVert()->Co() - center).Dot(axis)) < mergeDist) {
+                    vertsToMerge.push_back(loop->LoopVert());
                 }
             }
 
             // check if loop edge is copied, push to loopedges
-            if(loops.at(k)->LoopEdge()->flagsIntern & COPIED) {
-                loopEdges.push_back(newEdges.at(loops.at(k)->LoopEdge()->index));
+            if(Core::IsMarked(loop->LoopEdge(), COPIED)) {
+                loopEdges.push_back(newEdges.at(loop->LoopEdge()->index));
             } else {
-                Core::Edge* newe = new Core::Edge();
-                Core::Edge* current = loops.at(k)->LoopEdge();
+                Core::Edge* newe = m->NewEdge();
+                Core::Edge* current = loop->LoopEdge();
                 current->index = edgeIdx;
-                current->flagsIntern = COPIED;
+                Core::Mark(current, COPIED);
                 edgeIdx++;
 
                 Core::Vert* v1;
                 Core::Vert* v2;
 
-                if(current->Verts().at(0)->flagsIntern & COPIED) {
-                    v1 = newVerts.at(current->Verts().at(0)->index);
+                if(Core::IsMarked(current->V1(), COPIED)) {
+                    v1 = newVerts.at(current->V1()->index);
                 } else {
-                    v1 = new Core::Vert();
+                    v1 = m->NewVert();
                     Core::MakeVert(m, v1);
 
-                    v1->co = current->Verts().at(0)->co;
-                    current->Verts().at(0)->flagsIntern = COPIED;
+                    v1->Co() = current->V1()->Co();
+                    Core::Mark(current->V1(), COPIED);
 
-                    current->Verts().at(0)->index = vertIdx;
+                    current->V1()->index = vertIdx;
                     vertIdx++;
                     newVerts.push_back(v1);
 
                     // transform the new vert.
-                    v1->co -= center;
-                    v1->co = mat * v1->co;
-                    v1->co += center;
+                    v1->Co() -= center;
+                    v1->Co() = mat * v1->Co();
+                    v1->Co() += center;
 
                     // if coordinate is within merge dist, mark for merging
-                    if(fabsf((current->Verts().at(0)->co - center).Dot(axis)) < mergeDist) {
-                        vertsToMerge.push_back(current->Verts().at(0));
+                    if(fabsf((current->V1()->Co() - center).Dot(axis)) < mergeDist) {
+                        vertsToMerge.push_back(current->V1());
                     }
                 }
 
-                if(current->Verts().at(1)->flagsIntern & COPIED) {
-                    v2 = newVerts.at(current->Verts().at(1)->index);
+                if(Core::IsMarked(current->V2(), COPIED)) {
+                    v2 = newVerts.at(current->V2()->index);
                 } else {
-                    v2 = new Core::Vert();
+                    v2 = m->NewVert();
                     Core::MakeVert(m, v2);
 
-                    v2->co = current->Verts().at(1)->co;
-                    current->Verts().at(1)->flagsIntern = COPIED;
+                    v2->Co() = current->V2()->Co();
+                    Core::Mark(current->V2(), COPIED);
 
-                    current->Verts().at(1)->index = vertIdx;
+                    current->V2()->index = vertIdx;
                     vertIdx++;
                     newVerts.push_back(v2);
 
                     // transform the new vert.
-                    v2->co -= center;
-                    v2->co = mat * v2->co;
-                    v2->co += center;
+                    v2->Co() -= center;
+                    v2->Co() = mat * v2->Co();
+                    v2->Co() += center;
 
                     // if coordinate is within merge dist, mark for merging
-                    if(fabsf((current->Verts().at(1)->co - center).Dot(axis)) < mergeDist) {
-                        vertsToMerge.push_back(current->Verts().at(1));
+                    if(fabsf((current->V2()->Co() - center).Dot(axis)) < mergeDist) {
+                        vertsToMerge.push_back(current->V2());
                     }
                 }
 
@@ -217,7 +216,7 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
             }
         }
 
-        Core::Loop* newl = new Core::Loop();
+        Core::Loop* newl = m->NewLoop();
         Core::MakeLoop(loopEdges, loopVerts, newl);
 
         Core::MakeFace(newl, newf);
@@ -242,43 +241,6 @@ const MirrorResult Mirror(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     result.edges = newEdges;
     result.mergedVerts = vertsToMerge;
 
-    // TODO: perhaps this could be done faster
-    // clear all flags and indexes
-    for(int i = 0; i < verts.size(); ++i) {
-        verts.at(i)->flagsIntern = 0;
-        verts.at(i)->index = 0;
-        vertIdx++;
-    }
-
-    for(int i = 0; i < edges.size(); ++i) {
-        edges.at(i)->flagsIntern = 0;
-        edges.at(i)->index = 0;
-
-        edges.at(i)->Verts().at(0)->index = 0;
-        edges.at(i)->Verts().at(0)->flagsIntern = 0;
-        edges.at(i)->Verts().at(1)->index = 0;
-        edges.at(i)->Verts().at(1)->flagsIntern = 0;
-    }
-
-    for(int i = 0; i < faces.size(); ++i) {
-        std::vector<Core::Loop*> loops = faces.at(i)->Loops();
-
-        for(int k = 0; k < loops.size(); ++k) {
-            loops.at(k)->LoopVert()->flagsIntern = 0;
-            loops.at(k)->LoopVert()->index = 0;
-
-            if(loops.at(k)->LoopEdge()->flagsIntern) {
-                loops.at(k)->LoopEdge()->Verts().at(0)->index = 0;
-                loops.at(k)->LoopEdge()->Verts().at(0)->flagsIntern = 0;
-                loops.at(k)->LoopEdge()->Verts().at(1)->index = 0;
-                loops.at(k)->LoopEdge()->Verts().at(1)->flagsIntern = 0;
-            }
-
-            loops.at(k)->LoopEdge()->flagsIntern = 0;
-            loops.at(k)->LoopEdge()->index = 0;
-        }
-    }
-
     return result;
 }
 
@@ -5,7 +5,7 @@ namespace Ops {
 
 void RecalculateFaceNormals(Core::Mesh* m, const std::vector<Core::Face*>& faces) {
     for(Core::Face* face : faces) {
-        face->NormalUpdate();
+        m->NormalUpdate(face);
     }
 }
 
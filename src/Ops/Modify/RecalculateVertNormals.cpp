@@ -0,0 +1,99 @@
+#include "AobaAPI/Ops/Modify.hpp"
+
+#include <cmath>
+
+namespace Aoba {
+namespace Ops {
+
+namespace {
+
+// newell's algorithm, like Face::NormalUpdate. the length of the result is twice the area of the face
+Math::Vec3 CalcNewell(const Core::Face* face) {
+    Math::Vec3 no = Math::Vec3(0, 0, 0);
+    for(Core::Loop* loop : face->LoopRange()) {
+        const Math::Vec3& vc = loop->LoopVert()->Co();
+        const Math::Vec3& vn = loop->FaceNext()->LoopVert()->Co();
+        no.x += (vc.y - vn.y) * (vc.z + vn.z);
+        no.y += (vc.z - vn.z) * (vc.x + vn.x);
+        no.z += (vc.x - vn.x) * (vc.y + vn.y);
+    }
+    return no;
+}
+
+// angle of the face corner at the vert the loop starts in, 0 for degenerate corners
+float CalcCornerAngle(const Core::Loop* loop) {
+    const Math::Vec3& co = loop->LoopVert()->Co();
+    Math::Vec3 toPrev = loop->FacePrev()->LoopVert()->Co() - co;
+    Math::Vec3 toNext = loop->FaceNext()->LoopVert()->Co() - co;
+    float lengths = sqrtf(toPrev.LengthSquared() * toNext.LengthSquared());
+    if(lengths == 0.0f) {
+        return 0.0f;
+    }
+    float cosine = toPrev.Dot(toNext) / lengths;
+    if(cosine > 1.0f) {
+        cosine = 1.0f;
+    } else if(cosine < -1.0f) {
+        cosine = -1.0f;
+    }
+    return acosf(cosine);
+}
+
+} // namespace
+
+void RecalculateVertNormals(Core::Mesh* m, const std::vector<Core::Vert*>& verts, VertNormalWeighting weighting,
+    std::size_t threadCount) {
+    const std::size_t GRAIN_SIZE = 4096;
+    const bool areaWeighted = weighting == VertNormalWeighting::Area || weighting == VertNormalWeighting::AreaAndAngle;
+    const bool angleWeighted =
+        weighting == VertNormalWeighting::Angle || weighting == VertNormalWeighting::AreaAndAngle;
+
+    // collect the faces around the verts once, using a visit generation to skip faces which were already found
+    const uint32_t FOUND = m->NewGeneration();
+    std::vector<Core::Face*> faces = std::vector<Core::Face*>();
+    for(Core::Vert* vert : verts) {
+        for(Core::Face* face : vert->FaceRange()) {
+            if(!Core::IsMarked(face, FOUND)) {
+                Core::Mark(face, FOUND);
+                faces.push_back(face);
+            }
+        }
+    }
+
+    // normals are calculated in parallel, and stored in a serial pass since recording is not thread safe
+    std::vector<Math::Vec3> faceNormals = std::vector<Math::Vec3>(faces.size());
+    Core::ParallelFor(faces.size(), GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Math::Vec3 no = CalcNewell(faces[i]);
+            float length = no.Length();
+            faceNormals[i] = length > 0.0f ? no / length : Math::Vec3(0, 0, 0);
+        }
+    });
+    for(std::size_t i = 0; i < faces.size(); ++i) {
+        m->SetNo(faces[i], faceNormals[i]);
+    }
+
+    // every vert gathers the normals of its own faces. the area weighted normal of a face is half of its newell
+    // vector, which is computed per corner, so faces need no numbering
+    std::vector<Math::Vec3> vertNormals = std::vector<Math::Vec3>(verts.size());
+    Core::ParallelFor(verts.size(), GRAIN_SIZE, threadCount, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            Math::Vec3 sum = Math::Vec3(0, 0, 0);
+            for(Core::Loop* loop : verts[i]->LoopRange()) {
+                Core::Face* face = loop->LoopFace();
+                Math::Vec3 no = areaWeighted ? CalcNewell(face) / 2 : face->no;
+                if(angleWeighted) {
+                    no *= CalcCornerAngle(loop);
+                }
+                sum += no;
+            }
+            float length = sum.Length();
+            vertNormals[i] = length > 0.0f ? sum / length : Math::Vec3(0, 0, 0);
+        }
+    });
+    for(std::size_t i = 0; i < verts.size(); ++i) {
+        m->SetNo(verts[i], vertNormals[i]);
+    }
+}
+
+} // namespace Ops
+} // namespace Aoba
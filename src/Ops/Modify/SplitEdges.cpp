@@ -27,15 +27,15 @@ const SplitEdgesResult SplitEdges(
     newVerts.reserve(edges.size() * cuts);
 
     for(Core::Edge* edge : edges) {
-        Math::Vec3 dist = edge->V2()->co - edge->V1()->co;
+        Math::Vec3 dist = edge->V2()->Co() - edge->V1()->Co();
         Core::Edge* edgeToSplit = edge;
         float ratioSum = 0;
         for(unsigned i = 0; i < cuts; ++i) {
             ratioSum += ratios.at(i);
-            Core::Edge* newe = new Core::Edge();
-            Core::Vert* newv = new Core::Vert();
-            newv->co = edge->V1()->co + (ratioSum * dist);
-            Core::EdgeSplit(edgeToSplit, edgeToSplit->Verts().at(1), newe, newv);
+            Core::Edge* newe = m->NewEdge();
+            Core::Vert* newv = m->NewVert();
+            newv->Co() = edge->V1()->Co() + (ratioSum * dist);
+            Core::EdgeSplit(edgeToSplit, edgeToSplit->V2(), newe, newv);
             edgeToSplit = newe;
             newEdges.push_back(newe);
             newVerts.push_back(newv);
@@ -1,14 +1,14 @@
 #include "AobaAPI/Ops/Modify.hpp"
 
+#include <iterator>
+
 namespace Aoba {
 namespace Ops {
 
 const SubdivideResult SubdivideSimple(
     Core::Mesh* m, const std::vector<Core::Edge*>& edges, const std::vector<Core::Face*>& faces) {
-    // flags
-    const int32_t EDGE_SPLIT = 1 << 0;
-    const int32_t EDGE_NEW = 1 << 1;
-    const int32_t VERT_NEW = 1 << 0;
+    // visit marker for split and new edges, and for new verts
+    const uint32_t NEW = m->NewGeneration();
 
     SubdivideResult result = SubdivideResult();
     result.edges = std::vector<Core::Edge*>();
@@ -18,16 +18,16 @@ const SubdivideResult SubdivideSimple(
 
     // subdivide the edges of all input faces
     for(Core::Face* face : faces) {
-        for(Core::Edge* edge : face->Edges()) {
-            if(edge->flagsIntern == 0) {
-                Core::Vert* newv = new Core::Vert();
-                Core::Edge* newe = new Core::Edge();
-                newv->co = (edge->V1()->co + edge->V2()->co) / 2;
+        for(Core::Edge* edge : face->EdgeRange()) {
+            if(!Core::IsMarked(edge, NEW)) {
+                Core::Vert* newv = m->NewVert();
+                Core::Edge* newe = m->NewEdge();
+                newv->Co() = (edge->V1()->Co() + edge->V2()->Co()) / 2;
 
                 Core::EdgeSplit(edge, edge->V1(), newe, newv);
-                newv->flagsIntern = VERT_NEW;
-                newe->flagsIntern = EDGE_NEW;
-                edge->flagsIntern = EDGE_SPLIT;
+                Core::Mark(newv, NEW);
+                Core::Mark(newe, NEW);
+                Core::Mark(edge, NEW);
 
                 result.edges.push_back(newe);
                 result.edges.push_back(edge);
@@ -38,10 +38,10 @@ const SubdivideResult SubdivideSimple(
 
     // subdivide other input edges
     for(Core::Edge* edge : edges) {
-        if(!(edge->flagsIntern & EDGE_SPLIT)) {
-            Core::Vert* newv = new Core::Vert();
-            Core::Edge* newe = new Core::Edge();
-            newv->co = (edge->V1()->co + edge->V2()->co) / 2;
+        if(!Core::IsMarked(edge, NEW)) {
+            Core::Vert* newv = m->NewVert();
+            Core::Edge* newe = m->NewEdge();
+            newv->Co() = (edge->V1()->Co() + edge->V2()->Co()) / 2;
 
             Core::EdgeSplit(edge, edge->V1(), newe, newv);
             // no need to set tags here, as this is not used by subdivided faces
@@ -53,39 +53,40 @@ const SubdivideResult SubdivideSimple(
     }
 
     // subdivide faces
+    // the face is split while the new verts are connected, so they are copied first. the buffer is reused for all faces
+    std::vector<Core::Vert*> verts = std::vector<Core::Vert*>();
     for(Core::Face* face : faces) {
         // find newly created verts which must be connected to face center. this list should be ordered
-        std::vector<Core::Vert*> verts = face->Verts([VERT_NEW](const Core::Vert* const v) {
-            return (v->flagsIntern == VERT_NEW);
-        });
-        // find old verts used for center calculation
-        std::vector<Core::Vert*> oldVerts = face->Verts([VERT_NEW](const Core::Vert* const v) {
-            return (v->flagsIntern != VERT_NEW);
-        });
-
-        // calculate original face center
+        verts.clear();
+        face->VertsWhere([NEW](const Core::Vert* const v) { return Core::IsMarked(v, NEW); })
+            .CopyTo(std::back_inserter(verts));
+        // calculate original face center from the old verts
         Math::Vec3 center = Math::Vec3();
-        for(Core::Vert* oldVert : oldVerts) {
-            center += oldVert->co;
+        std::size_t oldVertCount = 0;
+        for(Core::Vert* oldVert : face->VertRange()) {
+            if(!Core::IsMarked(oldVert, NEW)) {
+                center += oldVert->Co();
+                oldVertCount++;
+            }
         }
-        center = center / static_cast<float>(oldVerts.size());
+        center = center / static_cast<float>(oldVertCount);
 
         // initial face split:
-        Core::Edge* newe = new Core::Edge();
-        Core::Face* newf = new Core::Face();
+        Core::Edge* newe = m->NewEdge();
+        Core::Face* newf = m->NewFace();
         Core::ManifoldMakeEdge(verts.at(0), verts.at(1), face, newe, newf);
 
-        Core::Edge* split = new Core::Edge();
-        Core::Vert* centerVert = new Core::Vert();
+        Core::Edge* split = m->NewEdge();
+        Core::Vert* centerVert = m->NewVert();
         Core::EdgeSplit(newe, verts.at(0), split, centerVert);
-        centerVert->co = center;
+        centerVert->Co() = center;
 
         result.edges.push_back(newe);
         result.edges.push_back(split);
         result.faceVerts.push_back(centerVert);
 
         Core::Face* faceToSplit = face;
-        if(face->Loops().size() == 4) {
+        if(face->LoopRange().Size() == 4) {
             faceToSplit = newf;
             result.faces.push_back(face);
         } else {
@@ -93,26 +94,17 @@ const SubdivideResult SubdivideSimple(
         }
 
         for(std::size_t idx = 2; idx < verts.size(); ++idx) {
-            Core::Edge* newSplit = new Core::Edge();
-            Core::Face* newFace = new Core::Face();
+            Core::Edge* newSplit = m->NewEdge();
+            Core::Face* newFace = m->NewFace();
             result.faces.push_back(newFace);
             result.edges.push_back(newSplit);
             Core::ManifoldMakeEdge(centerVert, verts.at(idx), faceToSplit, newSplit, newFace);
-            if(newFace->Loops().size() > 4) {
+            if(newFace->LoopRange().Size() > 4) {
                 faceToSplit = newFace;
             }
         }
     }
 
-    // clear flags
-    for(Core::Edge* edge : result.edges) {
-        edge->flagsIntern = 0;
-    }
-
-    for(Core::Vert* vert : result.edgeVerts) {
-        vert->flagsIntern = 0;
-    }
-
     return result;
 }
 
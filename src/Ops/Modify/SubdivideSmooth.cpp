@@ -1,5 +1,7 @@
 #include "AobaAPI/Ops/Modify.hpp"
 
+#include <iterator>
+
 namespace Aoba {
 namespace Ops {
 
@@ -11,12 +13,12 @@ const SubdivideResult SubdivideSmooth(
     result.faceVerts = std::vector<Core::Vert*>();
     result.faces = std::vector<Core::Face*>();
 
-    // flags
+    // flags, valid for the current generation only
+    const uint32_t gen = m->NewGeneration();
     const int32_t EDGE_INPUT = 1 << 0;
     const int32_t EDGE_BOUNDARY = 1 << 1;
     const int32_t EDGE_SPLIT = 1 << 2;
     const int32_t EDGE_NEW = 1 << 3;
-    const int32_t FACE_INPUT = 1 << 0;
     const int32_t VERT_INPUT = 1 << 0;
     const int32_t VERT_NEW = 1 << 1;
     const int32_t VERT_CENTER = 1 << 2;
@@ -35,11 +37,11 @@ const SubdivideResult SubdivideSmooth(
         face->index = faceIdx;
         ++faceIdx;
         faceCenterCoords.push_back(face->CalcCenterAverage());
-        face->flagsIntern = FACE_INPUT;
-        for(Core::Vert* v : face->Verts()) {
-            if(!(v->flagsIntern & VERT_INPUT)) {
+        Core::Mark(face, gen);
+        for(Core::Vert* v : face->VertRange()) {
+            if(!Core::HasMark(v, gen, VERT_INPUT)) {
                 inputVerts.push_back(v);
-                v->flagsIntern += VERT_INPUT;
+                Core::SetMark(v, gen, VERT_INPUT);
             }
         }
     }
@@ -47,42 +49,44 @@ const SubdivideResult SubdivideSmooth(
     // calculate new edge center coordinates, find input edges and verrs, find boundary edges
     std::size_t edgeIdx = 0;
     for(Core::Face* face : faces) {
-        for(Core::Edge* edge : face->Edges()) {
-            if(!(edge->flagsIntern & EDGE_INPUT)) {
-                edge->flagsIntern = EDGE_INPUT;
+        for(Core::Edge* edge : face->EdgeRange()) {
+            if(!Core::HasMark(edge, gen, EDGE_INPUT)) {
+                Core::SetMark(edge, gen, EDGE_INPUT);
                 edge->index = edgeIdx;
                 inputEdges.push_back(edge);
                 edgeIdx++;
-                std::vector<Core::Face*> inputFaces = edge->Faces([FACE_INPUT](const Core::Face* const f) {
-                    return (f->flagsIntern == FACE_INPUT);
-                });
-                if(inputFaces.size() > 1) {
-                    Math::Vec3 res = edge->V1()->co + edge->V2()->co;
-                    for(Core::Face* f : inputFaces) {
-                        res += faceCenterCoords.at(f->index);
-                    }
-                    res /= (inputFaces.size() + 2.0f);
+                std::size_t inputFaceCount = 0;
+                Math::Vec3 res = edge->V1()->Co() + edge->V2()->Co();
+                auto isInput = [gen](const Core::Face* const f) {
+                    return Core::IsMarked(f, gen);
+                };
+                for(Core::Face* f : edge->FacesWhere(isInput)) {
+                    res += faceCenterCoords.at(f->index);
+                    inputFaceCount++;
+                }
+                if(inputFaceCount > 1) {
+                    res /= (inputFaceCount + 2.0f);
                     edgeCoords.push_back(res);
                 } else {
-                    edge->flagsIntern += EDGE_BOUNDARY;
-                    edgeCoords.push_back((edge->V1()->co + edge->V2()->co) / 2);
+                    Core::SetMark(edge, gen, EDGE_BOUNDARY);
+                    edgeCoords.push_back((edge->V1()->Co() + edge->V2()->Co()) / 2);
                 }
             }
         }
     }
     for(Core::Edge* edge : edges) {
-        if(!(edge->flagsIntern & EDGE_INPUT)) {
-            edge->flagsIntern = EDGE_INPUT + EDGE_BOUNDARY;
+        if(!Core::HasMark(edge, gen, EDGE_INPUT)) {
+            Core::SetMark(edge, gen, EDGE_INPUT | EDGE_BOUNDARY);
             edge->index = edgeIdx;
             inputEdges.push_back(edge);
             edgeIdx++;
             // not checking face here, if it were touching a face, would have already visited it.
-            edgeCoords.push_back((edge->V1()->co + edge->V2()->co) / 2);
+            edgeCoords.push_back((edge->V1()->Co() + edge->V2()->Co()) / 2);
 
-            for(Core::Vert* v : edge->Verts()) {
-                if(!(v->flagsIntern & VERT_INPUT)) {
+            for(Core::Vert* v : {edge->V1(), edge->V2()}) {
+                if(!Core::HasMark(v, gen, VERT_INPUT)) {
                     inputVerts.push_back(v);
-                    v->flagsIntern += VERT_INPUT;
+                    Core::SetMark(v, gen, VERT_INPUT);
                 }
             }
         }
@@ -94,90 +98,83 @@ const SubdivideResult SubdivideSmooth(
         vert->index = vertIdx;
         ++vertIdx;
         // if vertex is boundary(has at least one boundary edge)
-        // calculate point as avg(v->co + v->co + boundary edge coordinates)
+        // calculate point as avg(v->Co() + v->Co() + boundary edge coordinates)
         // boundary edge in this case also fits the wire edge case.
         int boundaryCount = 0;
-        auto vertEdges = vert->Edges();
+        std::size_t vertEdgeCount = 0;
         Math::Vec3 boundaryEdgePointsSum = Math::Vec3();
         Math::Vec3 avgEdgeCenters = Math::Vec3();
-        for(Core::Edge* edge : vertEdges) {
-            if(edge->flagsIntern & EDGE_BOUNDARY) {
+        for(Core::Edge* edge : vert->EdgeRange()) {
+            vertEdgeCount++;
+            if(Core::HasMark(edge, gen, EDGE_BOUNDARY)) {
                 boundaryCount++;
                 boundaryEdgePointsSum += edgeCoords.at(edge->index);
             }
-            if(edge->flagsIntern & EDGE_INPUT && !boundaryCount) {
-                avgEdgeCenters += edge->V1()->co;
-                avgEdgeCenters += edge->V2()->co;
+            if(Core::HasMark(edge, gen, EDGE_INPUT) && !boundaryCount) {
+                avgEdgeCenters += edge->V1()->Co();
+                avgEdgeCenters += edge->V2()->Co();
             }
         }
         avgEdgeCenters /= 2.0f;
 
         if(boundaryCount) {
-            vertCoords.push_back(((2 * vert->co) + boundaryEdgePointsSum) / (boundaryCount + 2.0f));
+            vertCoords.push_back(((2 * vert->Co()) + boundaryEdgePointsSum) / (boundaryCount + 2.0f));
         } else {
             Math::Vec3 avgFacePoints = Math::Vec3();
-            auto vertFaces = vert->Faces();
-            for(Core::Face* face : vertFaces) {
+            std::size_t vertFaceCount = 0;
+            for(Core::Face* face : vert->FaceRange()) {
                 avgFacePoints += faceCenterCoords.at(face->index);
+                vertFaceCount++;
             }
-            avgFacePoints /= static_cast<float>(vertFaces.size());
-            avgEdgeCenters /= static_cast<float>(vertEdges.size()); 
+            avgFacePoints /= static_cast<float>(vertFaceCount);
+            avgEdgeCenters /= static_cast<float>(vertEdgeCount);
 
-
-            vertCoords.push_back(
-                (avgFacePoints + 2 * avgEdgeCenters + vert->co * (vertFaces.size() - 3.0f)) / static_cast<float>(vertFaces.size()));
+            vertCoords.push_back((avgFacePoints + 2 * avgEdgeCenters + vert->Co() * (vertFaceCount - 3.0f))
+                                 / static_cast<float>(vertFaceCount));
         }
     }
 
     // subdivide all input edges
     for(Core::Edge* edge : inputEdges) {
-        Core::Vert* newv = new Core::Vert();
-        Core::Edge* newe = new Core::Edge();
-        newv->co = edgeCoords.at(edge->index);
-        newv->flagsIntern = VERT_NEW;
-        edge->flagsIntern += EDGE_SPLIT;
-        newe->flagsIntern = EDGE_NEW;
-
-        auto pp = edge->V1()->Edges();
+        Core::Vert* newv = m->NewVert();
+        Core::Edge* newe = m->NewEdge();
+        newv->Co() = edgeCoords.at(edge->index);
+        Core::SetMark(newv, gen, VERT_NEW);
+        Core::SetMark(edge, gen, EDGE_SPLIT);
+        Core::SetMark(newe, gen, EDGE_NEW);
 
         Core::EdgeSplit(edge, edge->V1(), newe, newv);
         result.edges.push_back(newe);
         result.edges.push_back(edge);
         result.edgeVerts.push_back(newv);
-
-        pp = edge->V1()->Edges();
     }
 
     // subdivide faces
+    // the face is split while the new verts are connected, so they are copied first. the buffer is reused for all faces
+    std::vector<Core::Vert*> verts = std::vector<Core::Vert*>();
     for(Core::Face* face : faces) {
         // find newly created verts which must be connected to face center. this list should be ordered
-        std::vector<Core::Vert*> verts = face->Verts([VERT_NEW](const Core::Vert* const v) {
-            return (v->flagsIntern & VERT_NEW);
-        });
-
-        auto pp = verts.at(0)->Edges();
-        auto pp2 = verts.at(1)->Edges();
+        verts.clear();
+        face->VertsWhere([gen, VERT_NEW](const Core::Vert* const v) { return Core::HasMark(v, gen, VERT_NEW); })
+            .CopyTo(std::back_inserter(verts));
 
         // initial face split:
-        Core::Edge* newe = new Core::Edge();
-        Core::Face* newf = new Core::Face();
+        Core::Edge* newe = m->NewEdge();
+        Core::Face* newf = m->NewFace();
         Core::ManifoldMakeEdge(verts.at(0), verts.at(1), face, newe, newf);
 
-        pp = verts.at(0)->Edges();
-        pp2 = verts.at(1)->Edges();
-
-        Core::Edge* split = new Core::Edge();
-        Core::Vert* centerVert = new Core::Vert();
+        Core::Edge* split = m->NewEdge();
+        Core::Vert* centerVert = m->NewVert();
         Core::EdgeSplit(newe, verts.at(0), split, centerVert);
-        centerVert->co = faceCenterCoords.at(face->index);
-        centerVert->flagsIntern = VERT_CENTER;
+        centerVert->Co() = faceCenterCoords.at(face->index);
+        Core::SetMark(centerVert, gen, VERT_CENTER);
 
         result.edges.push_back(newe);
         result.edges.push_back(split);
         result.faceVerts.push_back(centerVert);
 
         Core::Face* faceToSplit = face;
-        if(face->Loops().size() == 4) {
+        if(face->LoopRange().Size() == 4) {
             faceToSplit = newf;
             result.faces.push_back(face);
         } else {
@@ -185,39 +182,20 @@ const SubdivideResult SubdivideSmooth(
         }
 
         for(std::size_t idx = 2; idx < verts.size(); ++idx) {
-            Core::Edge* newSplit = new Core::Edge();
-            Core::Face* newFace = new Core::Face();
+            Core::Edge* newSplit = m->NewEdge();
+            Core::Face* newFace = m->NewFace();
             result.faces.push_back(newFace);
             result.edges.push_back(newSplit);
             Core::ManifoldMakeEdge(centerVert, verts.at(idx), faceToSplit, newSplit, newFace);
-            if(newFace->Loops().size() > 4) {
+            if(newFace->LoopRange().Size() > 4) {
                 faceToSplit = newFace;
             }
         }
     }
 
-    // clear flags
-    for(Core::Edge* edge : result.edges) {
-        edge->flagsIntern = 0;
-    }
-    for(Core::Vert* vert : result.edgeVerts) {
-        vert->flagsIntern = 0;
-    }
-    for(Core::Vert* vert : result.faceVerts) {
-        vert->flagsIntern = 0;
-    }
+    // move input verts to their smoothed positions
     for(Core::Vert* vert : inputVerts) {
-        vert->co = vertCoords.at(vert->index);
-        vert->flagsIntern = 0;
-        vert->index = 0;
-    }
-    for(Core::Edge* edge : inputEdges) {
-        edge->flagsIntern = 0;
-        edge->index = 0;
-    }
-    for(Core::Face* face : faces) {
-        face->flagsIntern = 0;
-        face->index = 0;
+        m->SetCo(vert, vertCoords.at(vert->index));
     }
 
     return result;
@@ -10,7 +10,7 @@ const TriangulateFacesResult TriangulateFaces(Core::Mesh* m, const std::vector<C
     std::vector<Core::Face*> triangularFaces = std::vector<Core::Face*>(); 
 
     for(Core::Face* face : faces) {
-        if(face->Loops().size() > 3) {
+        if(face->LoopRange().Size() > 3) {
             // face not a triangle, mark for splitting
             std::vector<Core::Face*> facesToSplit = {face};
 
@@ -20,19 +20,22 @@ const TriangulateFacesResult TriangulateFaces(Core::Mesh* m, const std::vector<C
                 facesToSplit.pop_back();
 
                 // split face using manifoldMakeEdge
-                Core::Vert* v1 = current->Loops().at(0)->LoopVert();
-                Core::Vert* v2 = current->Loops().at(2)->LoopVert();
-                Core::Edge* newe = new Core::Edge();
-                Core::Face* newf = new Core::Face();
+                Core::FaceVertIterator it = current->VertRange().begin();
+                Core::Vert* v1 = *it;
+                ++it;
+                ++it;
+                Core::Vert* v2 = *it;
+                Core::Edge* newe = m->NewEdge();
+                Core::Face* newf = m->NewFace();
                 Core::ManifoldMakeEdge(v1, v2, current, newe, newf);
                 newEdges.push_back(newe);
 
-                if(current->Loops().size() > 3) {
+                if(current->LoopRange().Size() > 3) {
                     facesToSplit.push_back(current);
                 } else {
                     triangularFaces.push_back(current);
                 }
-                if(newf->Loops().size() > 3) {
+                if(newf->LoopRange().Size() > 3) {
                     facesToSplit.push_back(newf); 
                 } else {
                     triangularFaces.push_back(newf);
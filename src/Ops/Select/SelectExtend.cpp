@@ -5,10 +5,8 @@ namespace Ops {
 
 const SelectResult SelectExtend(Core::Mesh* m, const std::vector<Core::Vert*>& verts,
     const std::vector<Core::Edge*>& edges, const std::vector<Core::Face*>& faces, bool faceStep) {
-    // flags
-    const int32_t SELECTED_FACE = 1 << 0;
-    const int32_t SELECTED_VERT = 1 << 0;
-    const int32_t SELECTED_EDGE = 1 << 0;
+    // visit marker for selected elements
+    const uint32_t SELECTED = m->NewGeneration();
 
     std::vector<Core::Vert*> selectedVerts = std::vector<Core::Vert*>();
     std::vector<Core::Edge*> selectedEdges = std::vector<Core::Edge*>();
@@ -18,20 +16,20 @@ const SelectResult SelectExtend(Core::Mesh* m, const std::vector<Core::Vert*>& v
 
     // mark input verts as selected
     for(Core::Vert* vert : verts) {
-        if(!(vert->flagsIntern & SELECTED_VERT)) {
-            vert->flagsIntern = SELECTED_VERT;
+        if(!Core::IsMarked(vert, SELECTED)) {
+            Core::Mark(vert, SELECTED);
             selectedVerts.push_back(vert);
         }
     }
 
     // mark input edges and their verts as selected
     for(Core::Edge* edge : edges) {
-        if(!(edge->flagsIntern & SELECTED_EDGE)) {
-            edge->flagsIntern = SELECTED_EDGE;
+        if(!Core::IsMarked(edge, SELECTED)) {
+            Core::Mark(edge, SELECTED);
             selectedEdges.push_back(edge);
-            for(Core::Vert* vert : edge->Verts()) {
-                if(!(vert->flagsIntern & SELECTED_VERT)) {
-                    vert->flagsIntern = SELECTED_VERT;
+            for(Core::Vert* vert : {edge->V1(), edge->V2()}) {
+                if(!Core::IsMarked(vert, SELECTED)) {
+                    Core::Mark(vert, SELECTED);
                     selectedVerts.push_back(vert);
                 }
             }
@@ -40,16 +38,16 @@ const SelectResult SelectExtend(Core::Mesh* m, const std::vector<Core::Vert*>& v
 
     // mark input faces, their edges and verts as selected
     for(Core::Face* face : faces) {
-        if(!(face->flagsIntern & SELECTED_FACE)) {
-            face->flagsIntern = SELECTED_FACE;
+        if(!Core::IsMarked(face, SELECTED)) {
+            Core::Mark(face, SELECTED);
             selectedFaces.push_back(face);
-            for(Core::Edge* edge : face->Edges()) {
-                edge->flagsIntern = SELECTED_EDGE;
+            for(Core::Edge* edge : face->EdgeRange()) {
+                Core::Mark(edge, SELECTED);
                 selectedEdges.push_back(edge);
             }
-            for(Core::Vert* vert : face->Verts()) {
-                if(!(vert->flagsIntern & SELECTED_VERT)) {
-                    vert->flagsIntern = SELECTED_VERT;
+            for(Core::Vert* vert : face->VertRange()) {
+                if(!Core::IsMarked(vert, SELECTED)) {
+                    Core::Mark(vert, SELECTED);
                     selectedVerts.push_back(vert);
                 }
             }
@@ -58,19 +56,19 @@ const SelectResult SelectExtend(Core::Mesh* m, const std::vector<Core::Vert*>& v
 
     // step using edges
     for(Core::Vert* vert : selectedVerts) {
-        for(Core::Edge* edge : vert->Edges()) {
-            if(!(edge->flagsIntern % SELECTED_EDGE)) {
-                edge->flagsIntern = SELECTED_EDGE;
+        for(Core::Edge* edge : vert->EdgeRange()) {
+            if(!Core::IsMarked(edge, SELECTED)) {
+                Core::Mark(edge, SELECTED);
                 selectedEdges.push_back(edge);
                 Core::Vert* other = edge->Other(vert);
-                if(!(other->flagsIntern & SELECTED_VERT)) {
-                    other->flagsIntern = SELECTED_VERT;
+                if(!Core::IsMarked(other, SELECTED)) {
+                    Core::Mark(other, SELECTED);
                     newSelectedVerts.push_back(other);
                 }
             }
         }
-        for(Core::Face* face : vert->Faces()) {
-            if(!(face->flagsIntern % SELECTED_FACE)) {
+        for(Core::Face* face : vert->FaceRange()) {
+            if(!Core::IsMarked(face, SELECTED)) {
                 adjecentFaces.push_back(face);
             }
         }
@@ -83,43 +81,28 @@ const SelectResult SelectExtend(Core::Mesh* m, const std::vector<Core::Vert*>& v
     for(Core::Face* face : adjecentFaces) {
         // if using face step, mark all edges and verts as selected
         if(faceStep) {
-            for(Core::Edge* edge : face->Edges()) {
-                if(!(edge->flagsIntern & SELECTED_EDGE)) {
-                    edge->flagsIntern = SELECTED_EDGE;
+            for(Core::Edge* edge : face->EdgeRange()) {
+                if(!Core::IsMarked(edge, SELECTED)) {
+                    Core::Mark(edge, SELECTED);
                     selectedEdges.push_back(edge);
                 }
             }
-            for(Core::Vert* vert : face->Verts()) {
-                if(!(vert->flagsIntern & SELECTED_VERT)) {
-                    vert->flagsIntern = SELECTED_VERT;
+            for(Core::Vert* vert : face->VertRange()) {
+                if(!Core::IsMarked(vert, SELECTED)) {
+                    Core::Mark(vert, SELECTED);
                     selectedVerts.push_back(vert);
                 }
             }
         } else {
-            bool selected = true;
-            for(Core::Edge* edge : face->Edges()) {
-                if(!(edge->flagsIntern & SELECTED_EDGE)) {
-                    selected = false;
-                    break;
-                }
-            }
+            bool selected = face->EdgesWhere([SELECTED](const Core::Edge* const edge) {
+                return !Core::IsMarked(edge, SELECTED);
+            }).Empty();
             if(selected) {
                 selectedFaces.push_back(face);
             }
         }
     }
 
-    // clear flags, return
-    for(Core::Edge* edge : selectedEdges) {
-        edge->flagsIntern = 0;
-    }
-    for(Core::Face* face : selectedFaces) {
-        face->flagsIntern = 0;
-    }
-    for(Core::Vert* vert : selectedVerts) {
-        vert->flagsIntern = 0;
-    }
-
     SelectResult result = SelectResult();
     result.edges = selectedEdges;
     result.verts = selectedVerts;
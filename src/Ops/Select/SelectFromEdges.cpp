@@ -4,10 +4,8 @@ namespace Aoba {
 namespace Ops {
 
 const SelectResult SelectFromEdges(Core::Mesh* m, const std::vector<Core::Edge*>& edges) {
-    // flags
-    const int32_t ADJECENT_FACE = 1 << 0;
-    const int32_t SELECTED_VERT = 1 << 0;
-    const int32_t SELECTED_EDGE = 1 << 0;
+    // visit marker for selected edges and verts, and for adjecent faces
+    const uint32_t SELECTED = m->NewGeneration();
 
     std::vector<Core::Vert*> verts = std::vector<Core::Vert*>();
     std::vector<Core::Face*> faces = std::vector<Core::Face*>();
@@ -16,16 +14,16 @@ const SelectResult SelectFromEdges(Core::Mesh* m, const std::vector<Core::Edge*>
     // iterate over all edges, mark them as selected, select verts
     // add all adjecent faces to a list
     for(Core::Edge* edge : edges) {
-        edge->flagsIntern = SELECTED_EDGE;
-        for(Core::Vert* vert : edge->Verts()) {
-            if(!(vert->flagsIntern & SELECTED_VERT)) {
-                vert->flagsIntern = SELECTED_VERT;
+        Core::Mark(edge, SELECTED);
+        for(Core::Vert* vert : {edge->V1(), edge->V2()}) {
+            if(!Core::IsMarked(vert, SELECTED)) {
+                Core::Mark(vert, SELECTED);
                 verts.push_back(vert);
             }
         }
-        for(Core::Face* face : edge->Faces()) {
-            if(!(face->flagsIntern & ADJECENT_FACE)) {
-                face->flagsIntern = ADJECENT_FACE;
+        for(Core::Face* face : edge->FaceRange()) {
+            if(!Core::IsMarked(face, SELECTED)) {
+                Core::Mark(face, SELECTED);
                 adjecentFaces.push_back(face);
             }
         }
@@ -33,29 +31,13 @@ const SelectResult SelectFromEdges(Core::Mesh* m, const std::vector<Core::Edge*>
 
     // check all adjecent faces
     // all loop's edges must be selected to mark the face as selected
-    // remove flags from all faces
     for(Core::Face* face : adjecentFaces) {
-        bool selected = true; 
-        for(Core::Edge* edge : face->Edges()) {
-            if(!(edge->flagsIntern & SELECTED_EDGE)) {
-                selected = false;
-                break;
-            }
-        }
+        bool selected = face->EdgesWhere([SELECTED](const Core::Edge* const edge) {
+            return !Core::IsMarked(edge, SELECTED);
+        }).Empty();
         if(selected) {
             faces.push_back(face);
         }
-        face->flagsIntern = 0;
-    }
-
-    // remove flags from vert
-    for(Core::Vert* vert : verts) {
-        vert->flagsIntern = 0;
-    }
-
-    // remove flags from edges
-    for(Core::Edge* edge : edges) {
-        edge->flagsIntern = 0;
     }
 
     SelectResult result = SelectResult();
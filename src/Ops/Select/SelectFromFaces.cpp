@@ -4,37 +4,30 @@ namespace Aoba {
 namespace Ops {
 
 const SelectResult SelectFromFaces(Core::Mesh* m, const std::vector<Core::Face*>& faces) {
-    // flags
-    const int32_t SELECTED_EDGE = 1 << 0;
-    const int32_t SELECTED_VERT = 1 << 0;
+    // visit marker for selected edges and verts
+    const uint32_t SELECTED = m->NewGeneration();
 
     std::vector<Core::Vert*> verts = std::vector<Core::Vert*>();
     std::vector<Core::Edge*> edges = std::vector<Core::Edge*>();
 
     // iterate over input faces and select all edges exactly once
     for(Core::Face* face : faces) {
-        for(Core::Edge* edge : face->Edges()) {
-            if(!(edge->flagsIntern & SELECTED_EDGE)) {
-                edge->flagsIntern = SELECTED_EDGE;
+        for(Core::Edge* edge : face->EdgeRange()) {
+            if(!Core::IsMarked(edge, SELECTED)) {
+                Core::Mark(edge, SELECTED);
                 edges.push_back(edge);
             }
         }
     }
 
-    // iterate over all edges, remove flags and select all verts exactly once
+    // iterate over all edges and select all verts exactly once
     for(Core::Edge* edge : edges) {
-        for(Core::Vert* vert : edge->Verts()) {
-            if(!(vert->flagsIntern & SELECTED_VERT)) {
-                vert->flagsIntern = SELECTED_VERT;
+        for(Core::Vert* vert : {edge->V1(), edge->V2()}) {
+            if(!Core::IsMarked(vert, SELECTED)) {
+                Core::Mark(vert, SELECTED);
                 verts.push_back(vert);
             }
         }
-        edge->flagsIntern = 0;
-    }
-
-    // remove flags from vert
-    for(Core::Vert* vert : verts) {
-        vert->flagsIntern = 0;
     }
 
     SelectResult result = SelectResult();
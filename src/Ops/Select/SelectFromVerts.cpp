@@ -4,9 +4,8 @@ namespace Aoba {
 namespace Ops {
 
 const SelectResult SelectFromVerts(Core::Mesh* m, const std::vector<Core::Vert*>& verts) {
-    // flags
-    const int32_t ADJECENT_FACE = 1 << 0;
-    const int32_t SELECTED_VERT = 1 << 0;
+    // flags, valid for the current generation only
+    const uint32_t gen = m->NewGeneration();
     const int32_t SELECTED_EDGE = 1 << 0;
     const int32_t ADJECENT_EDGE = 1 << 1;
 
@@ -18,11 +17,11 @@ const SelectResult SelectFromVerts(Core::Mesh* m, const std::vector<Core::Vert*>
     // iterate over all verts, mark them as selected
     // add all adjecent edges to a list
     for(Core::Vert* vert : verts) {
-        vert->flagsIntern = SELECTED_VERT;
+        Core::Mark(vert, gen);
 
-        for(Core::Edge* edge : vert->Edges()) {
-            if(!(edge->flagsIntern & ADJECENT_EDGE)) {
-                edge->flagsIntern = ADJECENT_EDGE;
+        for(Core::Edge* edge : vert->EdgeRange()) {
+            if(!Core::HasMark(edge, gen, ADJECENT_EDGE)) {
+                Core::SetMark(edge, gen, ADJECENT_EDGE);
                 adjecentEdges.push_back(edge);
             }
         }
@@ -33,51 +32,33 @@ const SelectResult SelectFromVerts(Core::Mesh* m, const std::vector<Core::Vert*>
     // if edge is selected, add it's adjecent faces to a list.
     for(Core::Edge* edge : adjecentEdges) {
         bool selected = true;
-        for(Core::Vert* vert : edge->Verts()) {
-            if(!(vert->flagsIntern & SELECTED_VERT)) {
+        for(Core::Vert* vert : {edge->V1(), edge->V2()}) {
+            if(!Core::IsMarked(vert, gen)) {
                 selected = false;
                 break;
             }
         }
         if(selected) {
             edges.push_back(edge);
-            edge->flagsIntern = SELECTED_EDGE;
-            for(Core::Face* face : edge->Faces()) {
-                if(!(face->flagsIntern & ADJECENT_FACE)) {
-                    face->flagsIntern = ADJECENT_FACE;
+            Core::SetMark(edge, gen, SELECTED_EDGE);
+            for(Core::Face* face : edge->FaceRange()) {
+                if(!Core::IsMarked(face, gen)) {
+                    Core::Mark(face, gen);
                     adjecentFaces.push_back(face);
                 }
             }
-        } else {
-            edge->flagsIntern = 0;
         }
     }
 
     // check all adjecent faces
     // all loop's edges must be selected to mark the face as selected
-    // remove flags from all faces
     for(Core::Face* face : adjecentFaces) {
-        bool selected = true;
-        for(Core::Edge* edge : face->Edges()) {
-            if(!(edge->flagsIntern & SELECTED_EDGE)) {
-                selected = false;
-                break;
-            }
-        }
+        bool selected = face->EdgesWhere([gen, SELECTED_EDGE](const Core::Edge* const edge) {
+            return !Core::HasMark(edge, gen, SELECTED_EDGE);
+        }).Empty();
         if(selected) {
             faces.push_back(face);
         }
-        face->flagsIntern = 0;
-    }
-
-    // remove flags from vert
-    for(Core::Vert* vert : verts) {
-        vert->flagsIntern = 0;
-    }
-
-    // remove flags from edges
-    for(Core::Edge* edge : edges) {
-        edge->flagsIntern = 0;
     }
 
     SelectResult result = SelectResult();
@@ -7,7 +7,8 @@ const SelectResult SelectReduce(Core::Mesh* m, const std::vector<Core::Vert*>& v
     const std::vector<Core::Edge*>& edges, const std::vector<Core::Face*>& faces, bool faceStep) {
 
     // mark all input edges, verts and faces as selected
-    // flags
+    // flags, valid for the current generation only
+    const uint32_t gen = m->NewGeneration();
     const int32_t SELECTED_FACE = 1 << 0;
     const int32_t SELECTED_VERT = 1 << 0;
     const int32_t SELECTED_EDGE = 1 << 0;
@@ -21,20 +22,20 @@ const SelectResult SelectReduce(Core::Mesh* m, const std::vector<Core::Vert*>& v
 
     // mark input verts as selected
     for(Core::Vert* vert : verts) {
-        if(!(vert->flagsIntern & SELECTED_VERT)) {
-            vert->flagsIntern = SELECTED_VERT;
+        if(!Core::HasMark(vert, gen, SELECTED_VERT)) {
+            Core::SetMark(vert, gen, SELECTED_VERT);
             selectedVerts.push_back(vert);
         }
     }
 
     // mark input edges and their verts as selected
     for(Core::Edge* edge : edges) {
-        if(!(edge->flagsIntern & SELECTED_EDGE)) {
-            edge->flagsIntern = SELECTED_EDGE;
+        if(!Core::HasMark(edge, gen, SELECTED_EDGE)) {
+            Core::SetMark(edge, gen, SELECTED_EDGE);
             selectedEdges.push_back(edge);
-            for(Core::Vert* vert : edge->Verts()) {
-                if(!(vert->flagsIntern & SELECTED_VERT)) {
-                    vert->flagsIntern = SELECTED_VERT;
+            for(Core::Vert* vert : {edge->V1(), edge->V2()}) {
+                if(!Core::HasMark(vert, gen, SELECTED_VERT)) {
+                    Core::SetMark(vert, gen, SELECTED_VERT);
                     selectedVerts.push_back(vert);
                 }
             }
@@ -43,16 +44,16 @@ const SelectResult SelectReduce(Core::Mesh* m, const std::vector<Core::Vert*>& v
 
     // mark input faces, their edges and verts as selected
     for(Core::Face* face : faces) {
-        if(!(face->flagsIntern & SELECTED_FACE)) {
-            face->flagsIntern = SELECTED_FACE;
+        if(!Core::HasMark(face, gen, SELECTED_FACE)) {
+            Core::SetMark(face, gen, SELECTED_FACE);
             selectedFaces.push_back(face);
-            for(Core::Edge* edge : face->Edges()) {
-                edge->flagsIntern = SELECTED_EDGE;
+            for(Core::Edge* edge : face->EdgeRange()) {
+                Core::SetMark(edge, gen, SELECTED_EDGE);
                 selectedEdges.push_back(edge);
             }
-            for(Core::Vert* vert : face->Verts()) {
-                if(!(vert->flagsIntern & SELECTED_VERT)) {
-                    vert->flagsIntern = SELECTED_VERT;
+            for(Core::Vert* vert : face->VertRange()) {
+                if(!Core::HasMark(vert, gen, SELECTED_VERT)) {
+                    Core::SetMark(vert, gen, SELECTED_VERT);
                     selectedVerts.push_back(vert);
                 }
             }
@@ -64,10 +65,10 @@ const SelectResult SelectReduce(Core::Mesh* m, const std::vector<Core::Vert*>& v
     if(!faceStep) {
         // boundary vert is one which does not have all it's edges selected
         for(Core::Vert* vert : selectedVerts) {
-            for(Core::Edge* edge : vert->Edges()) {
-                if(!(edge->flagsIntern & SELECTED_EDGE)) {
+            for(Core::Edge* edge : vert->EdgeRange()) {
+                if(!Core::HasMark(edge, gen, SELECTED_EDGE)) {
                     boundaryVerts.push_back(vert);
-                    vert->flagsIntern += DESELECTED_VERT;
+                    Core::SetMark(vert, gen, DESELECTED_VERT);
                 }
             }
         }
@@ -75,10 +76,10 @@ const SelectResult SelectReduce(Core::Mesh* m, const std::vector<Core::Vert*>& v
         // boundary vert is one which does not have all it's faces selected
         std::vector<Core::Vert*> boundaryVerts = std::vector<Core::Vert*>();
         for(Core::Vert* vert : selectedVerts) {
-            for(Core::Face* face : vert->Faces()) {
-                if(!(face->flagsIntern & SELECTED_FACE)) {
+            for(Core::Face* face : vert->FaceRange()) {
+                if(!Core::HasMark(face, gen, SELECTED_FACE)) {
                     boundaryVerts.push_back(vert);
-                    vert->flagsIntern += DESELECTED_VERT;
+                    Core::SetMark(vert, gen, DESELECTED_VERT);
                 }
             }
         }
@@ -86,48 +87,45 @@ const SelectResult SelectReduce(Core::Mesh* m, const std::vector<Core::Vert*>& v
 
     // deselect boundary vert's edges which were selected previously
     for(Core::Vert* vert : boundaryVerts) {
-        for(Core::Edge* edge : vert->Edges()) {
-            if(edge->flagsIntern & SELECTED_EDGE) {
-                edge->flagsIntern = SELECTED_EDGE + DESELECTED_EDGE;
+        for(Core::Edge* edge : vert->EdgeRange()) {
+            if(Core::HasMark(edge, gen, SELECTED_EDGE)) {
+                Core::SetMark(edge, gen, DESELECTED_EDGE);
             }
         }
     }
 
     // deselect each face which had one of it's edges deselected
     for(Core::Face* face : faces) {
-        for(Core::Edge* edge : face->Edges()) {
-            if(edge->flagsIntern & DESELECTED_EDGE) {
-                face->flagsIntern += DESELECTED_EDGE;
+        for(Core::Edge* edge : face->EdgeRange()) {
+            if(Core::HasMark(edge, gen, DESELECTED_EDGE)) {
+                Core::SetMark(face, gen, DESELECTED_FACE);
                 break;
             }
         }
     }
 
-    // create result, clear flags, return
+    // create result, return
     
     std::vector<Core::Vert*> resultVerts = std::vector<Core::Vert*>();
     std::vector<Core::Edge*> resultEdges = std::vector<Core::Edge*>();
     std::vector<Core::Face*> resultFaces = std::vector<Core::Face*>();
 
     for(Core::Vert* vert : selectedVerts) {
-        if(!(vert->flagsIntern & DESELECTED_VERT)) {
+        if(!Core::HasMark(vert, gen, DESELECTED_VERT)) {
             resultVerts.push_back(vert);
         }
-        vert->flagsIntern = 0;
     }
 
     for(Core::Edge* edge : selectedEdges) {
-        if(!(edge->flagsIntern & DESELECTED_EDGE)) {
+        if(!Core::HasMark(edge, gen, DESELECTED_EDGE)) {
             resultEdges.push_back(edge);
         }
-        edge->flagsIntern = 0;
     }
 
     for(Core::Face* face : selectedFaces) {
-        if(!(face->flagsIntern & DESELECTED_FACE)) {
+        if(!Core::HasMark(face, gen, DESELECTED_FACE)) {
             resultFaces.push_back(face);
         }
-        face->flagsIntern = 0;
     }
 
 
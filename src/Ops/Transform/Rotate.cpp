@@ -5,9 +5,7 @@ namespace Ops {
 
 void Rotate(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const Math::Vec3& center, const Math::Mat3& mat) {
     for(auto it = verts.begin(); it != verts.end(); ++it) {
-        (*it)->co -= center;
-        (*it)->co = mat * (*it)->co;
-        (*it)->co += center;
+        m->SetCo(*it, mat * ((*it)->Co() - center) + center);
 
         // TODO: check if coordinate is a part of the mesh
         // TODO: can at one point run this in paralel
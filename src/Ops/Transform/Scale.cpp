@@ -5,11 +5,11 @@ namespace Ops {
 
 void Scale(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const Math::Vec3& center, const Math::Vec3& vec) {
     for(auto it = verts.begin(); it != verts.end(); ++it) {
-        (*it)->co -= center;
-        (*it)->co.x *= vec.x;
-        (*it)->co.y *= vec.y;
-        (*it)->co.z *= vec.z;
-        (*it)->co += center;
+        Math::Vec3 co = (*it)->Co() - center;
+        co.x *= vec.x;
+        co.y *= vec.y;
+        co.z *= vec.z;
+        m->SetCo(*it, co + center);
 
         // TODO: check if coordinate is a part of the mesh
         // TODO: can at one point run this in paralel
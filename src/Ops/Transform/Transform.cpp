@@ -12,10 +12,11 @@ void Transform(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const Math:
     }
 
     for(Core::Vert* v : verts) {
-        v->co = transformMatrix * v->co;
-        v->co.x += matrix(0, 3);
-        v->co.y += matrix(1, 3);
-        v->co.z += matrix(2, 3);
+        Math::Vec3 co = transformMatrix * v->Co();
+        co.x += matrix(0, 3);
+        co.y += matrix(1, 3);
+        co.z += matrix(2, 3);
+        m->SetCo(v, co);
     }
 }
 
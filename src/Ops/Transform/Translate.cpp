@@ -7,7 +7,7 @@ void Translate(Core::Mesh* m, const std::vector<Core::Vert*>& verts, const Math:
     for(auto it = verts.begin(); it != verts.end(); ++it) {
         // TODO: check if coordinate is a part of the mesh
         // TODO: can at one point run this in paralel
-        ((*it)->co) += vec;
+        m->SetCo(*it, (*it)->Co() + vec);
     }
 }
 